@@ -3,40 +3,52 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
+#include "mochila.h"
+#include "latencia.h"
+#include "lote.h"
+#include "snapshot.h"
+#include "diario.h"
+#include "entrada.h"
+
 // Codigo da Ilha - Edicao Free Fire
 // Nivel: Mestre
 // Este programa simula o gerenciamento avancado de uma mochila com componentes coletados durante a fuga de uma ilha.
 // Ele introduz ordenacao com criterios e busca binaria para otimizar a gestao dos recursos.
 
-// Struct Item:
-// Representa um componente com nome, tipo, quantidade e prioridade (1 a 5).
-// A prioridade indica a importância do item na montagem do plano de fuga.
-typedef struct {
-    char nome[30];
-    char tipo[20];
-    int quantidade;
-    int prioridade;  // de 1 a 5
-} Item;
-
-// Enum CriterioOrdenacao:
-// Define os criterios possiveis para a ordenacao dos itens (nome, tipo ou prioridade).
-typedef enum {
-    NOME,
-    TIPO,
-    PRIORIDADE
-} CriterioOrdenacao;
-
-// Vetor mochila:
-// Armazena até 10 itens coletados.
-Item mochila[10];
-
-// Variaveis de controle:
-// numItens: quantidade atual de itens na mochila
-// comparacoes: contador para analise de desempenho
-// ordenadaPorNome: controle para permitir busca binaria apenas quando ordenada por nome
-int numItens = 0;
-int comparacoes = 0;
-bool ordenadaPorNome = false;
+// Struct Item e enum CriterioOrdenacao:
+// Definidos na libmochila (mochila.h). Cada item tem nome, tipo, quantidade
+// e prioridade (1 a 5); os criterios de ordenacao sao NOME, TIPO e PRIORIDADE.
+
+#define CAPACIDADE_INICIAL 10
+#define ARQUIVO_LATENCIAS "latencias.csv"  // Se MOCHILA_LATENCIAS nao estiver definida
+#define REPETICOES_PARALELO 20  // Execucoes medidas para o speedup do Merge Sort paralelo
+#define ARQUIVO_MOCHILA "mochila.bin"  // Snapshot carregado ao iniciar e gravado ao sair
+#define ARQUIVO_DIARIO "mochila.diario"  // Operacoes feitas desde o ultimo snapshot
+
+// Mochila:
+// Armazena os itens coletados. O vetor e o contador ficam na libmochila,
+// que aumenta a capacidade automaticamente quando a mochila enche. Entre
+// execucoes, a mochila e guardada em ARQUIVO_MOCHILA (snapshot.h).
+Mochila mochila;
+
+// Diario:
+// Cada coleta, remocao e ordenacao e acrescentada a ARQUIVO_DIARIO
+// (diario.h) assim que acontece; se o jogo cair antes de gravar o
+// snapshot, ela e refeita na proxima execucao.
+Diario diario = {-1, 0, 0, 0, 0, 0};
+
+// avisarDiario():
+// A operacao ja valeu na mochila; se nao entrou no diario, so chega ao
+// disco com o snapshot gravado ao sair.
+void avisarDiario(int registrado) {
+    if (!registrado && diario.descritor >= 0) {
+        printf("[AVISO] Falha ao gravar no diario; a operacao so sera salva ao sair.\n");
+    }
+}
+
+// A ordem por nome (pre-requisito da busca binaria) e acompanhada pela
+// propria libmochila: mochilaOrdenadaPorNome(). O trabalho de cada
+// ordenacao e busca e contado num Estatisticas local (estatisticas.h).
 
 // limparTela():
 // Simula a limpeza da tela imprimindo várias linhas em branco.
@@ -46,12 +58,6 @@ void limparTela() {
     }
 }
 
-// Funcao auxiliar para limpar buffer de entrada
-void limparBuffer() {
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF);
-}
-
 // exibirMenu():
 // Apresenta o menu principal ao jogador, com destaque para status da ordenacao.
 void exibirMenu() {
@@ -64,40 +70,59 @@ void exibirMenu() {
     printf("  3. Listar todos os itens\n");
     printf("  4. Ordenar os itens por criterio (nome, tipo, prioridade)\n");
     printf("  5. Realizar busca binaria por nome\n");
+    printf("  6. Listar por criterio (sem reordenar)\n");
+    printf("  7. Filtrar itens por tipo\n");
+    printf("  8. Resumo por tipo e prioridade\n");
+    printf("  9. Latencia das operacoes (salva histogramas em CSV)\n");
     printf("  0. Sair\n");
     printf("────────────────────────────────────────────────────────────\n");
-    printf("  Itens na mochila: %d/10\n", numItens);
-    printf("  Ordenada por nome: %s\n", ordenadaPorNome ? "SIM" : "NAO");
+    printf("  Itens na mochila: %d\n", mochilaTotal(&mochila));
+    printf("  Ordenada por nome: %s\n", mochilaOrdenadaPorNome(&mochila) ? "SIM" : "NAO");
+    printf("  Busca binaria: %s\n", mochilaBuscaBinariaDisponivel(&mochila) ? "DISPONIVEL" : "ORDENE POR NOME");
     printf("────────────────────────────────────────────────────────────\n");
     printf("  Escolha uma opcao: ");
 }
 
 // inserirItem():
-// Adiciona um novo componente à mochila se houver espaço.
+// Adiciona um novo componente à mochila (a capacidade cresce conforme necessario).
 // Solicita nome, tipo, quantidade e prioridade.
-// Após inserir, marca a mochila como "não ordenada por nome".
+// Enquanto a mochila estiver ordenada por nome, o item entra direto na
+// posicao certa (insercao ordenada da libmochila) e a ordem se mantem.
 void inserirItem() {
-    if (numItens >= 10) {
-        printf("\n[ERRO] Mochila cheia! Capacidade maxima atingida (10 itens).\n");
-        return;
-    }
-
     printf("\n┌─────────────────────────────────────┐\n");
     printf("│   ADICIONAR NOVO ITEM À MOCHILA     │\n");
     printf("└─────────────────────────────────────┘\n");
 
     Item novoItem;
+    char tipo[TAM_TIPO];
 
     // Leitura do nome
     printf("Nome do item: ");
     limparBuffer();
-    fgets(novoItem.nome, 30, stdin);
-    novoItem.nome[strcspn(novoItem.nome, "\n")] = '\0';
+    lerTexto(novoItem.nome, TAM_NOME);
+
+    // Coletar de novo um item que ja esta na mochila soma as unidades
+    int existente = mochilaBuscar(&mochila, novoItem.nome, NULL);
+    if (existente >= 0) {
+        int coletadas;
+        printf("Item ja esta na mochila. Unidades coletadas: ");
+        scanf("%d", &coletadas);
+
+        int total = mochilaItem(&mochila, existente)->quantidade + coletadas;
+        mochilaAlterarQuantidade(&mochila, novoItem.nome, total);
+        avisarDiario(diarioRegistrarQuantidade(&diario, novoItem.nome, total));
+        printf("\n[OK] +%d unidades de '%s' (agora %d).\n", coletadas, novoItem.nome, total);
+        return;
+    }
 
-    // Leitura do tipo
+    // Leitura do tipo (guardado no item como id do dicionario de tipos)
     printf("Tipo do item: ");
-    fgets(novoItem.tipo, 20, stdin);
-    novoItem.tipo[strcspn(novoItem.tipo, "\n")] = '\0';
+    lerTexto(tipo, TAM_TIPO);
+    novoItem.idTipo = tipoRegistrar(tipo);
+    if (novoItem.idTipo == TIPO_INVALIDO) {
+        printf("\n[ERRO] Falha ao registrar o tipo '%s'!\n", tipo);
+        return;
+    }
 
     // Leitura da quantidade
     printf("Quantidade: ");
@@ -113,12 +138,12 @@ void inserirItem() {
         novoItem.prioridade = 3;
     }
 
-    // Armazena o item no vetor
-    mochila[numItens] = novoItem;
-    numItens++;
-
-    // Ao inserir um novo item, a mochila deixa de estar ordenada por nome
-    ordenadaPorNome = false;
+    // Armazena o item no vetor (que cresce se necessario)
+    if (!mochilaInserir(&mochila, novoItem)) {
+        printf("\n[ERRO] Falha ao alocar memoria para o item!\n");
+        return;
+    }
+    avisarDiario(diarioRegistrarInsercao(&diario, &novoItem));
 
     printf("\n[OK] Item '%s' adicionado com sucesso!\n", novoItem.nome);
 }
@@ -127,123 +152,223 @@ void inserirItem() {
 // Permite remover um componente da mochila pelo nome.
 // Se encontrado, reorganiza o vetor para preencher a lacuna.
 void removerItem() {
-    if (numItens == 0) {
+    if (mochilaTotal(&mochila) == 0) {
         printf("\n[AVISO] Mochila vazia! Nao ha itens para remover.\n");
         return;
     }
 
-    char nomeBusca[30];
+    char nomeBusca[TAM_NOME];
     printf("\n┌─────────────────────────────────────┐\n");
     printf("│     REMOVER ITEM DA MOCHILA         │\n");
     printf("└─────────────────────────────────────┘\n");
     printf("Nome do item a remover: ");
     limparBuffer();
-    fgets(nomeBusca, 30, stdin);
-    nomeBusca[strcspn(nomeBusca, "\n")] = '\0';
-
-    // Busca sequencial pelo item
-    int encontrado = -1;
-    for (int i = 0; i < numItens; i++) {
-        if (strcmp(mochila[i].nome, nomeBusca) == 0) {
-            encontrado = i;
-            break;
-        }
-    }
+    lerTexto(nomeBusca, TAM_NOME);
 
-    // Se nao encontrou
-    if (encontrado == -1) {
+    // Busca o item e remove reorganizando o vetor
+    if (!mochilaRemover(&mochila, nomeBusca)) {
         printf("\n[ERRO] Item '%s' nao encontrado na mochila.\n", nomeBusca);
         return;
     }
+    avisarDiario(diarioRegistrarRemocao(&diario, nomeBusca));
 
-    // Remove reorganizando o vetor
-    for (int i = encontrado; i < numItens - 1; i++) {
-        mochila[i] = mochila[i + 1];
-    }
-
-    numItens--;
     printf("\n[OK] Item '%s' removido com sucesso!\n", nomeBusca);
 }
 
-// listarItens():
-// Exibe uma tabela formatada com todos os componentes presentes na mochila.
-void listarItens() {
+// imprimirLinhaItem():
+// Imprime uma linha da tabela da mochila (chamada por mochilaPercorrer).
+void imprimirLinhaItem(const Item* item, int posicao, void* contexto) {
+    (void)contexto;
+    printf("│ %2d │ %-20s │ %-16s │ %10d │ %10d │\n",
+           posicao + 1,
+           item->nome,
+           tipoNome(item->idTipo),
+           item->quantidade,
+           item->prioridade);
+}
+
+// imprimirCabecalhoTabela():
+// Titulo e cabecalho da tabela de itens. Retorna false se a mochila esta vazia.
+bool imprimirCabecalhoTabela() {
     printf("\n╔════════════════════════════════════════════════════════════════════════════╗\n");
     printf("║                        INVENTÁRIO DA MOCHILA                               ║\n");
     printf("╚════════════════════════════════════════════════════════════════════════════╝\n");
 
-    if (numItens == 0) {
+    if (mochilaTotal(&mochila) == 0) {
         printf("  Mochila vazia. Colete itens para sobreviver!\n");
-        return;
+        return false;
     }
 
-    printf("\n  Total de itens: %d/10\n\n", numItens);
+    printf("\n  Total de itens: %d\n\n", mochilaTotal(&mochila));
     printf("┌────┬──────────────────────┬──────────────────┬────────────┬────────────┐\n");
     printf("│ Nº │ Nome                 │ Tipo             │ Quantidade │ Prioridade │\n");
     printf("├────┼──────────────────────┼──────────────────┼────────────┼────────────┤\n");
+    return true;
+}
 
-    for (int i = 0; i < numItens; i++) {
-        printf("│ %2d │ %-20s │ %-16s │ %10d │ %10d │\n",
-               i + 1,
-               mochila[i].nome,
-               mochila[i].tipo,
-               mochila[i].quantidade,
-               mochila[i].prioridade);
+// listarItens():
+// Exibe uma tabela formatada com todos os componentes presentes na mochila.
+void listarItens() {
+    if (!imprimirCabecalhoTabela()) {
+        return;
     }
 
+    mochilaPercorrer(&mochila, imprimirLinhaItem, NULL);
+
     printf("└────┴──────────────────────┴──────────────────┴────────────┴────────────┘\n");
 }
 
+// listarPorCriterio():
+// Lista os itens na ordem de nome, tipo ou prioridade usando os indices
+// secundarios da libmochila: a mochila nao e reordenada, entao a ordem
+// atual (e a busca binaria) continuam valendo.
+void listarPorCriterio() {
+    int opcao;
+    printf("\nListar por: 1. NOME  2. TIPO  3. PRIORIDADE\n");
+    printf("Escolha o criterio: ");
+    scanf("%d", &opcao);
+
+    if (opcao < 1 || opcao > 3) {
+        printf("\n[ERRO] Opcao invalida!\n");
+        return;
+    }
+
+    if (!imprimirCabecalhoTabela()) {
+        return;
+    }
+
+    mochilaPercorrerOrdenado(&mochila, (CriterioOrdenacao)(opcao - 1), imprimirLinhaItem, NULL);
+
+    printf("└────┴──────────────────────┴──────────────────┴────────────┴────────────┘\n");
+}
+
+// filtrarPorTipo():
+// Lista apenas os itens de um tipo. O nome digitado e convertido uma vez
+// no id do dicionario de tipos; o filtro compara so inteiros.
+void filtrarPorTipo() {
+    char tipo[TAM_TIPO];
+    printf("\nTipo a listar: ");
+    limparBuffer();
+    lerTexto(tipo, TAM_TIPO);
+
+    int idTipo = tipoBuscar(tipo);
+    if (idTipo < 0) {
+        printf("\n[AVISO] Nenhum item do tipo '%s' foi coletado.\n", tipo);
+        return;
+    }
+
+    if (!imprimirCabecalhoTabela()) {
+        return;
+    }
+
+    int encontrados = mochilaPercorrerPorTipo(&mochila, (unsigned short)idTipo, imprimirLinhaItem, NULL);
+
+    printf("└────┴──────────────────────┴──────────────────┴────────────┴────────────┘\n");
+    printf("  Itens do tipo '%s': %d\n", tipo, encontrados);
+}
+
+// exibirResumo():
+// Quantos itens e quantas unidades ha de cada tipo e de cada prioridade
+// ("total de municao", "itens de prioridade 5"). Os numeros vem dos
+// agregados que a libmochila mantem a cada coleta/remocao: a consulta nao
+// percorre a mochila.
+void exibirResumo() {
+    Agregado geral = mochilaAgregadoGeral(&mochila);
+
+    printf("\n┌─────────────────────────────────────┐\n");
+    printf("│     RESUMO DA MOCHILA               │\n");
+    printf("└─────────────────────────────────────┘\n");
+    printf("Itens: %d | Unidades: %lld\n", geral.itens, geral.quantidade);
+
+    printf("\n%-20s %8s %10s\n", "Tipo", "Itens", "Unidades");
+    for (int id = 0; id < tipoTotal(); id++) {
+        Agregado agregado = mochilaAgregadoTipo(&mochila, (unsigned short)id);
+        if (agregado.itens > 0) {
+            printf("%-20s %8d %10lld\n", tipoNome((unsigned short)id), agregado.itens, agregado.quantidade);
+        }
+    }
+
+    printf("\n%-20s %8s %10s\n", "Prioridade", "Itens", "Unidades");
+    for (int prioridade = 5; prioridade >= 1; prioridade--) {
+        Agregado agregado = mochilaAgregadoPrioridade(&mochila, prioridade);
+        printf("%-20d %8d %10lld\n", prioridade, agregado.itens, agregado.quantidade);
+    }
+}
+
+// exibirLatencias():
+// Latencia de cada operacao da mochila acumulada desde o inicio da sessao
+// (histogramas da libmochila), nao so a da ultima. Os histogramas
+// completos vao para um CSV.
+void exibirLatencias() {
+    printf("\n┌─────────────────────────────────────┐\n");
+    printf("│     LATENCIA DAS OPERACOES          │\n");
+    printf("└─────────────────────────────────────┘\n");
+    printf("%-20s %10s %12s %12s %12s\n", "Operacao", "Execucoes", "Media (ns)", "p50 (ns)", "p99 (ns)");
+    for (int op = 0; op < TOTAL_LATENCIAS; op++) {
+        ResumoLatencia resumo = latenciaResumo((OperacaoLatencia)op);
+        printf("%-20s %10llu %12.0f %12.0f %12.0f\n", nomeLatencia((OperacaoLatencia)op),
+               (unsigned long long)resumo.contagem, resumo.mediaNs, resumo.p50Ns, resumo.p99Ns);
+    }
+    printf("(p50 e p99: limite do balde em potencia de 2)\n");
+
+    const char* caminho = getenv(VARIAVEL_LATENCIAS);
+    if (caminho == NULL || caminho[0] == '\0') {
+        caminho = ARQUIVO_LATENCIAS;
+    }
+    if (latenciaSalvar(caminho)) {
+        printf("\n[OK] Histogramas gravados em %s\n", caminho);
+    } else {
+        printf("\n[ERRO] Nao foi possivel gravar %s\n", caminho);
+    }
+}
+
 // insertionSort():
 // Implementacao do algoritmo de ordenacao por insercao.
 // Funciona com diferentes criterios de ordenacao:
 // - Por nome (ordem alfabetica)
 // - Por tipo (ordem alfabetica)
 // - Por prioridade (da mais alta para a mais baixa)
-void insertionSort(CriterioOrdenacao criterio) {
-    comparacoes = 0;
-
-    for (int i = 1; i < numItens; i++) {
-        Item chave = mochila[i];
-        int j = i - 1;
-
-        // Move elementos maiores que a chave uma posicao a frente
-        while (j >= 0) {
-            comparacoes++;
-            bool deveMover = false;
-
-            // Determina se deve mover baseado no critério
-            switch (criterio) {
-                case NOME:
-                    deveMover = (strcmp(mochila[j].nome, chave.nome) > 0);
-                    break;
-                case TIPO:
-                    deveMover = (strcmp(mochila[j].tipo, chave.tipo) > 0);
-                    break;
-                case PRIORIDADE:
-                    // Ordem decrescente (maior prioridade primeiro)
-                    deveMover = (mochila[j].prioridade < chave.prioridade);
-                    break;
-            }
-
-            if (deveMover) {
-                mochila[j + 1] = mochila[j];
-                j--;
-            } else {
-                break;
-            }
-        }
+void insertionSort(CriterioOrdenacao criterio, Estatisticas* estatisticas) {
+    // Desloca indices em vez de itens inteiros; os itens sao movidos uma vez
+    mochilaOrdenarPorIndices(&mochila, criterio, INSERTION_SORT, estatisticas);
+}
 
-        mochila[j + 1] = chave;
+// escolherAlgoritmo():
+// Pergunta qual algoritmo usar. Insertion Sort e o padrao (bom para
+// poucos itens ou quase ordenados); Merge Sort e Introsort escalam
+// melhor para mochilas grandes, e o Radix Sort ordena pelos bytes da
+// chave (o nome sem strcmp). O Merge Sort paralelo divide o trabalho
+// entre os processadores, e o Counting Sort distribui tipo ou prioridade
+// sem comparar (vira Merge Sort se a faixa de valores for grande).
+AlgoritmoOrdenacao escolherAlgoritmo() {
+    int opcao;
+    printf("\nAlgoritmo: 1. Insertion Sort  2. Merge Sort (estavel)  3. Introsort  4. Radix Sort\n");
+    printf("           5. Merge Sort paralelo  6. Counting Sort\n");
+    printf("Escolha o algoritmo: ");
+    scanf("%d", &opcao);
+
+    switch (opcao) {
+        case 2:
+            return MERGE_SORT;
+        case 3:
+            return INTRO_SORT;
+        case 4:
+            return RADIX_SORT;
+        case 5:
+            return MERGE_SORT_PARALELO;
+        case 6:
+            return COUNTING_SORT;
+        default:
+            return INSERTION_SORT;
     }
 }
 
 // menuDeOrdenacao():
 // Permite ao jogador escolher como deseja ordenar os itens.
-// Utiliza a funcao insertionSort() com o criterio selecionado.
-// Exibe a quantidade de comparacoes feitas (analise de desempenho).
+// Utiliza insertionSort() ou o algoritmo O(n log n) escolhido.
+// Exibe as comparacoes, trocas e movimentos feitos (analise de desempenho).
 void menuDeOrdenacao() {
-    if (numItens == 0) {
+    if (mochilaTotal(&mochila) == 0) {
         printf("\n[AVISO] Mochila vazia! Nao ha itens para ordenar.\n");
         return;
     }
@@ -267,17 +392,14 @@ void menuDeOrdenacao() {
         case 1:
             criterio = NOME;
             nomeCriterio = "NOME";
-            ordenadaPorNome = true;  // Marca que esta ordenada por nome
             break;
         case 2:
             criterio = TIPO;
             nomeCriterio = "TIPO";
-            ordenadaPorNome = false;  // Nao esta ordenada por nome
             break;
         case 3:
             criterio = PRIORIDADE;
             nomeCriterio = "PRIORIDADE";
-            ordenadaPorNome = false;  // Nao esta ordenada por nome
             break;
         case 0:
             return;
@@ -287,10 +409,46 @@ void menuDeOrdenacao() {
     }
 
     // Realiza a ordenacao
-    insertionSort(criterio);
+    Estatisticas estatisticas;
+    estatisticasZerar(&estatisticas);
+    AlgoritmoOrdenacao algoritmo = escolherAlgoritmo();
+
+    // O paralelo e medido contra o Merge Sort sequencial (sobre copias,
+    // antes de ordenar)
+    Medicao paralelo = {0, 0, 0, 0, 0};
+    Medicao sequencial = {0, 0, 0, 0, 0};
+    if (algoritmo == MERGE_SORT_PARALELO) {
+        mochilaMedirOrdenacao(&mochila, criterio, MERGE_SORT_PARALELO, false, REPETICOES_PARALELO, &paralelo);
+        mochilaMedirOrdenacao(&mochila, criterio, MERGE_SORT, false, REPETICOES_PARALELO, &sequencial);
+    }
 
-    printf("\n[OK] Itens ordenados por %s com sucesso!\n", nomeCriterio);
-    printf("[DESEMPENHO] Analise de desempenho: %d comparacoes realizadas\n", comparacoes);
+    if (algoritmo == INSERTION_SORT) {
+        insertionSort(criterio, &estatisticas);
+    } else {
+        mochilaOrdenar(&mochila, criterio, algoritmo, &estatisticas);
+    }
+    avisarDiario(diarioRegistrarOrdenacao(&diario, criterio, algoritmo));
+
+    // Counting Sort com faixa grande e executado como Merge Sort
+    algoritmo = mochilaUltimoAlgoritmo(&mochila);
+
+    printf("\n[OK] Itens ordenados por %s com %s!\n", nomeCriterio, nomeAlgoritmo(algoritmo));
+    if (algoritmo == COUNTING_SORT) {
+        printf("[DESEMPENHO] Analise de desempenho: 0 comparacoes (%d itens distribuidos por contagem)\n",
+               mochilaTotal(&mochila));
+    } else {
+        printf("[DESEMPENHO] Analise de desempenho: %ld comparacoes realizadas\n", estatisticas.comparacoes);
+    }
+    printf("[DESEMPENHO] %ld trocas, %ld itens movidos (%lld bytes)\n", estatisticas.trocas,
+           estatisticas.movimentos, estatisticas.bytesMovidos);
+    if (algoritmo == MERGE_SORT_PARALELO) {
+        printf("[DESEMPENHO] %d threads", threadsOrdenacao(mochilaTotal(&mochila), 0, 0));
+        if (paralelo.medianaNs > 0 && sequencial.medianaNs > 0) {
+            printf(", speedup de %.2fx sobre o Merge Sort sequencial",
+                   (double)sequencial.medianaNs / (double)paralelo.medianaNs);
+        }
+        printf("\n");
+    }
 
     // Exibe os itens ordenados
     listarItens();
@@ -301,70 +459,151 @@ void menuDeOrdenacao() {
 // Se encontrar, exibe os dados do item buscado.
 // Caso contrario, informa que nao encontrou o item.
 void buscaBinariaPorNome() {
-    if (numItens == 0) {
+    if (mochilaTotal(&mochila) == 0) {
         printf("\n[AVISO] Mochila vazia! Nao ha itens para buscar.\n");
         return;
     }
 
-    // Verifica se a mochila esta ordenada por nome
-    if (!ordenadaPorNome) {
+    // Verifica se a mochila esta ordenada por nome (ou tem o indice de nome)
+    if (!mochilaBuscaBinariaDisponivel(&mochila)) {
         printf("\n[ERRO] A busca binaria requer que a mochila esteja ordenada por NOME!\n");
         printf("       Por favor, ordene os itens por nome primeiro (opcao 4 do menu).\n");
         return;
     }
 
-    char nomeBusca[30];
+    char nomeBusca[TAM_NOME];
     printf("\n┌─────────────────────────────────────┐\n");
     printf("│     BUSCA BINARIA POR NOME          │\n");
     printf("└─────────────────────────────────────┘\n");
     printf("Nome do item a buscar: ");
     limparBuffer();
-    fgets(nomeBusca, 30, stdin);
-    nomeBusca[strcspn(nomeBusca, "\n")] = '\0';
-
-    // Algoritmo de busca binaria
-    int esquerda = 0;
-    int direita = numItens - 1;
-    int comparacoesBusca = 0;
-
-    while (esquerda <= direita) {
-        int meio = (esquerda + direita) / 2;
-        comparacoesBusca++;
-
-        int resultado = strcmp(mochila[meio].nome, nomeBusca);
-
-        if (resultado == 0) {
-            // Encontrou o item!
-            printf("\n[OK] Item encontrado apos %d comparacoes!\n", comparacoesBusca);
-            printf("\n┌─────────────────────────────────────┐\n");
-            printf("│ Nome:       %-23s │\n", mochila[meio].nome);
-            printf("│ Tipo:       %-23s │\n", mochila[meio].tipo);
-            printf("│ Quantidade: %-23d │\n", mochila[meio].quantidade);
-            printf("│ Prioridade: %-23d │\n", mochila[meio].prioridade);
-            printf("└─────────────────────────────────────┘\n");
-            printf("\n[INFO] Comparacoes na busca binaria: %d\n", comparacoesBusca);
-            printf("       (Busca sequencial faria ate %d comparacoes)\n", numItens);
-            return;
-        } else if (resultado < 0) {
-            // Item buscado esta na metade direita
-            esquerda = meio + 1;
-        } else {
-            // Item buscado esta na metade esquerda
-            direita = meio - 1;
+    lerTexto(nomeBusca, TAM_NOME);
+
+    // Algoritmo de busca binaria (libmochila)
+    Estatisticas estatisticas;
+    estatisticasZerar(&estatisticas);
+    int indice = mochilaBuscarBinaria(&mochila, nomeBusca, &estatisticas);
+
+    if (indice == -1) {
+        // Nao encontrou
+        printf("\n[ERRO] Item '%s' nao encontrado apos %ld comparacoes.\n", nomeBusca,
+               estatisticas.comparacoes);
+        return;
+    }
+
+    // Encontrou o item!
+    const Item* item = mochilaItem(&mochila, indice);
+    printf("\n[OK] Item encontrado apos %ld comparacoes!\n", estatisticas.comparacoes);
+    printf("\n┌─────────────────────────────────────┐\n");
+    printf("│ Nome:       %-23s │\n", item->nome);
+    printf("│ Tipo:       %-23s │\n", tipoNome(item->idTipo));
+    printf("│ Quantidade: %-23d │\n", item->quantidade);
+    printf("│ Prioridade: %-23d │\n", item->prioridade);
+    printf("└─────────────────────────────────────┘\n");
+    printf("\n[INFO] Comparacoes na busca binaria: %ld\n", estatisticas.comparacoes);
+    printf("       (Busca sequencial faria ate %d comparacoes)\n", mochilaTotal(&mochila));
+}
+
+// buscarLote():
+// Modo de linha de comando para conciliacao de inventarios, sem menu:
+//   ./FreeFire --buscar-lote inventario.txt nomes.txt [threads]
+// O inventario e um snapshot da mochila (como o ARQUIVO_MOCHILA) ou um
+// arquivo com um nome por linha, cujos itens entram na mochila; nomes.txt
+// tem um nome por linha. Cada nome e procurado na mochila, em varias
+// threads (lote.h). Saida CSV em stdout: nome,encontrado,posicao,cortado
+// (posicao -1 quando nao encontrado). Nomes com mais de TAM_NOME - 1 bytes
+// sao cortados, como na mochila, e procurados assim: o CSV traz o nome
+// cortado e cortado=sim. O resumo vai para stderr.
+int buscarLote(const char* arquivoInventario, const char* arquivoNomes, int threads) {
+    ListaNomes inventario = {NULL, NULL, NULL, 0};
+    ListaNomes consultas;
+
+    if (!snapshotCarregar(&mochila, arquivoInventario, NULL)) {
+        if (!mochilaIniciar(&mochila, CAPACIDADE_INICIAL)) {
+            fprintf(stderr, "[ERRO] Falha ao alocar a mochila!\n");
+            return 1;
+        }
+        if (!loteLerNomes(arquivoInventario, &inventario)) {
+            fprintf(stderr, "[ERRO] Nao foi possivel ler %s\n", arquivoInventario);
+            return 1;
         }
     }
+    if (!loteLerNomes(arquivoNomes, &consultas)) {
+        fprintf(stderr, "[ERRO] Nao foi possivel ler %s\n", arquivoNomes);
+        loteLiberarNomes(&inventario);
+        return 1;
+    }
+
+    int* posicoes = (int*)malloc(sizeof(int) * (size_t)(consultas.total > 0 ? consultas.total : 1));
+    unsigned short idTipo = tipoRegistrar("inventario");
+    bool ok = posicoes != NULL && idTipo != TIPO_INVALIDO &&
+              mochilaReservar(&mochila, mochilaTotal(&mochila) + inventario.total);
+
+    for (int i = 0; ok && i < inventario.total; i++) {
+        Item item;
+        memset(&item, 0, sizeof(Item));
+        strncpy(item.nome, inventario.nomes[i], TAM_NOME - 1);
+        item.idTipo = idTipo;
+        item.quantidade = 1;
+        item.prioridade = 1;
+        ok = mochilaInserir(&mochila, item);
+    }
+    if (!ok) {
+        fprintf(stderr, "[ERRO] Sem memoria para o lote\n");
+        free(posicoes);
+        loteLiberarNomes(&inventario);
+        loteLiberarNomes(&consultas);
+        return 1;
+    }
 
-    // Nao encontrou
-    printf("\n[ERRO] Item '%s' nao encontrado apos %d comparacoes.\n", nomeBusca, comparacoesBusca);
+    Estatisticas estatisticas;
+    estatisticasZerar(&estatisticas);
+    uint64_t inicio = cronometroNs();
+    int encontrados = loteBuscar(&mochila, consultas.nomes, consultas.total, posicoes, threads, &estatisticas);
+    double decorridoMs = (double)(cronometroNs() - inicio) / 1e6;
+
+    int cortados = 0;
+    printf("nome,encontrado,posicao,cortado\n");
+    for (int i = 0; i < consultas.total; i++) {
+        printf("%s,%s,%d,%s\n", consultas.nomes[i], posicoes[i] >= 0 ? "sim" : "nao", posicoes[i],
+               consultas.cortados[i] ? "sim" : "nao");
+        cortados += consultas.cortados[i];
+    }
+    fprintf(stderr, "[LOTE] %d nomes contra %d itens: %d encontrados, %d nao encontrados\n",
+            consultas.total, mochilaTotal(&mochila), encontrados, consultas.total - encontrados);
+    if (cortados > 0) {
+        fprintf(stderr, "[LOTE] %d nomes com mais de %d bytes foram cortados antes da busca\n",
+                cortados, TAM_NOME - 1);
+    }
+    fprintf(stderr, "[LOTE] %d threads, %.2f ms, %ld comparacoes\n",
+            loteThreads(consultas.total, threads), decorridoMs, estatisticas.comparacoes);
+
+    free(posicoes);
+    loteLiberarNomes(&inventario);
+    loteLiberarNomes(&consultas);
+    return 0;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Sem menu: ./FreeFire --buscar-lote inventario.txt nomes.txt [threads]
+    if (argc >= 4 && strcmp(argv[1], "--buscar-lote") == 0) {
+        int resultado = buscarLote(argv[2], argv[3], argc > 4 ? atoi(argv[4]) : 0);
+        latenciaSalvarSeConfigurado();
+        mochilaLiberar(&mochila);
+        tiposLiberar();
+        return resultado;
+    }
+
     // Menu principal com opcoes:
     // 1. Adicionar um item
     // 2. Remover um item
     // 3. Listar todos os itens
     // 4. Ordenar os itens por criterio (nome, tipo, prioridade)
     // 5. Realizar busca binaria por nome
+    // 6. Listar por criterio sem reordenar (indices secundarios)
+    // 7. Filtrar itens por tipo
+    // 8. Resumo por tipo e prioridade (agregados)
+    // 9. Latencia das operacoes (histogramas)
     // 0. Sair
 
     int opcao;
@@ -376,10 +615,53 @@ int main() {
     printf("════════════════════════════════════════════════════════════\n");
     printf("\n  Prepare sua mochila e organize os componentes para escapar!\n");
 
+    // Itens da execucao anterior: o snapshot e mapeado e copiado em bloco,
+    // com a ordem e os indices como estavam ao sair
+    uint32_t geracao = 0;
+    uint64_t inicioCarga = cronometroNs();
+    if (snapshotCarregar(&mochila, ARQUIVO_MOCHILA, &geracao)) {
+        printf("\n[MOCHILA] %d itens recuperados de %s em %.2f ms.\n", mochilaTotal(&mochila),
+               ARQUIVO_MOCHILA, (double)(cronometroNs() - inicioCarga) / 1e6);
+    } else {
+        FILE* anterior = fopen(ARQUIVO_MOCHILA, "rb");
+        if (anterior != NULL) {
+            fclose(anterior);
+            printf("\n[AVISO] %s invalido ou de outra versao; a mochila comeca vazia.\n", ARQUIVO_MOCHILA);
+        }
+        if (!mochilaIniciar(&mochila, CAPACIDADE_INICIAL)) {
+            printf("\n[ERRO] Falha ao alocar a mochila!\n");
+            return 1;
+        }
+
+        // Mochila sempre ordenada por nome: cada item entra na posicao certa,
+        // entao a busca binaria nao exige reordenar depois de cada coleta.
+        // Ordenar por tipo ou prioridade suspende o modo ate a proxima
+        // ordenacao por nome.
+        mochilaDefinirInsercaoOrdenada(&mochila, true);
+    }
+
+    // Indices por nome, tipo e prioridade mantidos a cada coleta: listar em
+    // qualquer ordem e a busca binaria funcionam mesmo apos ordenar por
+    // tipo ou prioridade.
+    if (!mochilaDefinirIndicesSecundarios(&mochila, true)) {
+        printf("\n[AVISO] Sem memoria para os indices; listagem por criterio exigira reordenar.\n");
+    }
+
+    // Operacoes feitas depois do snapshot (a execucao anterior caiu antes
+    // de grava-lo)
+    long reaplicados;
+    if (!diarioAbrir(&diario, ARQUIVO_DIARIO, geracao, &mochila, &reaplicados)) {
+        printf("\n[AVISO] Sem o diario %s; a mochila so sera salva ao sair.\n", ARQUIVO_DIARIO);
+    } else if (reaplicados > 0) {
+        printf("\n[MOCHILA] %ld operacoes refeitas a partir de %s.\n", reaplicados, ARQUIVO_DIARIO);
+    }
+
     // A estrutura switch trata cada opcao chamando a funcao correspondente.
     // A ordenacao e busca binaria exigem que os dados estejam bem organizados.
 
     do {
+        // O jogador pode demorar: o que esta no diario vai para o disco antes
+        diarioSincronizar(&diario);
         exibirMenu();
         scanf("%d", &opcao);
 
@@ -404,6 +686,22 @@ int main() {
                 buscaBinariaPorNome();
                 break;
 
+            case 6:
+                listarPorCriterio();
+                break;
+
+            case 7:
+                filtrarPorTipo();
+                break;
+
+            case 8:
+                exibirResumo();
+                break;
+
+            case 9:
+                exibirLatencias();
+                break;
+
             case 0:
                 printf("\n");
                 printf("════════════════════════════════════════════════════════════\n");
@@ -413,7 +711,7 @@ int main() {
                 break;
 
             default:
-                printf("\n[ERRO] Opcao invalida! Escolha entre 0 e 5.\n");
+                printf("\n[ERRO] Opcao invalida! Escolha entre 0 e 9.\n");
         }
 
         if (opcao != 0) {
@@ -425,5 +723,19 @@ int main() {
 
     } while (opcao != 0);
 
+    // Snapshot da proxima geracao; so depois o diario e esvaziado
+    if (snapshotSalvar(&mochila, ARQUIVO_MOCHILA, geracao + 1)) {
+        printf("[MOCHILA] %d itens salvos em %s.\n", mochilaTotal(&mochila), ARQUIVO_MOCHILA);
+        diarioReiniciar(&diario, geracao + 1);
+    } else if (diario.descritor >= 0) {
+        printf("[AVISO] Nao foi possivel gravar %s; as operacoes continuam em %s.\n", ARQUIVO_MOCHILA,
+               ARQUIVO_DIARIO);
+    } else {
+        printf("[ERRO] Nao foi possivel gravar %s; os itens desta sessao se perderam.\n", ARQUIVO_MOCHILA);
+    }
+    diarioFechar(&diario);
+    latenciaSalvarSeConfigurado();  // MOCHILA_LATENCIAS=arquivo.csv
+    mochilaLiberar(&mochila);
+    tiposLiberar();
     return 0;
 }
@@ -1,85 +1,58 @@
 /*
  * SISTEMA DE INVENTARIO - FREE FIRE (NIVEL AVENTUREIRO)
  *
- * Descricao: Sistema comparativo que implementa duas estruturas de dados
- * para gerenciar o inventario: vetor (lista sequencial) e lista encadeada.
+ * Descricao: Sistema comparativo que implementa tres estruturas de dados
+ * para gerenciar o inventario: vetor (lista sequencial), lista encadeada e
+ * lista encadeada desenrolada (blocos de itens por no).
  * O objetivo e demonstrar como a escolha da estrutura de dados influencia
  * na performance em operacoes criticas.
+ *
+ * As estruturas (Item, Mochila, Lista e ListaDesenrolada) e os algoritmos ficam na libmochila;
+ * este arquivo cuida apenas dos menus e da exibicao dos resultados.
+ *
+ * Inventarios de teste podem ser carregados de um arquivo CSV/TSV
+ * (nome,tipo,quantidade), pelo menu ou ao iniciar:
+ *
+ *   ./aventureiro inventario.csv
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 
-// ============================================================================
-// DEFINICAO DE CONSTANTES
-// ============================================================================
-
-#define MAX_ITENS 100       // Capacidade maxima do vetor
-#define TAM_NOME 30         // Tamanho maximo do nome do item
-#define TAM_TIPO 20         // Tamanho maximo do tipo do item
+#include "mochila.h"
+#include "lista.h"
+#include "lista_desenrolada.h"
+#include "latencia.h"
+#include "importacao.h"
+#include "entrada.h"
 
 // ============================================================================
-// ESTRUTURAS DE DADOS
+// DEFINICAO DE CONSTANTES
 // ============================================================================
 
-/*
- * Struct: Item
- * Representa um item do inventario com suas propriedades.
- *
- * Campos:
- *   - nome: identificador do item (ex: "AK-47", "Kit Medico")
- *   - tipo: categoria do item (arma, municao, cura, ferramenta)
- *   - quantidade: numero de unidades deste item
- */
-typedef struct {
-    char nome[TAM_NOME];
-    char tipo[TAM_TIPO];
-    int quantidade;
-} Item;
-
-/*
- * Struct: No
- * Representa um no da lista encadeada.
- *
- * Campos:
- *   - dados: estrutura Item contendo os dados do inventario
- *   - proximo: ponteiro para o proximo no da lista
- */
-typedef struct No {
-    Item dados;
-    struct No* proximo;
-} No;
+#define CAPACIDADE_INICIAL 100  // Espaco reservado de inicio; o vetor cresce sozinho
+#define REPETICOES_BUSCA 1000    // Execucoes medidas de cada busca
+#define REPETICOES_ORDENACAO 100 // Execucoes medidas de cada ordenacao (sobre copias)
+#define TAM_CAMINHO 256          // Caminho do arquivo importado
 
 // ============================================================================
 // VARIAVEIS GLOBAIS
 // ============================================================================
 
-// Estruturas para o vetor
-Item inventarioVetor[MAX_ITENS];
-int totalItensVetor = 0;
+// Estrutura para o vetor
+Mochila inventarioVetor;
 
-// Estruturas para a lista encadeada
-No* inicioLista = NULL;
+// Estrutura para a lista encadeada
+Lista inventarioLista;
 
-// Contadores de comparacoes para analise de desempenho
-int comparacoesSequencial = 0;
-int comparacoesBinaria = 0;
+// Estrutura para a lista encadeada desenrolada
+ListaDesenrolada inventarioDesenrolado;
 
 // ============================================================================
 // FUNCOES AUXILIARES
 // ============================================================================
 
-/*
- * Funcao: limparBuffer
- * Limpa o buffer de entrada para evitar problemas com leitura de strings
- */
-void limparBuffer() {
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF);
-}
-
 /*
  * Funcao: pausar
  * Pausa a execucao e aguarda o usuario pressionar ENTER
@@ -90,6 +63,41 @@ void pausar() {
     getchar();
 }
 
+/*
+ * Funcao: mostrarTempo
+ * Exibe o resumo das execucoes medidas: minimo, mediana e p99 em
+ * nanossegundos e, se houver contador de ciclos, a mediana em ciclos.
+ */
+void mostrarTempo(const char* prefixo, const Medicao* medicao) {
+    if (medicao->repeticoes == 0) {
+        printf("%sTempo: nao medido (sem memoria)\n", prefixo);
+        return;
+    }
+    printf("%sTempo: min %llu ns | mediana %llu ns | p99 %llu ns (%d execucoes",
+           prefixo,
+           (unsigned long long)medicao->minimoNs,
+           (unsigned long long)medicao->medianaNs,
+           (unsigned long long)medicao->p99Ns,
+           medicao->repeticoes);
+    if (medicao->medianaCiclos > 0) {
+        printf(", mediana %llu ciclos", (unsigned long long)medicao->medianaCiclos);
+    }
+    printf(")\n");
+}
+
+/*
+ * Funcao: imprimirLinhaItem
+ * Imprime uma linha da tabela de itens (usada por vetor e lista).
+ */
+void imprimirLinhaItem(const Item* item, int posicao, void* contexto) {
+    (void)contexto;
+    printf("%-5d %-20s %-15s %-10d\n",
+           posicao,
+           item->nome,
+           tipoNome(item->idTipo),
+           item->quantidade);
+}
+
 // ============================================================================
 // OPERACOES COM VETOR (LISTA SEQUENCIAL)
 // ============================================================================
@@ -98,22 +106,20 @@ void pausar() {
  * Funcao: inserirItemVetor
  * Insere um novo item no final do vetor.
  *
- * Complexidade: O(1) - insercao no final
+ * Complexidade: O(1) amortizado - insercao no final (o vetor cresce
+ * quando enche)
  *
  * Parametros:
  *   - item: estrutura Item a ser inserida
  *
- * Retorno: 1 se sucesso, 0 se falhou (vetor cheio)
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
  */
 int inserirItemVetor(Item item) {
-    if (totalItensVetor >= MAX_ITENS) {
-        printf("\n[VETOR] Mochila cheia! Capacidade maxima atingida.\n");
+    if (!mochilaInserir(&inventarioVetor, item)) {
+        printf("\n[VETOR] Erro ao alocar memoria!\n");
         return 0;
     }
 
-    inventarioVetor[totalItensVetor] = item;
-    totalItensVetor++;
-
     printf("\n[VETOR] Item '%s' inserido com sucesso!\n", item.nome);
     return 1;
 }
@@ -122,7 +128,9 @@ int inserirItemVetor(Item item) {
  * Funcao: removerItemVetor
  * Remove um item do vetor pelo nome.
  *
- * Complexidade: O(n) - busca + deslocamento dos elementos
+ * Complexidade: O(1) em media - o item e localizado pelo indice hash e o
+ * ultimo item ocupa seu lugar (O(n) se o vetor estiver ordenado, pois
+ * entao os posteriores sao deslocados para manter a ordem)
  *
  * Parametros:
  *   - nome: nome do item a ser removido
@@ -130,31 +138,36 @@ int inserirItemVetor(Item item) {
  * Retorno: 1 se sucesso, 0 se nao encontrado
  */
 int removerItemVetor(char* nome) {
-    int encontrado = -1;
-
-    // Busca sequencial pelo item
-    for (int i = 0; i < totalItensVetor; i++) {
-        if (strcmp(inventarioVetor[i].nome, nome) == 0) {
-            encontrado = i;
-            break;
-        }
-    }
-
-    if (encontrado == -1) {
+    if (!mochilaRemover(&inventarioVetor, nome)) {
         printf("\n[VETOR] Item '%s' nao encontrado.\n", nome);
         return 0;
     }
 
-    // Desloca todos os elementos posteriores uma posicao para tras
-    for (int i = encontrado; i < totalItensVetor - 1; i++) {
-        inventarioVetor[i] = inventarioVetor[i + 1];
-    }
-
-    totalItensVetor--;
     printf("\n[VETOR] Item '%s' removido com sucesso!\n", nome);
     return 1;
 }
 
+/*
+ * Funcao: alternarRemocaoPreguicosa
+ * Liga/desliga a remocao por lapides no vetor.
+ *
+ * Com o modo ligado, remover so marca a posicao (sem deslocar itens) e o
+ * vetor e compactado de uma vez quando as lapides passam de 25%.
+ */
+void alternarRemocaoPreguicosa() {
+    bool ativo = !inventarioVetor.remocaoPreguicosa;
+
+    if (!mochilaDefinirRemocaoPreguicosa(&inventarioVetor, ativo, LIMITE_REMOVIDOS_PADRAO)) {
+        printf("\n[VETOR] Erro ao alocar memoria!\n");
+        return;
+    }
+
+    printf("\n[VETOR] Remocao preguicosa (lapides): %s\n", ativo ? "LIGADA" : "DESLIGADA");
+    if (!ativo) {
+        printf("[VETOR] Vetor compactado.\n");
+    }
+}
+
 /*
  * Funcao: listarItensVetor
  * Lista todos os itens do vetor.
@@ -164,22 +177,18 @@ int removerItemVetor(char* nome) {
 void listarItensVetor() {
     printf("\n========== INVENTARIO - VETOR ==========\n");
 
-    if (totalItensVetor == 0) {
+    if (mochilaTotal(&inventarioVetor) == 0) {
         printf("Inventario vazio.\n");
         return;
     }
 
-    printf("Total de itens: %d/%d\n\n", totalItensVetor, MAX_ITENS);
+    printf("Total de itens: %d (capacidade alocada: %d, lapides: %d)\n\n",
+           mochilaTotal(&inventarioVetor), mochilaCapacidade(&inventarioVetor),
+           mochilaRemovidos(&inventarioVetor));
     printf("%-5s %-20s %-15s %-10s\n", "Pos", "Nome", "Tipo", "Qtd");
     printf("-------------------------------------------------------\n");
 
-    for (int i = 0; i < totalItensVetor; i++) {
-        printf("%-5d %-20s %-15s %-10d\n",
-               i,
-               inventarioVetor[i].nome,
-               inventarioVetor[i].tipo,
-               inventarioVetor[i].quantidade);
-    }
+    mochilaPercorrer(&inventarioVetor, imprimirLinhaItem, NULL);
 
     printf("========================================\n");
 }
@@ -192,67 +201,100 @@ void listarItensVetor() {
  *
  * Parametros:
  *   - nome: nome do item a buscar
+ *   - estatisticas: acumula as comparacoes (pode ser NULL)
  *
  * Retorno: indice do item se encontrado, -1 caso contrario
  */
-int buscarSequencialVetor(char* nome) {
-    comparacoesSequencial = 0;
-
-    for (int i = 0; i < totalItensVetor; i++) {
-        comparacoesSequencial++;
-        if (strcmp(inventarioVetor[i].nome, nome) == 0) {
-            return i;
-        }
-    }
+int buscarSequencialVetor(char* nome, Estatisticas* estatisticas) {
+    return mochilaBuscarSequencial(&inventarioVetor, nome, estatisticas);
+}
 
-    return -1;
+/*
+ * Funcao: buscarHashVetor
+ * Localiza um item pelo nome usando o indice hash mantido pela libmochila.
+ *
+ * Complexidade: O(1) em media - independente do tamanho do vetor
+ *
+ * Parametros:
+ *   - nome: nome do item a buscar
+ *   - estatisticas: acumula as comparacoes (pode ser NULL)
+ *
+ * Retorno: indice do item se encontrado, -1 caso contrario
+ */
+int buscarHashVetor(char* nome, Estatisticas* estatisticas) {
+    return mochilaBuscar(&inventarioVetor, nome, estatisticas);
 }
 
 /*
  * Funcao: ordenarVetor
- * Ordena os itens do vetor por nome usando Selection Sort.
- *
- * Complexidade: O(n^2) - dois loops aninhados
+ * Ordena os itens do vetor por nome com o algoritmo escolhido.
  *
- * Algoritmo Selection Sort:
- * Para cada posicao i:
- *   1. Encontra o menor elemento entre i e o final do vetor
- *   2. Troca o elemento da posicao i com o menor encontrado
+ * Complexidade:
+ *   - Selection Sort: O(n^2) sempre, mesmo com vetor ja ordenado
+ *   - Merge Sort:     O(n log n), estavel, usa vetor auxiliar
+ *   - Introsort:      O(n log n) no pior caso, sem memoria extra
+ *   - Radix Sort:     distribui pelos bytes do nome (sem strcmp), estavel
+ *   - Merge Sort paralelo: Merge Sort dividido entre os processadores
  *
- * Vantagens: simples de implementar, poucas trocas
- * Desvantagens: sempre O(n^2), mesmo com vetor ja ordenado
+ * Selection Sort fica como referencia: simples e com poucas trocas,
+ * mas inviavel para inventarios grandes.
  */
 void ordenarVetor() {
-    if (totalItensVetor <= 1) {
+    if (mochilaTotal(&inventarioVetor) <= 1) {
         printf("\n[VETOR] Nada a ordenar (menos de 2 itens).\n");
         return;
     }
 
-    clock_t inicio = clock();
+    int opcao;
+    AlgoritmoOrdenacao algoritmo;
 
-    for (int i = 0; i < totalItensVetor - 1; i++) {
-        int menorIndice = i;
+    printf("\nAlgoritmo: 1. Selection Sort  2. Merge Sort  3. Introsort  4. Radix Sort  5. Merge Sort paralelo\n");
+    printf("Escolha: ");
+    scanf("%d", &opcao);
+    limparBuffer();
 
-        // Encontra o menor elemento no restante do vetor
-        for (int j = i + 1; j < totalItensVetor; j++) {
-            if (strcmp(inventarioVetor[j].nome, inventarioVetor[menorIndice].nome) < 0) {
-                menorIndice = j;
-            }
-        }
+    switch (opcao) {
+        case 2:
+            algoritmo = MERGE_SORT;
+            break;
+        case 3:
+            algoritmo = INTRO_SORT;
+            break;
+        case 4:
+            algoritmo = RADIX_SORT;
+            break;
+        case 5:
+            algoritmo = MERGE_SORT_PARALELO;
+            break;
+        default:
+            algoritmo = SELECTION_SORT;
+    }
 
-        // Troca o elemento atual com o menor encontrado
-        if (menorIndice != i) {
-            Item temp = inventarioVetor[i];
-            inventarioVetor[i] = inventarioVetor[menorIndice];
-            inventarioVetor[menorIndice] = temp;
+    // Mede sobre copias do vetor ainda desordenado; depois ordena de verdade.
+    // O paralelo tambem e medido contra o Merge Sort sequencial.
+    Medicao medicao;
+    Medicao sequencial = {0, 0, 0, 0, 0};
+    mochilaMedirOrdenacao(&inventarioVetor, NOME, algoritmo, false, REPETICOES_ORDENACAO, &medicao);
+    if (algoritmo == MERGE_SORT_PARALELO) {
+        mochilaMedirOrdenacao(&inventarioVetor, NOME, MERGE_SORT, false, REPETICOES_ORDENACAO, &sequencial);
+    }
+    Estatisticas estatisticas;
+    estatisticasZerar(&estatisticas);
+    mochilaOrdenar(&inventarioVetor, NOME, algoritmo, &estatisticas);
+
+    printf("\n[VETOR] Itens ordenados com %s!\n", nomeAlgoritmo(algoritmo));
+    printf("[VETOR] Comparacoes: %ld | Trocas: %ld | Movimentos: %ld (%lld bytes)\n",
+           estatisticas.comparacoes, estatisticas.trocas, estatisticas.movimentos,
+           estatisticas.bytesMovidos);
+    mostrarTempo("[VETOR] ", &medicao);
+    if (algoritmo == MERGE_SORT_PARALELO) {
+        printf("[VETOR] Threads: %d", threadsOrdenacao(mochilaTotal(&inventarioVetor), 0, 0));
+        if (medicao.medianaNs > 0 && sequencial.medianaNs > 0) {
+            printf(" | Speedup: %.2fx sobre o Merge Sort sequencial",
+                   (double)sequencial.medianaNs / (double)medicao.medianaNs);
         }
+        printf("\n");
     }
-
-    clock_t fim = clock();
-    double tempo = ((double)(fim - inicio)) / CLOCKS_PER_SEC * 1000;
-
-    printf("\n[VETOR] Itens ordenados com sucesso!\n");
-    printf("[VETOR] Tempo de ordenacao: %.4f ms\n", tempo);
 }
 
 /*
@@ -272,31 +314,12 @@ void ordenarVetor() {
  *
  * Parametros:
  *   - nome: nome do item a buscar
+ *   - estatisticas: acumula as comparacoes (pode ser NULL)
  *
  * Retorno: indice do item se encontrado, -1 caso contrario
  */
-int buscarBinariaVetor(char* nome) {
-    comparacoesBinaria = 0;
-
-    int esquerda = 0;
-    int direita = totalItensVetor - 1;
-
-    while (esquerda <= direita) {
-        int meio = (esquerda + direita) / 2;
-        comparacoesBinaria++;
-
-        int resultado = strcmp(nome, inventarioVetor[meio].nome);
-
-        if (resultado == 0) {
-            return meio;  // Encontrou!
-        } else if (resultado < 0) {
-            direita = meio - 1;  // Busca na metade esquerda
-        } else {
-            esquerda = meio + 1;  // Busca na metade direita
-        }
-    }
-
-    return -1;  // Nao encontrou
+int buscarBinariaVetor(char* nome, Estatisticas* estatisticas) {
+    return mochilaBuscarBinaria(&inventarioVetor, nome, estatisticas);
 }
 
 // ============================================================================
@@ -307,35 +330,18 @@ int buscarBinariaVetor(char* nome) {
  * Funcao: inserirItemLista
  * Insere um novo item no final da lista encadeada.
  *
- * Complexidade: O(n) - precisa percorrer ate o final para inserir
- * (poderia ser O(1) se mantivessemos um ponteiro para o ultimo no)
+ * Complexidade: O(1) - a lista guarda um ponteiro para o ultimo no e os
+ * nos vem de um pool contiguo (sem malloc a cada insercao)
  *
  * Parametros:
  *   - item: estrutura Item a ser inserida
  */
 void inserirItemLista(Item item) {
-    // Aloca memoria para o novo no
-    No* novoNo = (No*)malloc(sizeof(No));
-    if (novoNo == NULL) {
+    if (!listaInserir(&inventarioLista, item)) {
         printf("\n[LISTA] Erro ao alocar memoria!\n");
         return;
     }
 
-    novoNo->dados = item;
-    novoNo->proximo = NULL;
-
-    // Se a lista esta vazia, o novo no e o primeiro
-    if (inicioLista == NULL) {
-        inicioLista = novoNo;
-    } else {
-        // Percorre ate o final da lista
-        No* atual = inicioLista;
-        while (atual->proximo != NULL) {
-            atual = atual->proximo;
-        }
-        atual->proximo = novoNo;
-    }
-
     printf("\n[LISTA] Item '%s' inserido com sucesso!\n", item.nome);
 }
 
@@ -351,34 +357,16 @@ void inserirItemLista(Item item) {
  * Retorno: 1 se sucesso, 0 se nao encontrado
  */
 int removerItemLista(char* nome) {
-    if (inicioLista == NULL) {
+    if (inventarioLista.inicio == NULL) {
         printf("\n[LISTA] Lista vazia!\n");
         return 0;
     }
 
-    No* atual = inicioLista;
-    No* anterior = NULL;
-
-    // Busca o no a ser removido
-    while (atual != NULL && strcmp(atual->dados.nome, nome) != 0) {
-        anterior = atual;
-        atual = atual->proximo;
-    }
-
-    // Se nao encontrou
-    if (atual == NULL) {
+    if (!listaRemover(&inventarioLista, nome)) {
         printf("\n[LISTA] Item '%s' nao encontrado.\n", nome);
         return 0;
     }
 
-    // Se e o primeiro no
-    if (anterior == NULL) {
-        inicioLista = atual->proximo;
-    } else {
-        anterior->proximo = atual->proximo;
-    }
-
-    free(atual);
     printf("\n[LISTA] Item '%s' removido com sucesso!\n", nome);
     return 1;
 }
@@ -392,7 +380,7 @@ int removerItemLista(char* nome) {
 void listarItensLista() {
     printf("\n========== INVENTARIO - LISTA ENCADEADA ==========\n");
 
-    if (inicioLista == NULL) {
+    if (inventarioLista.inicio == NULL) {
         printf("Inventario vazio.\n");
         return;
     }
@@ -400,18 +388,7 @@ void listarItensLista() {
     printf("%-5s %-20s %-15s %-10s\n", "Pos", "Nome", "Tipo", "Qtd");
     printf("-------------------------------------------------------\n");
 
-    No* atual = inicioLista;
-    int posicao = 0;
-
-    while (atual != NULL) {
-        printf("%-5d %-20s %-15s %-10d\n",
-               posicao,
-               atual->dados.nome,
-               atual->dados.tipo,
-               atual->dados.quantidade);
-        atual = atual->proximo;
-        posicao++;
-    }
+    listaPercorrer(&inventarioLista, imprimirLinhaItem, NULL);
 
     printf("==================================================\n");
 }
@@ -425,43 +402,161 @@ void listarItensLista() {
  *
  * Parametros:
  *   - nome: nome do item a buscar
+ *   - estatisticas: acumula as comparacoes (pode ser NULL)
  *
  * Retorno: ponteiro para o no se encontrado, NULL caso contrario
  */
-No* buscarItemLista(char* nome) {
-    comparacoesSequencial = 0;
+No* buscarItemLista(char* nome, Estatisticas* estatisticas) {
+    return listaBuscar(&inventarioLista, nome, estatisticas);
+}
 
-    No* atual = inicioLista;
+// ============================================================================
+// OPERACOES COM LISTA ENCADEADA DESENROLADA
+// ============================================================================
 
-    while (atual != NULL) {
-        comparacoesSequencial++;
-        if (strcmp(atual->dados.nome, nome) == 0) {
-            return atual;
-        }
-        atual = atual->proximo;
+/*
+ * Funcao: inserirItemDesenrolada
+ * Insere um novo item no ultimo bloco da lista desenrolada.
+ *
+ * Complexidade: O(1) - novo bloco so quando o ultimo esta cheio
+ *
+ * Parametros:
+ *   - item: estrutura Item a ser inserida
+ */
+void inserirItemDesenrolada(Item item) {
+    if (!desenroladaInserir(&inventarioDesenrolado, item)) {
+        printf("\n[DESENROLADA] Erro ao alocar memoria!\n");
+        return;
+    }
+
+    printf("\n[DESENROLADA] Item '%s' inserido com sucesso!\n", item.nome);
+}
+
+/*
+ * Funcao: removerItemDesenrolada
+ * Remove um item da lista desenrolada pelo nome.
+ *
+ * Complexidade: O(n) na busca, mas o deslocamento fica restrito a um
+ * bloco de ITENS_POR_BLOCO itens
+ *
+ * Parametros:
+ *   - nome: nome do item a ser removido
+ *
+ * Retorno: 1 se sucesso, 0 se nao encontrado
+ */
+int removerItemDesenrolada(char* nome) {
+    if (inventarioDesenrolado.total == 0) {
+        printf("\n[DESENROLADA] Lista vazia!\n");
+        return 0;
     }
 
-    return NULL;
+    if (!desenroladaRemover(&inventarioDesenrolado, nome)) {
+        printf("\n[DESENROLADA] Item '%s' nao encontrado.\n", nome);
+        return 0;
+    }
+
+    printf("\n[DESENROLADA] Item '%s' removido com sucesso!\n", nome);
+    return 1;
 }
 
 /*
- * Funcao: liberarLista
- * Libera toda a memoria alocada pela lista encadeada.
+ * Funcao: listarItensDesenrolada
+ * Lista todos os itens da lista desenrolada.
  *
- * Importante: sempre liberar a memoria ao final do programa
- * para evitar memory leaks!
+ * Complexidade: O(n) - percorre todos os blocos
  */
-void liberarLista() {
-    No* atual = inicioLista;
-    No* proximo;
-
-    while (atual != NULL) {
-        proximo = atual->proximo;
-        free(atual);
-        atual = proximo;
+void listarItensDesenrolada() {
+    printf("\n========== INVENTARIO - LISTA DESENROLADA ==========\n");
+
+    if (inventarioDesenrolado.total == 0) {
+        printf("Inventario vazio.\n");
+        return;
     }
 
-    inicioLista = NULL;
+    printf("Total de itens: %d em %d blocos (%d itens por bloco)\n\n",
+           inventarioDesenrolado.total, inventarioDesenrolado.blocos, (int)ITENS_POR_BLOCO);
+    printf("%-5s %-20s %-15s %-10s\n", "Pos", "Nome", "Tipo", "Qtd");
+    printf("-------------------------------------------------------\n");
+
+    desenroladaPercorrer(&inventarioDesenrolado, imprimirLinhaItem, NULL);
+
+    printf("====================================================\n");
+}
+
+/*
+ * Funcao: buscarItemDesenrolada
+ * Realiza busca sequencial na lista desenrolada.
+ *
+ * Complexidade: O(n) comparacoes, mas so um salto de ponteiro por bloco
+ *
+ * Parametros:
+ *   - nome: nome do item a buscar
+ *   - estatisticas: acumula as comparacoes (pode ser NULL)
+ *
+ * Retorno: ponteiro para o item se encontrado, NULL caso contrario
+ */
+const Item* buscarItemDesenrolada(char* nome, Estatisticas* estatisticas) {
+    return desenroladaBuscar(&inventarioDesenrolado, nome, estatisticas);
+}
+
+// ============================================================================
+// MEDICAO DAS BUSCAS
+// ============================================================================
+
+/*
+ * Struct: BuscaMedida
+ * Nome procurado e resultado da busca (o campo da estrutura buscada).
+ */
+typedef struct {
+    char* nome;
+    Estatisticas* estatisticas;  // NULL nas repeticoes cronometradas
+    int indice;          // Vetor (sequencial, binaria e hash)
+    No* no;              // Lista encadeada
+    const Item* item;    // Lista desenrolada
+} BuscaMedida;
+
+void ensaioSequencialVetor(void* contexto) {
+    BuscaMedida* busca = (BuscaMedida*)contexto;
+    busca->indice = buscarSequencialVetor(busca->nome, busca->estatisticas);
+}
+
+void ensaioBinariaVetor(void* contexto) {
+    BuscaMedida* busca = (BuscaMedida*)contexto;
+    busca->indice = buscarBinariaVetor(busca->nome, busca->estatisticas);
+}
+
+void ensaioHashVetor(void* contexto) {
+    BuscaMedida* busca = (BuscaMedida*)contexto;
+    busca->indice = buscarHashVetor(busca->nome, busca->estatisticas);
+}
+
+void ensaioLista(void* contexto) {
+    BuscaMedida* busca = (BuscaMedida*)contexto;
+    busca->no = buscarItemLista(busca->nome, busca->estatisticas);
+}
+
+void ensaioDesenrolada(void* contexto) {
+    BuscaMedida* busca = (BuscaMedida*)contexto;
+    busca->item = buscarItemDesenrolada(busca->nome, busca->estatisticas);
+}
+
+/*
+ * Funcao: medirBusca
+ * Executa a busca uma vez, contando as comparacoes em 'estatisticas'
+ * (zeradas antes), e mede seu tempo com REPETICOES_BUSCA execucoes, que
+ * nao entram na contagem. Uma busca isolada leva dezenas de
+ * nanossegundos, abaixo da resolucao de clock().
+ *
+ * Retorno: resultado da busca
+ */
+BuscaMedida medirBusca(void (*ensaio)(void* contexto), char* nome, Estatisticas* estatisticas,
+                       Medicao* medicao) {
+    BuscaMedida busca = {nome, estatisticas, -1, NULL, NULL};
+    estatisticasZerar(estatisticas);
+    ensaio(&busca);
+    busca.estatisticas = NULL;
+    cronometroMedir(NULL, ensaio, &busca, REPETICOES_BUSCA, medicao);
+    return busca;
 }
 
 // ============================================================================
@@ -476,15 +571,20 @@ void liberarLista() {
  */
 Item lerItem() {
     Item item;
+    char tipo[TAM_TIPO];
+
+    item.prioridade = 0;  // Nivel aventureiro nao usa prioridade
 
     printf("\nDigite o nome do item: ");
     limparBuffer();
-    fgets(item.nome, TAM_NOME, stdin);
-    item.nome[strcspn(item.nome, "\n")] = '\0';
+    lerTexto(item.nome, TAM_NOME);
 
     printf("Digite o tipo (arma/municao/cura/ferramenta): ");
-    fgets(item.tipo, TAM_TIPO, stdin);
-    item.tipo[strcspn(item.tipo, "\n")] = '\0';
+    lerTexto(tipo, TAM_TIPO);
+    item.idTipo = tipoRegistrar(tipo);  // Id no dicionario de tipos
+    if (item.idTipo == TIPO_INVALIDO) {
+        printf("[AVISO] Nao foi possivel registrar o tipo; item ficara sem tipo.\n");
+    }
 
     printf("Digite a quantidade: ");
     scanf("%d", &item.quantidade);
@@ -510,6 +610,9 @@ void menuVetor() {
         printf("4. Buscar item (sequencial)\n");
         printf("5. Ordenar itens por nome\n");
         printf("6. Buscar item (binaria - requer ordenacao)\n");
+        printf("7. Buscar item (indice hash)\n");
+        printf("8. Remocao preguicosa (lapides): %s\n",
+               inventarioVetor.remocaoPreguicosa ? "LIGADA" : "DESLIGADA");
         printf("0. Voltar\n");
         printf("========================================\n");
         printf("Escolha: ");
@@ -525,8 +628,7 @@ void menuVetor() {
                 char nome[TAM_NOME];
                 printf("\nDigite o nome do item a remover: ");
                 limparBuffer();
-                fgets(nome, TAM_NOME, stdin);
-                nome[strcspn(nome, "\n")] = '\0';
+                lerTexto(nome, TAM_NOME);
                 removerItemVetor(nome);
                 break;
             }
@@ -537,25 +639,24 @@ void menuVetor() {
                 char nome[TAM_NOME];
                 printf("\nDigite o nome do item a buscar: ");
                 limparBuffer();
-                fgets(nome, TAM_NOME, stdin);
-                nome[strcspn(nome, "\n")] = '\0';
+                lerTexto(nome, TAM_NOME);
 
-                clock_t inicio = clock();
-                int indice = buscarSequencialVetor(nome);
-                clock_t fim = clock();
-                double tempo = ((double)(fim - inicio)) / CLOCKS_PER_SEC * 1000;
+                Estatisticas estatisticas;
+                Medicao medicao;
+                int indice = medirBusca(ensaioSequencialVetor, nome, &estatisticas, &medicao).indice;
 
                 if (indice != -1) {
+                    const Item* item = mochilaItem(&inventarioVetor, indice);
                     printf("\n[VETOR] Item encontrado na posicao %d\n", indice);
                     printf("Nome: %s | Tipo: %s | Qtd: %d\n",
-                           inventarioVetor[indice].nome,
-                           inventarioVetor[indice].tipo,
-                           inventarioVetor[indice].quantidade);
+                           item->nome,
+                           tipoNome(item->idTipo),
+                           item->quantidade);
                 } else {
                     printf("\n[VETOR] Item nao encontrado.\n");
                 }
-                printf("[VETOR] Comparacoes: %d\n", comparacoesSequencial);
-                printf("[VETOR] Tempo: %.4f ms\n", tempo);
+                printf("[VETOR] Comparacoes: %ld\n", estatisticas.comparacoes);
+                mostrarTempo("[VETOR] ", &medicao);
                 break;
             }
             case 5:
@@ -565,28 +666,54 @@ void menuVetor() {
                 char nome[TAM_NOME];
                 printf("\nDigite o nome do item a buscar: ");
                 limparBuffer();
-                fgets(nome, TAM_NOME, stdin);
-                nome[strcspn(nome, "\n")] = '\0';
+                lerTexto(nome, TAM_NOME);
 
-                clock_t inicio = clock();
-                int indice = buscarBinariaVetor(nome);
-                clock_t fim = clock();
-                double tempo = ((double)(fim - inicio)) / CLOCKS_PER_SEC * 1000;
+                Estatisticas estatisticas;
+                Medicao medicao;
+                int indice = medirBusca(ensaioBinariaVetor, nome, &estatisticas, &medicao).indice;
 
                 if (indice != -1) {
+                    const Item* item = mochilaItem(&inventarioVetor, indice);
                     printf("\n[VETOR] Item encontrado na posicao %d\n", indice);
                     printf("Nome: %s | Tipo: %s | Qtd: %d\n",
-                           inventarioVetor[indice].nome,
-                           inventarioVetor[indice].tipo,
-                           inventarioVetor[indice].quantidade);
+                           item->nome,
+                           tipoNome(item->idTipo),
+                           item->quantidade);
                 } else {
                     printf("\n[VETOR] Item nao encontrado.\n");
                 }
-                printf("[VETOR] Comparacoes: %d\n", comparacoesBinaria);
-                printf("[VETOR] Tempo: %.4f ms\n", tempo);
+                printf("[VETOR] Comparacoes: %ld\n", estatisticas.comparacoes);
+                mostrarTempo("[VETOR] ", &medicao);
                 printf("\nNOTA: Se o resultado for inesperado, verifique se o vetor esta ordenado!\n");
                 break;
             }
+            case 7: {
+                char nome[TAM_NOME];
+                printf("\nDigite o nome do item a buscar: ");
+                limparBuffer();
+                lerTexto(nome, TAM_NOME);
+
+                Estatisticas estatisticas;
+                Medicao medicao;
+                int indice = medirBusca(ensaioHashVetor, nome, &estatisticas, &medicao).indice;
+
+                if (indice != -1) {
+                    const Item* item = mochilaItem(&inventarioVetor, indice);
+                    printf("\n[VETOR] Item encontrado na posicao %d\n", indice);
+                    printf("Nome: %s | Tipo: %s | Qtd: %d\n",
+                           item->nome,
+                           tipoNome(item->idTipo),
+                           item->quantidade);
+                } else {
+                    printf("\n[VETOR] Item nao encontrado.\n");
+                }
+                printf("[VETOR] Comparacoes: %ld\n", estatisticas.comparacoes);
+                mostrarTempo("[VETOR] ", &medicao);
+                break;
+            }
+            case 8:
+                alternarRemocaoPreguicosa();
+                break;
             case 0:
                 break;
             default:
@@ -631,8 +758,7 @@ void menuLista() {
                 char nome[TAM_NOME];
                 printf("\nDigite o nome do item a remover: ");
                 limparBuffer();
-                fgets(nome, TAM_NOME, stdin);
-                nome[strcspn(nome, "\n")] = '\0';
+                lerTexto(nome, TAM_NOME);
                 removerItemLista(nome);
                 break;
             }
@@ -643,25 +769,97 @@ void menuLista() {
                 char nome[TAM_NOME];
                 printf("\nDigite o nome do item a buscar: ");
                 limparBuffer();
-                fgets(nome, TAM_NOME, stdin);
-                nome[strcspn(nome, "\n")] = '\0';
+                lerTexto(nome, TAM_NOME);
 
-                clock_t inicio = clock();
-                No* no = buscarItemLista(nome);
-                clock_t fim = clock();
-                double tempo = ((double)(fim - inicio)) / CLOCKS_PER_SEC * 1000;
+                Estatisticas estatisticas;
+                Medicao medicao;
+                No* no = medirBusca(ensaioLista, nome, &estatisticas, &medicao).no;
 
                 if (no != NULL) {
                     printf("\n[LISTA] Item encontrado!\n");
                     printf("Nome: %s | Tipo: %s | Qtd: %d\n",
                            no->dados.nome,
-                           no->dados.tipo,
+                           tipoNome(no->dados.idTipo),
                            no->dados.quantidade);
                 } else {
                     printf("\n[LISTA] Item nao encontrado.\n");
                 }
-                printf("[LISTA] Comparacoes: %d\n", comparacoesSequencial);
-                printf("[LISTA] Tempo: %.4f ms\n", tempo);
+                printf("[LISTA] Comparacoes: %ld\n", estatisticas.comparacoes);
+                mostrarTempo("[LISTA] ", &medicao);
+                break;
+            }
+            case 0:
+                break;
+            default:
+                printf("\nOpcao invalida!\n");
+        }
+
+        if (opcao != 0) {
+            pausar();
+        }
+
+    } while (opcao != 0);
+}
+
+/*
+ * Funcao: menuDesenrolada
+ * Menu de operacoes com lista encadeada desenrolada
+ */
+void menuDesenrolada() {
+    int opcao;
+
+    do {
+        printf("\n");
+        printf("========================================\n");
+        printf("   MENU - LISTA DESENROLADA\n");
+        printf("========================================\n");
+        printf("1. Inserir item\n");
+        printf("2. Remover item\n");
+        printf("3. Listar itens\n");
+        printf("4. Buscar item (sequencial)\n");
+        printf("0. Voltar\n");
+        printf("========================================\n");
+        printf("Escolha: ");
+        scanf("%d", &opcao);
+
+        switch (opcao) {
+            case 1: {
+                Item item = lerItem();
+                inserirItemDesenrolada(item);
+                break;
+            }
+            case 2: {
+                char nome[TAM_NOME];
+                printf("\nDigite o nome do item a remover: ");
+                limparBuffer();
+                lerTexto(nome, TAM_NOME);
+                removerItemDesenrolada(nome);
+                break;
+            }
+            case 3:
+                listarItensDesenrolada();
+                break;
+            case 4: {
+                char nome[TAM_NOME];
+                printf("\nDigite o nome do item a buscar: ");
+                limparBuffer();
+                lerTexto(nome, TAM_NOME);
+
+                Estatisticas estatisticas;
+                Medicao medicao;
+                const Item* item = medirBusca(ensaioDesenrolada, nome, &estatisticas, &medicao).item;
+
+                if (item != NULL) {
+                    printf("\n[DESENROLADA] Item encontrado!\n");
+                    printf("Nome: %s | Tipo: %s | Qtd: %d\n",
+                           item->nome,
+                           tipoNome(item->idTipo),
+                           item->quantidade);
+                } else {
+                    printf("\n[DESENROLADA] Item nao encontrado.\n");
+                }
+                printf("[DESENROLADA] Comparacoes: %ld\n", estatisticas.comparacoes);
+                mostrarTempo("[DESENROLADA] ", &medicao);
                 break;
             }
             case 0:
@@ -679,7 +877,8 @@ void menuLista() {
 
 /*
  * Funcao: compararDesempenho
- * Compara o desempenho de busca entre vetor e lista encadeada
+ * Compara o desempenho de busca entre vetor, lista encadeada e lista
+ * desenrolada
  */
 void compararDesempenho() {
     printf("\n");
@@ -690,47 +889,66 @@ void compararDesempenho() {
     char nome[TAM_NOME];
     printf("\nDigite o nome do item para comparar buscas: ");
     limparBuffer();
-    fgets(nome, TAM_NOME, stdin);
-    nome[strcspn(nome, "\n")] = '\0';
+    lerTexto(nome, TAM_NOME);
 
     printf("\n--- BUSCA SEQUENCIAL ---\n");
 
     // Busca no vetor
-    clock_t inicio = clock();
-    int indiceVetor = buscarSequencialVetor(nome);
-    clock_t fim = clock();
-    double tempoVetor = ((double)(fim - inicio)) / CLOCKS_PER_SEC * 1000;
-    int comparacoesVetor = comparacoesSequencial;
+    Estatisticas vetor;
+    Medicao medicaoVetor;
+    int indiceVetor = medirBusca(ensaioSequencialVetor, nome, &vetor, &medicaoVetor).indice;
+    long comparacoesVetor = vetor.comparacoes;
 
     printf("\nVETOR:\n");
     printf("  Resultado: %s\n", indiceVetor != -1 ? "ENCONTRADO" : "NAO ENCONTRADO");
-    printf("  Comparacoes: %d\n", comparacoesVetor);
-    printf("  Tempo: %.4f ms\n", tempoVetor);
+    printf("  Comparacoes: %ld\n", comparacoesVetor);
+    mostrarTempo("  ", &medicaoVetor);
 
     // Busca na lista
-    inicio = clock();
-    No* noLista = buscarItemLista(nome);
-    fim = clock();
-    double tempoLista = ((double)(fim - inicio)) / CLOCKS_PER_SEC * 1000;
-    int comparacoesLista = comparacoesSequencial;
+    Estatisticas lista;
+    Medicao medicaoLista;
+    No* noLista = medirBusca(ensaioLista, nome, &lista, &medicaoLista).no;
+    long comparacoesLista = lista.comparacoes;
 
     printf("\nLISTA ENCADEADA:\n");
     printf("  Resultado: %s\n", noLista != NULL ? "ENCONTRADO" : "NAO ENCONTRADO");
-    printf("  Comparacoes: %d\n", comparacoesLista);
-    printf("  Tempo: %.4f ms\n", tempoLista);
+    printf("  Comparacoes: %ld\n", comparacoesLista);
+    mostrarTempo("  ", &medicaoLista);
+
+    // Busca na lista desenrolada
+    Estatisticas desenrolada;
+    Medicao medicaoDesenrolada;
+    const Item* itemDesenrolado = medirBusca(ensaioDesenrolada, nome, &desenrolada, &medicaoDesenrolada).item;
+
+    printf("\nLISTA DESENROLADA:\n");
+    printf("  Resultado: %s\n", itemDesenrolado != NULL ? "ENCONTRADO" : "NAO ENCONTRADO");
+    printf("  Comparacoes: %ld\n", desenrolada.comparacoes);
+    printf("  Blocos visitados (saltos de ponteiro): ate %d\n", inventarioDesenrolado.blocos);
+    mostrarTempo("  ", &medicaoDesenrolada);
 
     printf("\n--- BUSCA BINARIA (VETOR ORDENADO) ---\n");
     printf("\nNOTA: Certifique-se de que o vetor esta ordenado!\n");
 
-    inicio = clock();
-    int indiceBinaria = buscarBinariaVetor(nome);
-    fim = clock();
-    double tempoBinaria = ((double)(fim - inicio)) / CLOCKS_PER_SEC * 1000;
+    Estatisticas binaria;
+    Medicao medicaoBinaria;
+    int indiceBinaria = medirBusca(ensaioBinariaVetor, nome, &binaria, &medicaoBinaria).indice;
+    long comparacoesBinaria = binaria.comparacoes;
 
     printf("\nVETOR (Busca Binaria):\n");
     printf("  Resultado: %s\n", indiceBinaria != -1 ? "ENCONTRADO" : "NAO ENCONTRADO");
-    printf("  Comparacoes: %d\n", comparacoesBinaria);
-    printf("  Tempo: %.4f ms\n", tempoBinaria);
+    printf("  Comparacoes: %ld\n", comparacoesBinaria);
+    mostrarTempo("  ", &medicaoBinaria);
+
+    printf("\n--- BUSCA POR INDICE HASH (VETOR) ---\n");
+
+    Estatisticas hash;
+    Medicao medicaoHash;
+    int indiceHash = medirBusca(ensaioHashVetor, nome, &hash, &medicaoHash).indice;
+
+    printf("\nVETOR (Indice Hash):\n");
+    printf("  Resultado: %s\n", indiceHash != -1 ? "ENCONTRADO" : "NAO ENCONTRADO");
+    printf("  Comparacoes: %ld\n", hash.comparacoes);
+    mostrarTempo("  ", &medicaoHash);
 
     printf("\n========================================\n");
     printf("   ANALISE COMPARATIVA\n");
@@ -740,33 +958,135 @@ void compararDesempenho() {
            comparacoesVetor < comparacoesLista ? "Vetor mais eficiente" :
            comparacoesVetor > comparacoesLista ? "Lista mais eficiente" :
            "Desempenho similar");
+    printf("  Lista vs Lista desenrolada: %d nos x %d blocos percorridos\n",
+           inventarioLista.total, inventarioDesenrolado.blocos);
 
     printf("\nBusca Binaria vs Sequencial (vetor):\n");
-    printf("  Ganho de comparacoes: %d -> %d (%.1f%% de reducao)\n",
+    printf("  Ganho de comparacoes: %ld -> %ld (%.1f%% de reducao)\n",
            comparacoesVetor, comparacoesBinaria,
            comparacoesVetor > 0 ? (1.0 - (double)comparacoesBinaria/comparacoesVetor) * 100 : 0);
 
     printf("\nCONCLUSAO:\n");
     printf("  - Busca sequencial: similar em vetor e lista\n");
+    printf("  - Lista desenrolada: mesmas comparacoes, bem menos ponteiros seguidos\n");
     printf("  - Busca binaria: MUITO mais eficiente (requer vetor ordenado)\n");
+    printf("  - Indice hash: O(1) em media, sem exigir ordenacao\n");
     printf("  - Lista encadeada NAO permite busca binaria!\n");
 
     pausar();
 }
 
+// ============================================================================
+// IMPORTACAO DE ARQUIVO
+// ============================================================================
+
+/*
+ * Funcao: importarNasTres
+ * Destino da importacao (importacao.h): cada lote vai para o vetor e as
+ * duas listas, que ficam com os mesmos itens na mesma ordem enquanto ha
+ * memoria. Se uma delas falhar, a importacao para no meio do lote e as
+ * estruturas podem ficar com itens diferentes.
+ *
+ * Parametros:
+ *   - destino: const char* que recebe o nome da estrutura que falhou
+ */
+int importarNasTres(void* destino, const Item* itens, int total) {
+    const char** falhou = (const char**)destino;
+
+    if (!importarParaMochila(&inventarioVetor, itens, total)) {
+        *falhou = "VETOR";
+        return 0;
+    }
+    if (!importarParaLista(&inventarioLista, itens, total)) {
+        *falhou = "LISTA ENCADEADA";
+        return 0;
+    }
+    if (!importarParaDesenrolada(&inventarioDesenrolado, itens, total)) {
+        *falhou = "LISTA DESENROLADA";
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Funcao: importarInventario
+ * Importa um arquivo CSV/TSV para as tres estruturas e exibe o resumo:
+ * itens, linhas rejeitadas, tempo e vazao.
+ *
+ * Retorno: 1 se sucesso, 0 se falhou
+ */
+int importarInventario(const char* caminho) {
+    ResultadoImportacao resultado;
+    const char* falhou = NULL;
+    int sucesso = importarArquivo(caminho, 0, importarNasTres, (void*)&falhou, &resultado);
+
+    if (!sucesso && resultado.bytes == 0) {
+        printf("\n[IMPORTACAO] Nao foi possivel ler '%s'.\n", caminho);
+        return 0;
+    }
+
+    printf("\n[IMPORTACAO] %s\n", caminho);
+    printf("  Itens importados: %lld de %lld linhas\n", resultado.importados, resultado.linhas);
+    if (resultado.rejeitados > 0) {
+        printf("  Linhas rejeitadas: %lld (a primeira e a linha %lld)\n",
+               resultado.rejeitados, resultado.primeiraRejeitada);
+    }
+    printf("  Tempo: %.1f ms para %.1f MB (%.1f MB/s)\n",
+           (double)resultado.ns / 1e6, (double)resultado.bytes / 1e6,
+           importacaoMBPorSegundo(&resultado));
+    if (falhou != NULL) {
+        printf("[ERRO] %s sem memoria: importacao interrompida.\n", falhou);
+        printf("       Itens em cada estrutura: vetor %d | lista %d | desenrolada %d\n",
+               mochilaTotal(&inventarioVetor), inventarioLista.total, inventarioDesenrolado.total);
+    } else if (!sucesso) {
+        printf("[ERRO] Importacao interrompida (erro de leitura ou de alocacao).\n");
+    }
+    return sucesso;
+}
+
+/*
+ * Funcao: menuImportar
+ * Pede o caminho do arquivo e importa os itens para as tres estruturas.
+ */
+void menuImportar() {
+    char caminho[TAM_CAMINHO];
+
+    printf("\nFormato: nome,tipo,quantidade por linha (CSV ou separado por TAB)\n");
+    printf("Digite o caminho do arquivo: ");
+    limparBuffer();
+    lerTexto(caminho, TAM_CAMINHO);
+
+    importarInventario(caminho);
+
+    printf("\nPressione ENTER para continuar...");
+    getchar();
+}
+
 // ============================================================================
 // FUNCAO PRINCIPAL
 // ============================================================================
 
-int main() {
+int main(int argc, char* argv[]) {
     int opcao;
 
     printf("\n");
     printf("========================================\n");
     printf("  SISTEMA DE INVENTARIO - NIVEL AVENTUREIRO\n");
-    printf("  Comparacao: Vetor vs Lista Encadeada\n");
+    printf("  Comparacao: Vetor vs Lista Encadeada vs Lista Desenrolada\n");
     printf("========================================\n");
 
+    if (!mochilaIniciar(&inventarioVetor, CAPACIDADE_INICIAL)) {
+        printf("\nErro ao alocar o vetor!\n");
+        return 1;
+    }
+    listaIniciar(&inventarioLista);
+    desenroladaIniciar(&inventarioDesenrolado);
+
+    // Inventario de teste informado na linha de comando
+    if (argc > 1) {
+        importarInventario(argv[1]);
+    }
+
     do {
         printf("\n");
         printf("========================================\n");
@@ -774,7 +1094,9 @@ int main() {
         printf("========================================\n");
         printf("1. Operacoes com VETOR\n");
         printf("2. Operacoes com LISTA ENCADEADA\n");
-        printf("3. Comparar desempenho\n");
+        printf("3. Operacoes com LISTA DESENROLADA\n");
+        printf("4. Comparar desempenho\n");
+        printf("5. Importar itens de arquivo CSV/TSV\n");
         printf("0. Sair\n");
         printf("========================================\n");
         printf("Escolha: ");
@@ -788,8 +1110,14 @@ int main() {
                 menuLista();
                 break;
             case 3:
+                menuDesenrolada();
+                break;
+            case 4:
                 compararDesempenho();
                 break;
+            case 5:
+                menuImportar();
+                break;
             case 0:
                 printf("\n Encerrando sistema...\n");
                 printf(" Boa sorte no campo de batalha!\n\n");
@@ -801,8 +1129,14 @@ int main() {
 
     } while (opcao != 0);
 
-    // Libera memoria da lista encadeada
-    liberarLista();
+    // Histogramas de latencia do vetor, se MOCHILA_LATENCIAS=arquivo.csv
+    latenciaSalvarSeConfigurado();
+
+    // Libera memoria do vetor, das listas e do dicionario de tipos
+    mochilaLiberar(&inventarioVetor);
+    listaLiberar(&inventarioLista);
+    desenroladaLiberar(&inventarioDesenrolado);
+    tiposLiberar();
 
     return 0;
 }
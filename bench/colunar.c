@@ -0,0 +1,244 @@
+/*
+ * BENCHMARK - MOCHILA EM VETOR DE ITENS x MOCHILA EM COLUNAS
+ *
+ * Carrega o mesmo inventario sintetico na Mochila (vetor de Item) e na
+ * MochilaColunar (mochila_colunar.h) e mede as operacoes em que o layout
+ * importa:
+ *
+ *   make bench-colunar            (n = BENCH_COLUNAR_N do Makefile)
+ *   ./bench/colunar 5000000       (outro tamanho)
+ *
+ *   - soma das quantidades: percorre o campo quantidade de todos os itens
+ *     (48 bytes lidos por item no vetor, 4 nas colunas)
+ *   - busca por nome: CONSULTAS buscas no indice hash de cada mochila
+ *   - ordenacao por PRIORIDADE, TIPO e NOME: mochilaOrdenar contra
+ *     colunarOrdenar com o mesmo algoritmo (Counting Sort para as chaves
+ *     inteiras, Radix Sort para o nome). As duas refazem o indice hash
+ *
+ * Depois de cada ordenacao as duas mochilas sao comparadas linha a linha:
+ * colunarOrdenar tem de dar a mesma ordem e executar o mesmo algoritmo
+ * que mochilaOrdenar. Os agregados e as buscas tambem sao conferidos. Se
+ * algo diferir, o programa termina com erro.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mochila.h"
+#include "mochila_colunar.h"
+
+#define N_PADRAO 1000000
+#define N_LIMITE 50000000
+#define REPETICOES_SOMA 10           // Somas medidas (vale a menor)
+#define CONSULTAS 1000000            // Buscas por nome medidas
+#define LETRAS_MINIMO 6              // Nomes de 6 a 12 letras: parte empata no prefixo
+#define LETRAS_MAXIMO 12
+
+static const char* tiposGerados[] = {"municao", "arma", "ferramenta", "cura", "suporte"};
+
+static uint64_t semente = 88172645463325252ULL;
+
+static uint64_t aleatorio(void) {
+    semente ^= semente << 13;
+    semente ^= semente >> 7;
+    semente ^= semente << 17;
+    return semente;
+}
+
+static double agoraMs(void) {
+    return (double)cronometroNs() / 1e6;
+}
+
+/*
+ * Funcao: gerarItens
+ * n itens com nome, tipo, quantidade e prioridade (1 a 5) aleatorios.
+ */
+static void gerarItens(Item* itens, int n) {
+    unsigned short ids[5];
+    for (int t = 0; t < 5; t++) {
+        ids[t] = tipoRegistrar(tiposGerados[t]);
+    }
+
+    for (int i = 0; i < n; i++) {
+        Item* item = &itens[i];
+        uint64_t sorteio = aleatorio();
+        int letras = LETRAS_MINIMO + (int)(sorteio % (LETRAS_MAXIMO - LETRAS_MINIMO + 1));
+
+        memset(item, 0, sizeof(Item));
+        for (int c = 0; c < letras; c++) {
+            item->nome[c] = (char)('a' + aleatorio() % 26);
+        }
+        item->idTipo = ids[(sorteio >> 8) % 5];
+        item->quantidade = 1 + (int)((sorteio >> 16) % 100);
+        item->prioridade = 1 + (int)((sorteio >> 32) % 5);
+    }
+}
+
+/*
+ * Funcao: carregar
+ * Esvazia as duas mochilas e insere os mesmos itens, na mesma ordem.
+ *
+ * Retorno: 1 se sucesso, 0 se faltou memoria
+ */
+static int carregar(Mochila* mochila, MochilaColunar* colunar, const Item* itens, int n) {
+    mochilaLiberar(mochila);
+    colunarLiberar(colunar);
+    if (!mochilaIniciar(mochila, n) || !colunarIniciar(colunar, n)) {
+        return 0;
+    }
+    for (int i = 0; i < n; i++) {
+        if (!colunarInserir(colunar, itens[i])) {
+            return 0;
+        }
+    }
+    return mochilaInserirLote(mochila, itens, n) == n;
+}
+
+/*
+ * Funcao: mesmaOrdem
+ * Confere se a linha i das colunas e o item i do vetor sao iguais.
+ *
+ * Retorno: primeira linha diferente, ou -1 se todas iguais
+ */
+static int mesmaOrdem(const Mochila* mochila, const MochilaColunar* colunar) {
+    if (mochilaTotal(mochila) != colunarTotal(colunar)) {
+        return 0;
+    }
+    for (int i = 0; i < mochilaTotal(mochila); i++) {
+        const Item* item = mochilaItem(mochila, i);
+        Item linha;
+        if (!colunarItem(colunar, i, &linha) || strcmp(item->nome, linha.nome) != 0 ||
+            item->idTipo != linha.idTipo || item->quantidade != linha.quantidade ||
+            item->prioridade != linha.prioridade) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int main(int argc, char* argv[]) {
+    long n = argc > 1 ? atol(argv[1]) : N_PADRAO;
+    if (n < 2 || n > N_LIMITE) {
+        fprintf(stderr, "Uso: %s [n entre 2 e %d]\n", argv[0], N_LIMITE);
+        return 1;
+    }
+
+    Item* itens = (Item*)malloc(sizeof(Item) * (size_t)n);
+    if (itens == NULL) {
+        fprintf(stderr, "[ERRO] Sem memoria para %ld itens\n", n);
+        return 1;
+    }
+    gerarItens(itens, (int)n);
+
+    Mochila mochila;
+    MochilaColunar colunar;
+    mochilaIniciar(&mochila, 0);
+    colunarIniciar(&colunar, 0);
+
+    int erro = 0;
+    if (!carregar(&mochila, &colunar, itens, (int)n)) {
+        fprintf(stderr, "[ERRO] Sem memoria para %ld itens\n", n);
+        return 1;
+    }
+
+    printf("%ld itens (Item de %zu bytes)\n\n", n, sizeof(Item));
+    printf("%-26s %12s %12s %9s\n", "operacao", "vetor (ms)", "colunas (ms)", "vetor/col");
+
+    // Soma das quantidades: cada layout percorre o campo diretamente
+    double melhorVetor = 0;
+    double melhorColunas = 0;
+    long long somaVetor = 0;
+    long long somaColunas = 0;
+    for (int r = 0; r < REPETICOES_SOMA; r++) {
+        double inicio = agoraMs();
+        long long soma = 0;
+        for (int i = 0; i < mochila.total; i++) {
+            soma += mochila.itens[i].quantidade;
+        }
+        double meio = agoraMs();
+        somaColunas = colunarSomarQuantidades(&colunar);
+        double fim = agoraMs();
+
+        somaVetor = soma;
+        if (r == 0 || meio - inicio < melhorVetor) {
+            melhorVetor = meio - inicio;
+        }
+        if (r == 0 || fim - meio < melhorColunas) {
+            melhorColunas = fim - meio;
+        }
+    }
+    printf("%-26s %12.2f %12.2f %8.1fx\n", "soma das quantidades", melhorVetor, melhorColunas,
+           melhorColunas > 0 ? melhorVetor / melhorColunas : 0.0);
+    if (somaVetor != somaColunas || mochilaAgregadoGeral(&mochila).quantidade != somaColunas ||
+        colunarAgregadoGeral(&colunar).quantidade != somaColunas) {
+        printf("[ERRO] Somas diferentes: %lld x %lld\n", somaVetor, somaColunas);
+        erro = 1;
+    }
+
+    // Busca por nome: as duas usam o indice hash (indice_hash.h)
+    int falhas = 0;
+    double inicio = agoraMs();
+    for (int i = 0; i < CONSULTAS; i++) {
+        falhas += mochilaBuscar(&mochila, itens[(int)(((long)i * 104729) % n)].nome, NULL) == -1;
+    }
+    double meio = agoraMs();
+    for (int i = 0; i < CONSULTAS; i++) {
+        falhas += colunarBuscar(&colunar, itens[(int)(((long)i * 104729) % n)].nome, NULL) == -1;
+    }
+    double fim = agoraMs();
+    printf("%-26s %12.1f %12.1f %8.1fx\n", "buscar por nome (hash)", meio - inicio, fim - meio,
+           fim > meio ? (meio - inicio) / (fim - meio) : 0.0);
+    if (falhas > 0) {
+        printf("[ERRO] %d buscas nao encontraram o nome\n", falhas);
+        erro = 1;
+    }
+
+    const CriterioOrdenacao criterios[] = {PRIORIDADE, TIPO, NOME};
+    const char* nomesCriterios[] = {"ordenar por prioridade", "ordenar por tipo", "ordenar por nome"};
+    for (int c = 0; c < 3 && !erro; c++) {
+        // Cada ordenacao parte da ordem de insercao
+        if (c > 0 && !carregar(&mochila, &colunar, itens, (int)n)) {
+            fprintf(stderr, "[ERRO] Sem memoria para recarregar %ld itens\n", n);
+            erro = 1;
+            break;
+        }
+
+        AlgoritmoOrdenacao algoritmo = criterios[c] == NOME ? RADIX_SORT : COUNTING_SORT;
+        inicio = agoraMs();
+        long resultadoVetor = mochilaOrdenar(&mochila, criterios[c], algoritmo, NULL);
+        meio = agoraMs();
+        long resultadoColunas = colunarOrdenar(&colunar, criterios[c], algoritmo, NULL);
+        fim = agoraMs();
+
+        printf("%-26s %12.1f %12.1f %8.1fx\n", nomesCriterios[c], meio - inicio, fim - meio,
+               fim > meio ? (meio - inicio) / (fim - meio) : 0.0);
+
+        int diferente = mesmaOrdem(&mochila, &colunar);
+        if (resultadoVetor < 0 || resultadoColunas < 0) {
+            printf("[ERRO] Falha ao ordenar (memoria)\n");
+            erro = 1;
+        } else if (diferente != -1) {
+            printf("[ERRO] colunarOrdenar difere de mochilaOrdenar na linha %d\n", diferente);
+            erro = 1;
+        } else if (mochilaUltimoAlgoritmo(&mochila) != colunarUltimoAlgoritmo(&colunar)) {
+            printf("[ERRO] Algoritmos diferentes: %s x %s\n", nomeAlgoritmo(mochilaUltimoAlgoritmo(&mochila)),
+                   nomeAlgoritmo(colunarUltimoAlgoritmo(&colunar)));
+            erro = 1;
+        } else if (colunarBuscar(&colunar, itens[0].nome, NULL) != mochilaBuscar(&mochila, itens[0].nome, NULL)) {
+            printf("[ERRO] Indice hash das colunas desatualizado depois de ordenar\n");
+            erro = 1;
+        }
+    }
+
+    if (!erro) {
+        printf("\nMesma ordem e mesmo algoritmo nas duas mochilas depois de cada ordenacao.\n");
+    }
+
+    mochilaLiberar(&mochila);
+    colunarLiberar(&colunar);
+    free(itens);
+    tiposLiberar();
+    return erro;
+}
@@ -0,0 +1,211 @@
+/*
+ * BENCHMARK - IMPORTACAO CSV
+ *
+ * Gera um inventario CSV sintetico e mede a vazao (MB/s) de importarArquivo
+ * (importacao.h):
+ *
+ *   make bench-importacao                 (BENCH_IMPORTACAO_MB do Makefile)
+ *   ./bench/importacao 4096               (arquivo de 4 GB)
+ *   ./bench/importacao 4096 /dados/x.csv  (gerado em outro disco)
+ *
+ * A primeira medicao so separa os campos e descarta os itens, sobre o
+ * arquivo inteiro: mostra a vazao do leitor e que a memoria dele nao
+ * cresce com o arquivo (RSS maximo do processo). As demais inserem os
+ * itens no vetor, na lista, na lista desenrolada e nas tres de uma vez,
+ * sobre um arquivo de no maximo MB_ESTRUTURAS (os itens ficam todos na
+ * memoria). Os arquivos gerados sao apagados no fim.
+ *
+ * A primeira leitura de um arquivo recem-gravado costuma vir do cache de
+ * paginas do sistema; para medir o disco, limpe o cache antes.
+ */
+
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "importacao.h"
+#include "lista.h"
+#include "lista_desenrolada.h"
+#include "mochila.h"
+
+#define MB_PADRAO 256
+#define MB_LIMITE (1L << 20)     // 1 TB
+#define MB_ESTRUTURAS 64         // Maior arquivo importado para as estruturas
+#define ARQUIVO_PADRAO "bench/importacao.csv"
+
+static const char* tiposGerados[] = {"arma", "municao", "cura", "ferramenta"};
+
+static uint64_t semente = 88172645463325252ULL;
+
+static uint64_t aleatorio(void) {
+    semente ^= semente << 13;
+    semente ^= semente >> 7;
+    semente ^= semente << 17;
+    return semente;
+}
+
+/*
+ * Funcao: gerarArquivo
+ * Grava linhas "nome,tipo,quantidade,prioridade" (com cabecalho) ate o
+ * arquivo ter 'megabytes' MB.
+ *
+ * Retorno: linhas de itens gravadas, ou -1 se falhou
+ */
+static long long gerarArquivo(const char* caminho, long megabytes) {
+    FILE* arquivo = fopen(caminho, "wb");
+    if (arquivo == NULL) {
+        return -1;
+    }
+
+    long long alvo = (long long)megabytes * 1000000;
+    long long gravados = fprintf(arquivo, "nome,tipo,quantidade,prioridade\n");
+    long long linhas = 0;
+    char linha[64];
+
+    while (gravados < alvo) {
+        uint64_t sorteio = aleatorio();
+        int tamanho = snprintf(linha, sizeof(linha), "Item %010llu,%s,%d,%d\n",
+                               (unsigned long long)(sorteio % 10000000000ULL),
+                               tiposGerados[(sorteio >> 40) & 3],
+                               (int)((sorteio >> 42) % 100) + 1,
+                               (int)((sorteio >> 50) % 5) + 1);
+        if (fwrite(linha, 1, (size_t)tamanho, arquivo) != (size_t)tamanho) {
+            fclose(arquivo);
+            return -1;
+        }
+        gravados += tamanho;
+        linhas++;
+    }
+
+    if (fclose(arquivo) != 0) {
+        return -1;
+    }
+    return linhas;
+}
+
+static int descartar(void* destino, const Item* itens, int total) {
+    (void)itens;
+    *(long long*)destino += total;
+    return 1;
+}
+
+/*
+ * Struct: Estruturas
+ * Destino de uma importacao nas tres estruturas de uma vez.
+ */
+typedef struct {
+    Mochila vetor;
+    Lista lista;
+    ListaDesenrolada desenrolada;
+} Estruturas;
+
+static int inserirNasTres(void* destino, const Item* itens, int total) {
+    Estruturas* estruturas = (Estruturas*)destino;
+    return importarParaMochila(&estruturas->vetor, itens, total) &&
+           importarParaLista(&estruturas->lista, itens, total) &&
+           importarParaDesenrolada(&estruturas->desenrolada, itens, total);
+}
+
+static void imprimirResultado(const char* estrutura, const ResultadoImportacao* resultado, int sucesso) {
+    printf("%-12s %10.1f %12lld %10lld %10.1f %10.1f%s\n", estrutura,
+           (double)resultado->bytes / 1e6, resultado->importados, resultado->rejeitados,
+           (double)resultado->ns / 1e6, importacaoMBPorSegundo(resultado),
+           sucesso ? "" : "  [ERRO]");
+}
+
+static long rssMaximoMB(void) {
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) != 0) {
+        return -1;
+    }
+    return uso.ru_maxrss / 1024;  // ru_maxrss em KB (Linux)
+}
+
+/*
+ * Funcao: medirEstruturas
+ * Importa o arquivo em cada estrutura (vazia a cada medicao) e nas tres
+ * juntas.
+ */
+static void medirEstruturas(const char* caminho) {
+    ResultadoImportacao resultado;
+    Estruturas estruturas;
+    int sucesso;
+
+    mochilaIniciar(&estruturas.vetor, 0);
+    sucesso = importarArquivo(caminho, ',', importarParaMochila, &estruturas.vetor, &resultado);
+    imprimirResultado("vetor", &resultado, sucesso);
+    mochilaLiberar(&estruturas.vetor);
+
+    listaIniciar(&estruturas.lista);
+    sucesso = importarArquivo(caminho, ',', importarParaLista, &estruturas.lista, &resultado);
+    imprimirResultado("lista", &resultado, sucesso);
+    listaLiberar(&estruturas.lista);
+
+    desenroladaIniciar(&estruturas.desenrolada);
+    sucesso = importarArquivo(caminho, ',', importarParaDesenrolada, &estruturas.desenrolada, &resultado);
+    imprimirResultado("desenrolada", &resultado, sucesso);
+    desenroladaLiberar(&estruturas.desenrolada);
+
+    mochilaIniciar(&estruturas.vetor, 0);
+    listaIniciar(&estruturas.lista);
+    desenroladaIniciar(&estruturas.desenrolada);
+    sucesso = importarArquivo(caminho, ',', inserirNasTres, &estruturas, &resultado);
+    imprimirResultado("as tres", &resultado, sucesso);
+    mochilaLiberar(&estruturas.vetor);
+    listaLiberar(&estruturas.lista);
+    desenroladaLiberar(&estruturas.desenrolada);
+}
+
+int main(int argc, char* argv[]) {
+    long megabytes = argc > 1 ? atol(argv[1]) : MB_PADRAO;
+    const char* caminho = argc > 2 ? argv[2] : ARQUIVO_PADRAO;
+    if (megabytes < 1 || megabytes > MB_LIMITE) {
+        fprintf(stderr, "Uso: %s [megabytes entre 1 e %ld] [arquivo.csv]\n", argv[0], MB_LIMITE);
+        return 1;
+    }
+
+    printf("Gerando %s (%ld MB)...\n", caminho, megabytes);
+    long long linhas = gerarArquivo(caminho, megabytes);
+    if (linhas < 0) {
+        fprintf(stderr, "[ERRO] Nao foi possivel gravar %s\n", caminho);
+        remove(caminho);
+        return 1;
+    }
+    printf("%lld linhas; buffer de leitura de %d KB, lotes de %d itens\n\n", linhas,
+           TAM_BUFFER_IMPORTACAO / 1024, ITENS_POR_LOTE_IMPORTACAO);
+
+    printf("%-12s %10s %12s %10s %10s %10s\n", "destino", "MB", "itens", "rejeitadas", "ms", "MB/s");
+
+    ResultadoImportacao resultado;
+    long long descartados = 0;
+    int sucesso = importarArquivo(caminho, ',', descartar, &descartados, &resultado);
+    imprimirResultado("so leitura", &resultado, sucesso);
+    long rss = rssMaximoMB();
+
+    // As estruturas guardam todos os itens: usam um arquivo menor se preciso
+    char menor[1024];
+    const char* arquivoEstruturas = caminho;
+    if (megabytes > MB_ESTRUTURAS) {
+        snprintf(menor, sizeof(menor), "%s.%d", caminho, MB_ESTRUTURAS);
+        if (gerarArquivo(menor, MB_ESTRUTURAS) < 0) {
+            fprintf(stderr, "[ERRO] Nao foi possivel gravar %s\n", menor);
+            remove(menor);
+            remove(caminho);
+            return 1;
+        }
+        arquivoEstruturas = menor;
+    }
+    medirEstruturas(arquivoEstruturas);
+
+    printf("\nRSS maximo apos a leitura de %ld MB: %ld MB\n", megabytes, rss);
+
+    if (arquivoEstruturas != caminho) {
+        remove(arquivoEstruturas);
+    }
+    remove(caminho);
+    tiposLiberar();
+    return 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * BENCHMARK - PREFIXO DO NOME
+ *
+ * Mede ordenacao e busca binaria por nome com o prefixo de 8 bytes
+ * (comparacao de inteiros, strcmp so nos empates) e sem ele (strcmp em
+ * toda comparacao). O mesmo codigo e compilado duas vezes pelo Makefile,
+ * a segunda com -DSEM_PREFIXO_NOME (ver compararNomes em item.c):
+ *
+ *   make bench-prefixo            (n = 100000)
+ *   ./bench/prefixo 500000        (outro tamanho)
+ *
+ * Dois conjuntos de nomes:
+ *   - aleatorio: letras aleatorias, 6 a 20 caracteres; quase todo par
+ *     difere nos 8 primeiros bytes
+ *   - prefixo comum: "Kit Medico 00042"...; os 8 primeiros bytes sao
+ *     iguais em todos, entao todo empate cai no strcmp (pior caso)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mochila.h"
+
+#define N_PADRAO 100000
+
+#ifdef SEM_PREFIXO_NOME
+#define MODO "sem prefixo"
+#else
+#define MODO "com prefixo"
+#endif
+
+/*
+ * Funcao: agoraMs
+ * Tempo monotono em milissegundos.
+ */
+static double agoraMs(void) {
+    return (double)cronometroNs() / 1e6;
+}
+
+/*
+ * Funcao: gerarNomes
+ * Preenche os itens com nomes distintos do conjunto pedido.
+ */
+static void gerarNomes(Item* itens, int n, int prefixoComum) {
+    for (int i = 0; i < n; i++) {
+        memset(&itens[i], 0, sizeof(Item));
+        if (prefixoComum) {
+            snprintf(itens[i].nome, TAM_NOME, "Kit Medico %07d", (int)(((long)i * 7919) % n));
+        } else {
+            int tamanho = 6 + rand() % 15;
+            for (int c = 0; c < tamanho; c++) {
+                itens[i].nome[c] = (char)('a' + rand() % 26);
+            }
+            // Sufixo garante nomes distintos
+            snprintf(itens[i].nome + tamanho, (size_t)(TAM_NOME - tamanho), "%d", i);
+        }
+        itens[i].quantidade = 1;
+        itemAtualizarPrefixo(&itens[i]);
+    }
+}
+
+/*
+ * Funcao: empatesDePrefixo
+ * Percentual de vizinhos (vetor ordenado) com o mesmo prefixo: quanto
+ * maior, mais comparacoes precisam do strcmp para desempatar.
+ */
+static double empatesDePrefixo(const Item* itens, int n) {
+    int empates = 0;
+    for (int i = 1; i < n; i++) {
+        if (itens[i].prefixoNome == itens[i - 1].prefixoNome) {
+            empates++;
+        }
+    }
+    return n > 1 ? 100.0 * empates / (n - 1) : 0.0;
+}
+
+/*
+ * Funcao: medirConjunto
+ * Ordena (Merge Sort e Introsort) e faz n buscas binarias sobre o
+ * conjunto, imprimindo comparacoes e tempo de cada etapa.
+ */
+static void medirConjunto(const char* nomeConjunto, const Item* itens, int n) {
+    Item* copia = (Item*)malloc(sizeof(Item) * (size_t)n);
+    if (copia == NULL) {
+        printf("[ERRO] Sem memoria para %d itens\n", n);
+        return;
+    }
+
+    AlgoritmoOrdenacao algoritmos[] = {MERGE_SORT, INTRO_SORT};
+    for (int a = 0; a < 2; a++) {
+        memcpy(copia, itens, sizeof(Item) * (size_t)n);
+        double inicio = agoraMs();
+        long comparacoes = ordenarItens(copia, n, NOME, algoritmos[a], NULL);
+        double fim = agoraMs();
+        printf("%-12s %-14s %-16s %12ld %10.2f\n", MODO, nomeConjunto,
+               nomeAlgoritmo(algoritmos[a]), comparacoes, fim - inicio);
+    }
+
+    Mochila mochila;
+    if (!mochilaIniciar(&mochila, n)) {
+        free(copia);
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        mochilaInserir(&mochila, copia[i]);
+    }
+    mochilaOrdenar(&mochila, NOME, MERGE_SORT, NULL);
+
+    Estatisticas busca;
+    estatisticasZerar(&busca);
+    int naoEncontrados = 0;
+    double inicio = agoraMs();
+    for (int i = 0; i < n; i++) {
+        if (mochilaBuscarBinaria(&mochila, itens[(int)(((long)i * 104729) % n)].nome, &busca) < 0) {
+            naoEncontrados++;
+        }
+    }
+    double fim = agoraMs();
+    printf("%-12s %-14s %-16s %12ld %10.2f\n", MODO, nomeConjunto, "Busca binaria", busca.comparacoes,
+           fim - inicio);
+    printf("%-12s %-14s empates de prefixo entre vizinhos: %.1f%%%s\n", MODO, nomeConjunto,
+           empatesDePrefixo(copia, n), naoEncontrados ? " [ERRO: busca falhou]" : "");
+
+    mochilaLiberar(&mochila);
+    free(copia);
+}
+
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? atoi(argv[1]) : N_PADRAO;
+    if (n <= 0) {
+        n = N_PADRAO;
+    }
+
+    Item* itens = (Item*)malloc(sizeof(Item) * (size_t)n);
+    if (itens == NULL) {
+        printf("[ERRO] Sem memoria para %d itens\n", n);
+        return 1;
+    }
+
+    srand(42);
+    printf("%-12s %-14s %-16s %12s %10s\n", "modo", "conjunto", "operacao", "comparacoes", "ms");
+
+    gerarNomes(itens, n, 0);
+    medirConjunto("aleatorio", itens, n);
+
+    gerarNomes(itens, n, 1);
+    medirConjunto("prefixo comum", itens, n);
+
+    free(itens);
+    return 0;
+}
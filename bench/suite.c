@@ -0,0 +1,398 @@
+/*
+ * BENCHMARK - SUITE DE ORDENACAO E BUSCA
+ *
+ * Gera inventarios sinteticos de 10 a n_max itens (potencias de 10) em
+ * quatro distribuicoes e mede todos os algoritmos de ordenacao e busca da
+ * biblioteca, sem interacao. A saida e CSV:
+ *
+ *   make bench                          (n_max = BENCH_N do Makefile)
+ *   ./bench/suite 10000000 saida.csv    (ate 10^7 itens, em arquivo)
+ *   ./bench/suite 1000                  (CSV na saida padrao)
+ *
+ * Colunas: distribuicao, n, algoritmo, comparacoes, trocas, movimentos,
+ * bytes_movidos, ns_por_op, threads, speedup. Uma "op" e a operacao
+ * medida: uma ordenacao completa dos n itens ou uma busca. Os contadores
+ * seguem Estatisticas (estatisticas.h) e tambem sao por op (media das
+ * repeticoes); buscas nao movem elementos. O speedup so e preenchido no
+ * Merge Sort paralelo: tempo do Merge Sort sequencial pelo mesmo criterio
+ * dividido pelo dele. As ordenacoes sao por nome, exceto o Counting Sort
+ * e um par Merge Sort / Merge Sort paralelo por prioridade.
+ *
+ * Distribuicoes (nomes de 7 letras, ordem alfabetica = ordem numerica):
+ *   - uniforme: nomes aleatorios
+ *   - ordenada: ja em ordem de nome (e de prioridade)
+ *   - invertida: ordem inversa
+ *   - duplicadas: cada nome aparece ~REPETICOES_DUPLICADAS vezes
+ *
+ * Os algoritmos quadraticos so rodam ate LIMITE_QUADRATICO itens, e as
+ * buscas lineares (sequencial e listas) fazem menos consultas quando n
+ * cresce, para a suite inteira terminar em poucos minutos com 10^7.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lista.h"
+#include "lista_desenrolada.h"
+#include "mochila.h"
+
+#define N_MAX_PADRAO 100000
+#define N_MAX_LIMITE 10000000
+#define LIMITE_QUADRATICO 10000      // Maior n para Selection, Bubble e Insertion
+#define TEMPO_MINIMO_NS 10e6          // Ordenacoes rapidas repetem ate somar 10 ms
+#define CONSULTAS 10000              // Buscas O(1) / O(log n) por medicao
+#define ORCAMENTO_LINEAR 100000000L  // Itens visitados pelas buscas lineares
+#define REPETICOES_DUPLICADAS 100
+#define LETRAS_NOME 7
+#define FAIXA_CHAVES 8031810176ULL   // 26^7: chaves distintas com 7 letras
+
+typedef enum {
+    UNIFORME,
+    ORDENADA,
+    INVERTIDA,
+    DUPLICADAS
+} Distribuicao;
+
+static const char* nomesDistribuicao[] = {"uniforme", "ordenada", "invertida", "duplicadas"};
+
+static uint64_t semente = 88172645463325252ULL;
+
+// ============================================================================
+// AUXILIARES
+// ============================================================================
+
+/*
+ * Funcao: aleatorio
+ * Gerador xorshift64: rand() nao cobre as 26^7 chaves.
+ */
+static uint64_t aleatorio(void) {
+    semente ^= semente << 13;
+    semente ^= semente >> 7;
+    semente ^= semente << 17;
+    return semente;
+}
+
+/*
+ * Funcao: agoraNs
+ * Relogio monotono da biblioteca (cronometro.h), em double para somar.
+ */
+static double agoraNs(void) {
+    return (double)cronometroNs();
+}
+
+/*
+ * Funcao: montarItem
+ * Item sintetico da chave k: nome com LETRAS_NOME letras em base 26 e
+ * prioridade decrescente com a chave (nomes em ordem crescente ficam
+ * tambem em ordem de prioridade).
+ */
+static void montarItem(Item* item, uint64_t chave, unsigned short idTipo) {
+    memset(item, 0, sizeof(Item));
+    uint64_t resto = chave;
+    for (int c = LETRAS_NOME - 1; c >= 0; c--) {
+        item->nome[c] = (char)('a' + resto % 26);
+        resto /= 26;
+    }
+    item->idTipo = idTipo;
+    item->quantidade = 1 + (int)(chave % 100);
+    item->prioridade = 5 - (int)(chave * 5 / FAIXA_CHAVES);
+    itemAtualizarPrefixo(item);
+}
+
+/*
+ * Funcao: gerarInventario
+ * Preenche n itens na distribuicao pedida.
+ */
+static void gerarInventario(Item* itens, int n, Distribuicao distribuicao, unsigned short idTipo) {
+    uint64_t passo = FAIXA_CHAVES / (uint64_t)n;
+    uint64_t distintos = n > REPETICOES_DUPLICADAS ? (uint64_t)(n / REPETICOES_DUPLICADAS) : 1;
+
+    for (int i = 0; i < n; i++) {
+        uint64_t chave = 0;
+        switch (distribuicao) {
+            case UNIFORME:
+                chave = aleatorio() % FAIXA_CHAVES;
+                break;
+            case ORDENADA:
+                chave = (uint64_t)i * passo;
+                break;
+            case INVERTIDA:
+                chave = (uint64_t)(n - 1 - i) * passo;
+                break;
+            case DUPLICADAS:
+                chave = (aleatorio() % distintos) * (FAIXA_CHAVES / distintos);
+                break;
+        }
+        montarItem(&itens[i], chave, idTipo);
+    }
+}
+
+/*
+ * Funcao: escreverLinha
+ * Uma linha do CSV, com as estatisticas acumuladas em 'operacoes'
+ * execucoes divididas por op. Speedup 0 deixa a coluna vazia.
+ */
+static void escreverLinha(FILE* saida, Distribuicao distribuicao, int n, const char* algoritmo,
+                          const Estatisticas* estatisticas, int operacoes, double decorrido, int threads,
+                          double speedup) {
+    double ops = (double)operacoes;
+    fprintf(saida, "%s,%d,%s,%.1f,%.1f,%.1f,%.1f,%.1f,%d,", nomesDistribuicao[distribuicao], n, algoritmo,
+            (double)estatisticas->comparacoes / ops, (double)estatisticas->trocas / ops,
+            (double)estatisticas->movimentos / ops, (double)estatisticas->bytesMovidos / ops,
+            decorrido / ops, threads);
+    if (speedup > 0.0) {
+        fprintf(saida, "%.2f", speedup);
+    }
+    fprintf(saida, "\n");
+}
+
+// ============================================================================
+// ORDENACAO
+// ============================================================================
+
+/*
+ * Funcao: medirOrdenacao
+ * Ordena copias do inventario pelo criterio com o algoritmo pedido,
+ * repetindo ate somar TEMPO_MINIMO_NS. So a ordenacao entra no tempo (a
+ * copia fica de fora). Linhas por PRIORIDADE levam "(prioridade)" no nome
+ * do algoritmo.
+ *
+ * Parametros:
+ *   - referenciaNs: tempo do Merge Sort sequencial, para o speedup do
+ *                   paralelo (0 nos demais)
+ *
+ * Retorno: tempo medio de uma ordenacao, em ns
+ */
+static double medirOrdenacao(FILE* saida, Distribuicao distribuicao, const Item* itens, Item* copia,
+                             int n, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                             double referenciaNs) {
+    Estatisticas estatisticas;
+    double decorrido = 0.0;
+    int repeticoes = 0;
+
+    estatisticasZerar(&estatisticas);
+    do {
+        memcpy(copia, itens, sizeof(Item) * (size_t)n);
+        double inicio = agoraNs();
+        ordenarItens(copia, n, criterio, algoritmo, &estatisticas);
+        decorrido += agoraNs() - inicio;
+        repeticoes++;
+    } while (decorrido < TEMPO_MINIMO_NS);
+
+    // Registra o algoritmo que de fato rodou (ver algoritmoEfetivo)
+    AlgoritmoOrdenacao efetivo = algoritmoEfetivo(itens, n, criterio, algoritmo);
+    int threads = efetivo == MERGE_SORT_PARALELO ? threadsOrdenacao(n, 0, 0) : 1;
+    double nsPorOp = decorrido / repeticoes;
+    char nome[64];
+    snprintf(nome, sizeof(nome), criterio == PRIORIDADE ? "%s (prioridade)" : "%s", nomeAlgoritmo(efetivo));
+    escreverLinha(saida, distribuicao, n, nome, &estatisticas, repeticoes, decorrido, threads,
+                  referenciaNs > 0.0 ? referenciaNs / nsPorOp : 0.0);
+    return nsPorOp;
+}
+
+static void medirOrdenacoes(FILE* saida, Distribuicao distribuicao, const Item* itens, int n) {
+    static const AlgoritmoOrdenacao algoritmos[] = {
+        SELECTION_SORT, BUBBLE_SORT, INSERTION_SORT, MERGE_SORT, INTRO_SORT, COUNTING_SORT, RADIX_SORT,
+        MERGE_SORT_PARALELO
+    };
+    double mergeSequencialNs = 0.0;
+
+    Item* copia = (Item*)malloc(sizeof(Item) * (size_t)n);
+    if (copia == NULL) {
+        fprintf(stderr, "[ERRO] Sem memoria para ordenar %d itens\n", n);
+        return;
+    }
+
+    for (size_t a = 0; a < sizeof(algoritmos) / sizeof(algoritmos[0]); a++) {
+        bool quadratico = algoritmos[a] <= INSERTION_SORT;
+        if (quadratico && n > LIMITE_QUADRATICO) {
+            continue;
+        }
+        CriterioOrdenacao criterio = algoritmos[a] == COUNTING_SORT ? PRIORIDADE : NOME;
+        double referenciaNs = algoritmos[a] == MERGE_SORT_PARALELO ? mergeSequencialNs : 0.0;
+        double nsPorOp = medirOrdenacao(saida, distribuicao, itens, copia, n, criterio, algoritmos[a], referenciaNs);
+        if (algoritmos[a] == MERGE_SORT) {
+            mergeSequencialNs = nsPorOp;
+        }
+    }
+
+    // O paralelo tambem atende chaves inteiras: speedup por prioridade
+    mergeSequencialNs = medirOrdenacao(saida, distribuicao, itens, copia, n, PRIORIDADE, MERGE_SORT, 0.0);
+    medirOrdenacao(saida, distribuicao, itens, copia, n, PRIORIDADE, MERGE_SORT_PARALELO, mergeSequencialNs);
+    free(copia);
+}
+
+// ============================================================================
+// BUSCA
+// ============================================================================
+
+/*
+ * Struct: Consultas
+ * Nomes procurados em uma medicao (todos presentes no inventario).
+ */
+typedef struct {
+    const Item* itens;
+    int n;
+    int quantidade;
+} Consultas;
+
+static const char* nomeConsulta(const Consultas* consultas, int i) {
+    return consultas->itens[(int)(((long)i * 104729) % consultas->n)].nome;
+}
+
+/*
+ * Funcao: consultasLineares
+ * Quantas buscas O(n) cabem no ORCAMENTO_LINEAR (ao menos 10).
+ */
+static int consultasLineares(int n) {
+    long quantidade = ORCAMENTO_LINEAR / n;
+    if (quantidade > CONSULTAS) {
+        quantidade = CONSULTAS;
+    }
+    return quantidade < 10 ? 10 : (int)quantidade;
+}
+
+static void registrarBusca(FILE* saida, Distribuicao distribuicao, int n, const char* nome,
+                           const Estatisticas* estatisticas, int falhas, double decorrido, int quantidade) {
+    if (falhas > 0) {
+        fprintf(stderr, "[ERRO] %s: %d nomes nao encontrados (n = %d)\n", nome, falhas, n);
+    }
+    escreverLinha(saida, distribuicao, n, nome, estatisticas, quantidade, decorrido, 1, 0.0);
+}
+
+/*
+ * Funcao: medirBuscasMochila
+ * Busca por hash, sequencial e binaria na mochila com o inventario.
+ */
+static void medirBuscasMochila(FILE* saida, Distribuicao distribuicao, const Item* itens, int n) {
+    typedef int (*FuncaoBusca)(const Mochila*, const char*, Estatisticas*);
+    static const FuncaoBusca funcoes[] = {mochilaBuscar, mochilaBuscarSequencial, mochilaBuscarBinaria};
+    static const char* nomes[] = {"Busca hash", "Busca sequencial", "Busca binaria"};
+
+    Mochila mochila;
+    if (!mochilaIniciar(&mochila, n)) {
+        fprintf(stderr, "[ERRO] Sem memoria para a mochila de %d itens\n", n);
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        mochilaInserir(&mochila, itens[i]);
+    }
+
+    for (int f = 0; f < 3; f++) {
+        if (funcoes[f] == mochilaBuscarBinaria) {
+            mochilaOrdenar(&mochila, NOME, MERGE_SORT, NULL);
+        }
+        Consultas consultas = {itens, n, funcoes[f] == mochilaBuscarSequencial ? consultasLineares(n) : CONSULTAS};
+        Estatisticas estatisticas;
+        int falhas = 0;
+
+        estatisticasZerar(&estatisticas);
+        double inicio = agoraNs();
+        for (int i = 0; i < consultas.quantidade; i++) {
+            if (funcoes[f](&mochila, nomeConsulta(&consultas, i), &estatisticas) < 0) {
+                falhas++;
+            }
+        }
+        double decorrido = agoraNs() - inicio;
+        registrarBusca(saida, distribuicao, n, nomes[f], &estatisticas, falhas, decorrido,
+                       consultas.quantidade);
+    }
+
+    mochilaLiberar(&mochila);
+}
+
+/*
+ * Funcao: medirBuscasListas
+ * Busca sequencial na lista encadeada e na lista desenrolada.
+ */
+static void medirBuscasListas(FILE* saida, Distribuicao distribuicao, const Item* itens, int n) {
+    Consultas consultas = {itens, n, consultasLineares(n)};
+    Estatisticas estatisticas;
+    int falhas = 0;
+
+    estatisticasZerar(&estatisticas);
+
+    Lista lista;
+    listaIniciar(&lista);
+    for (int i = 0; i < n; i++) {
+        listaInserir(&lista, itens[i]);
+    }
+    double inicio = agoraNs();
+    for (int i = 0; i < consultas.quantidade; i++) {
+        if (listaBuscar(&lista, nomeConsulta(&consultas, i), &estatisticas) == NULL) {
+            falhas++;
+        }
+    }
+    registrarBusca(saida, distribuicao, n, "Busca na lista", &estatisticas, falhas, agoraNs() - inicio,
+                   consultas.quantidade);
+    listaLiberar(&lista);
+
+    estatisticasZerar(&estatisticas);
+    falhas = 0;
+    ListaDesenrolada desenrolada;
+    desenroladaIniciar(&desenrolada);
+    for (int i = 0; i < n; i++) {
+        desenroladaInserir(&desenrolada, itens[i]);
+    }
+    inicio = agoraNs();
+    for (int i = 0; i < consultas.quantidade; i++) {
+        if (desenroladaBuscar(&desenrolada, nomeConsulta(&consultas, i), &estatisticas) == NULL) {
+            falhas++;
+        }
+    }
+    registrarBusca(saida, distribuicao, n, "Busca na lista desenrolada", &estatisticas, falhas,
+                   agoraNs() - inicio, consultas.quantidade);
+    desenroladaLiberar(&desenrolada);
+}
+
+// ============================================================================
+// PROGRAMA PRINCIPAL
+// ============================================================================
+
+int main(int argc, char* argv[]) {
+    long nMax = argc > 1 ? atol(argv[1]) : N_MAX_PADRAO;
+    if (nMax < 10 || nMax > N_MAX_LIMITE) {
+        fprintf(stderr, "Uso: %s [n_max entre 10 e %d] [arquivo.csv]\n", argv[0], N_MAX_LIMITE);
+        return 1;
+    }
+
+    FILE* saida = stdout;
+    if (argc > 2) {
+        saida = fopen(argv[2], "w");
+        if (saida == NULL) {
+            fprintf(stderr, "[ERRO] Nao foi possivel criar %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    Item* itens = (Item*)malloc(sizeof(Item) * (size_t)nMax);
+    if (itens == NULL) {
+        fprintf(stderr, "[ERRO] Sem memoria para %ld itens\n", nMax);
+        if (saida != stdout) {
+            fclose(saida);
+        }
+        return 1;
+    }
+
+    unsigned short idTipo = tipoRegistrar("ferramenta");
+    fprintf(saida, "distribuicao,n,algoritmo,comparacoes,trocas,movimentos,bytes_movidos,ns_por_op,threads,speedup\n");
+
+    for (int d = UNIFORME; d <= DUPLICADAS; d++) {
+        for (long n = 10; n <= nMax; n *= 10) {
+            gerarInventario(itens, (int)n, (Distribuicao)d, idTipo);
+            medirOrdenacoes(saida, (Distribuicao)d, itens, (int)n);
+            medirBuscasMochila(saida, (Distribuicao)d, itens, (int)n);
+            medirBuscasListas(saida, (Distribuicao)d, itens, (int)n);
+            fflush(saida);
+        }
+    }
+
+    free(itens);
+    tiposLiberar();
+    if (saida != stdout) {
+        fclose(saida);
+    }
+    return 0;
+}
@@ -0,0 +1,33 @@
+/*
+ * ENTRADA - FUNCOES AUXILIARES DE TERMINAL
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "entrada.h"
+
+/*
+ * Funcao: limparBuffer
+ * Limpa o buffer de entrada para evitar problemas com leitura de strings
+ */
+void limparBuffer(void) {
+    int c;
+    while ((c = getchar()) != '\n' && c != EOF);
+}
+
+/*
+ * Funcao: lerTexto
+ * Le uma linha com fgets e remove o '\n' do final.
+ *
+ * Parametros:
+ *   - destino: buffer que recebe o texto
+ *   - tamanho: tamanho do buffer (incluindo o '\0')
+ */
+void lerTexto(char* destino, int tamanho) {
+    if (fgets(destino, tamanho, stdin) == NULL) {
+        destino[0] = '\0';
+        return;
+    }
+    destino[strcspn(destino, "\n")] = '\0';
+}
@@ -0,0 +1,14 @@
+/*
+ * ENTRADA - FUNCOES AUXILIARES DE TERMINAL
+ *
+ * Leitura de teclado compartilhada pelos programas de menu.
+ * Fica fora da libmochila, que nao faz nenhuma entrada/saida.
+ */
+
+#ifndef ENTRADA_H
+#define ENTRADA_H
+
+void limparBuffer(void);
+void lerTexto(char* destino, int tamanho);
+
+#endif
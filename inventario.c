@@ -9,74 +9,51 @@
 #include <string.h>
 #include <stdlib.h>
 
-// Definição de constantes
-#define MAX_ITENS 10
-#define TAM_NOME 30
-#define TAM_TIPO 20
+#include "mochila.h"
+#include "latencia.h"
+#include "entrada.h"
 
-/*
- * Struct Item
- * Representa um item do inventário com suas propriedades essenciais.
- *
- * Campos:
- *   - nome: identificador do item (ex: "AK-47", "Kit Médico")
- *   - tipo: categoria do item (arma, munição, cura, ferramenta)
- *   - quantidade: número de unidades deste item na mochila
- */
-typedef struct {
-    char nome[TAM_NOME];
-    char tipo[TAM_TIPO];
-    int quantidade;
-} Item;
+// Definição de constantes
+#define CAPACIDADE_INICIAL 10   // Espaço reservado de início; a mochila cresce sozinha
 
-// Vetor global de itens (inventário) e contador de itens ativos
-Item inventario[MAX_ITENS];
-int totalItens = 0;
-
-/*
- * Função: limparBuffer
- * Limpa o buffer do teclado para evitar problemas com leitura de strings
- */
-void limparBuffer() {
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF);
-}
+// Inventário global: o vetor de itens e o contador ficam na libmochila
+// (a struct Item, com nome, tipo e quantidade, é definida em mochila.h)
+Mochila inventario;
 
 /*
  * Função: inserirItem
  * Adiciona um novo item ao inventário do jogador.
  *
  * Funcionamento:
- *   1. Verifica se há espaço disponível (máximo 10 itens)
- *   2. Solicita os dados do item ao usuário
- *   3. Armazena o item no próximo espaço livre do vetor
- *   4. Incrementa o contador de itens
+ *   1. Solicita os dados do item ao usuário
+ *   2. Armazena o item no próximo espaço livre do vetor
+ *      (se o vetor estiver cheio, a libmochila aumenta sua capacidade)
+ *   3. Incrementa o contador de itens
  *
- * Complexidade: O(1) - inserção no final do vetor
+ * Complexidade: O(1) amortizado - inserção no final do vetor
  */
 void inserirItem() {
-    // Validação: verifica se o inventário está cheio
-    if (totalItens >= MAX_ITENS) {
-        printf("\n❌ Mochila cheia! Capacidade máxima atingida (%d itens).\n", MAX_ITENS);
-        return;
-    }
-
     printf("\n┌─────────────────────────────────────┐\n");
     printf("│   CADASTRAR NOVO ITEM NO INVENTÁRIO   │\n");
     printf("└───────────────────────────────────────┘\n");
 
     Item novoItem;
+    char tipo[TAM_TIPO];
+    novoItem.prioridade = 0; // Nível novato não usa prioridade
 
     // Leitura do nome do item
     printf("Digite o nome do item: ");
     limparBuffer();
-    fgets(novoItem.nome, TAM_NOME, stdin);
-    novoItem.nome[strcspn(novoItem.nome, "\n")] = '\0'; // Remove o '\n' do final
+    lerTexto(novoItem.nome, TAM_NOME); // Remove o '\n' do final
 
     // Leitura do tipo do item
     printf("Digite o tipo (arma/munição/cura/ferramenta): ");
-    fgets(novoItem.tipo, TAM_TIPO, stdin);
-    novoItem.tipo[strcspn(novoItem.tipo, "\n")] = '\0';
+    lerTexto(tipo, TAM_TIPO);
+    novoItem.idTipo = tipoRegistrar(tipo); // O item guarda só o id do tipo
+    if (novoItem.idTipo == TIPO_INVALIDO) {
+        printf(" Não foi possível registrar o tipo '%s'.\n", tipo);
+        return;
+    }
 
     // Leitura da quantidade
     printf("Digite a quantidade: ");
@@ -88,9 +65,11 @@ void inserirItem() {
         return;
     }
 
-    // Armazena o item no vetor de inventário
-    inventario[totalItens] = novoItem;
-    totalItens++;
+    // Armazena o item no vetor de inventário (que cresce se necessário)
+    if (!mochilaInserir(&inventario, novoItem)) {
+        printf("\n❌ Erro ao alocar memória para o item!\n");
+        return;
+    }
 
     printf("\n Item '%s' cadastrado com sucesso!\n", novoItem.nome);
 }
@@ -100,14 +79,14 @@ void inserirItem() {
  * Remove um item específico do inventário usando seu nome.
  *
  * Funcionamento:
- *   1. Busca o item pelo nome usando busca sequencial
- *   2. Se encontrado, move todos os itens posteriores uma posição para trás
+ *   1. Localiza o item pelo nome no índice hash
+ *   2. Se encontrado, o último item ocupa a posição liberada
  *   3. Decrementa o contador de itens
  *
- * Complexidade: O(n) - busca + reorganização do vetor
+ * Complexidade: O(1) em média
  */
 void removerItem() {
-    if (totalItens == 0) {
+    if (mochilaTotal(&inventario) == 0) {
         printf("\n Inventário vazio! Não há itens para remover.\n");
         return;
     }
@@ -118,40 +97,37 @@ void removerItem() {
     printf("└─────────────────────────────────────┘\n");
     printf("Digite o nome do item a remover: ");
     limparBuffer();
-    fgets(nomeBusca, TAM_NOME, stdin);
-    nomeBusca[strcspn(nomeBusca, "\n")] = '\0';
-
-    // Busca sequencial pelo item
-    int encontrado = -1;
-    for (int i = 0; i < totalItens; i++) {
-        if (strcmp(inventario[i].nome, nomeBusca) == 0) {
-            encontrado = i;
-            break;
-        }
-    }
+    lerTexto(nomeBusca, TAM_NOME);
 
-    // Se o item não foi encontrado
-    if (encontrado == -1) {
+    // A biblioteca localiza o item pelo índice hash e preenche a posição
+    // com o último item, mantendo o vetor sem "buracos" (compactado)
+    if (!mochilaRemover(&inventario, nomeBusca)) {
         printf(" Item '%s' não encontrado no inventário.\n", nomeBusca);
         return;
     }
 
-    // Remove o item movendo todos os posteriores uma posição para trás
-    // Isso mantém o vetor sem "buracos" (compactado)
-    for (int i = encontrado; i < totalItens - 1; i++) {
-        inventario[i] = inventario[i + 1];
-    }
-
-    totalItens--;
     printf(" Item '%s' removido com sucesso!\n", nomeBusca);
 }
 
+/*
+ * Função: imprimirLinhaItem
+ * Imprime uma linha da tabela do inventário (chamada por mochilaPercorrer).
+ */
+void imprimirLinhaItem(const Item* item, int posicao, void* contexto) {
+    (void)contexto;
+    printf("│ %2d │ %-20s │ %-16s │ %10d │\n",
+           posicao + 1,
+           item->nome,
+           tipoNome(item->idTipo),
+           item->quantidade);
+}
+
 /*
  * Função: listarItens
  * Exibe todos os itens atualmente armazenados no inventário.
  *
  * Funcionamento:
- *   - Percorre o vetor de itens de 0 até totalItens-1
+ *   - Percorre os itens do inventário com mochilaPercorrer
  *   - Formata e exibe as informações de cada item
  *
  * Complexidade: O(n) - percorre todos os itens
@@ -161,24 +137,18 @@ void listarItens() {
     printf("║                    INVENTÁRIO ATUAL                          ║\n");
     printf("╚══════════════════════════════════════════════════════════════╝\n");
 
-    if (totalItens == 0) {
+    if (mochilaTotal(&inventario) == 0) {
         printf("   Inventário vazio. Colete itens para começar!\n");
         return;
     }
 
-    printf("  Total de itens: %d/%d\n\n", totalItens, MAX_ITENS);
+    printf("  Total de itens: %d\n\n", mochilaTotal(&inventario));
     printf("┌────┬──────────────────────┬──────────────────┬────────────┐\n");
     printf("│ Nº │ Nome                 │ Tipo             │ Quantidade │\n");
     printf("├────┼──────────────────────┼──────────────────┼────────────┤\n");
 
     // Percorre e exibe cada item do inventário
-    for (int i = 0; i < totalItens; i++) {
-        printf("│ %2d │ %-20s │ %-16s │ %10d │\n",
-               i + 1,
-               inventario[i].nome,
-               inventario[i].tipo,
-               inventario[i].quantidade);
-    }
+    mochilaPercorrer(&inventario, imprimirLinhaItem, NULL);
 
     printf("└────┴──────────────────────┴──────────────────┴────────────┘\n");
 }
@@ -189,15 +159,13 @@ void listarItens() {
  *
  * Funcionamento:
  *   1. Solicita o nome do item a buscar
- *   2. Percorre o vetor comparando cada nome
+ *   2. Consulta o índice hash do nome mantido pela libmochila
  *   3. Se encontrado, exibe os dados completos do item
  *
- * Complexidade: O(n) - busca linear no pior caso
- * Nota: Para grandes volumes, uma busca binária seria mais eficiente (O(log n)),
- *       mas exigiria que o vetor estivesse ordenado.
+ * Complexidade: O(1) em média - não percorre o vetor
  */
 void buscarItem() {
-    if (totalItens == 0) {
+    if (mochilaTotal(&inventario) == 0) {
         printf("\n Inventário vazio! Não há itens para buscar.\n");
         return;
     }
@@ -208,26 +176,20 @@ void buscarItem() {
     printf("└─────────────────────────────────────┘\n");
     printf("Digite o nome do item: ");
     limparBuffer();
-    fgets(nomeBusca, TAM_NOME, stdin);
-    nomeBusca[strcspn(nomeBusca, "\n")] = '\0';
-
-    // Busca sequencial
-    int encontrado = -1;
-    for (int i = 0; i < totalItens; i++) {
-        if (strcmp(inventario[i].nome, nomeBusca) == 0) {
-            encontrado = i;
-            break;
-        }
-    }
+    lerTexto(nomeBusca, TAM_NOME);
+
+    // Busca pelo índice hash do nome
+    int encontrado = mochilaBuscar(&inventario, nomeBusca, NULL);
 
     if (encontrado == -1) {
         printf("\n Item '%s' não encontrado no inventário.\n", nomeBusca);
     } else {
+        const Item* item = mochilaItem(&inventario, encontrado);
         printf("\n Item encontrado!\n");
         printf("┌─────────────────────────────────────┐\n");
-        printf("│ Nome:       %-23s │\n", inventario[encontrado].nome);
-        printf("│ Tipo:       %-23s │\n", inventario[encontrado].tipo);
-        printf("│ Quantidade: %-23d │\n", inventario[encontrado].quantidade);
+        printf("│ Nome:       %-23s │\n", item->nome);
+        printf("│ Tipo:       %-23s │\n", tipoNome(item->idTipo));
+        printf("│ Quantidade: %-23d │\n", item->quantidade);
         printf("└─────────────────────────────────────┘\n");
     }
 }
@@ -264,6 +226,11 @@ void exibirMenu() {
 int main() {
     int opcao;
 
+    if (!mochilaIniciar(&inventario, CAPACIDADE_INICIAL)) {
+        printf("\n Erro ao alocar o inventário!\n");
+        return 1;
+    }
+
     // Mensagem de boas-vindas
     printf("\n");
     printf("════════════════════════════════════════════════════════════\n");
@@ -297,6 +264,9 @@ int main() {
 
             case 5:
                 printf("\n Encerrando sistema... Boa sorte no campo de batalha!\n\n");
+                latenciaSalvarSeConfigurado();  // MOCHILA_LATENCIAS=arquivo.csv
+                mochilaLiberar(&inventario);
+                tiposLiberar();
                 return 0;
 
             default:
@@ -0,0 +1,113 @@
+/*
+ * LIBMOCHILA - AGREGADOS POR GRUPO
+ *
+ * Implementacao da tabela de contadores por chave.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "agregados.h"
+
+#define CAPACIDADE_MINIMA 16
+
+/*
+ * Funcao: chaveValida
+ * Chaves negativas ou a partir de LIMITE_CHAVE_AGREGADA nao sao agrupadas.
+ */
+static int chaveValida(int chave) {
+    return chave >= 0 && chave < LIMITE_CHAVE_AGREGADA;
+}
+
+/*
+ * Funcao: agregadosIniciar
+ * Cria a tabela vazia (sem alocar).
+ */
+void agregadosIniciar(TabelaAgregados* tabela) {
+    tabela->grupos = NULL;
+    tabela->capacidade = 0;
+}
+
+/*
+ * Funcao: agregadosLiberar
+ * Libera a tabela e zera os contadores.
+ */
+void agregadosLiberar(TabelaAgregados* tabela) {
+    free(tabela->grupos);
+    agregadosIniciar(tabela);
+}
+
+/*
+ * Funcao: agregadosReservar
+ * Garante que a chave tem um contador alocado (novos contadores comecam
+ * zerados). Chamada antes de alterar a mochila, para que
+ * agregadosAdicionar nunca precise alocar.
+ *
+ * Retorno: 1 se sucesso (ou chave fora da faixa agrupada), 0 se faltou memoria
+ */
+int agregadosReservar(TabelaAgregados* tabela, int chave) {
+    if (!chaveValida(chave) || chave < tabela->capacidade) {
+        return 1;
+    }
+
+    int nova = tabela->capacidade > 0 ? tabela->capacidade : CAPACIDADE_MINIMA;
+    while (nova <= chave) {
+        nova *= 2;
+    }
+    if (nova > LIMITE_CHAVE_AGREGADA) {
+        nova = LIMITE_CHAVE_AGREGADA;
+    }
+
+    Agregado* grupos = (Agregado*)realloc(tabela->grupos, sizeof(Agregado) * (size_t)nova);
+    if (grupos == NULL) {
+        return 0;
+    }
+    memset(&grupos[tabela->capacidade], 0, sizeof(Agregado) * (size_t)(nova - tabela->capacidade));
+
+    tabela->grupos = grupos;
+    tabela->capacidade = nova;
+    return 1;
+}
+
+/*
+ * Funcao: agregadosAdicionar
+ * Conta um item da chave (a chave deve ter sido reservada antes).
+ *
+ * Complexidade: O(1)
+ */
+void agregadosAdicionar(TabelaAgregados* tabela, int chave, int quantidade) {
+    if (!chaveValida(chave) || chave >= tabela->capacidade) {
+        return;
+    }
+    tabela->grupos[chave].itens++;
+    tabela->grupos[chave].quantidade += quantidade;
+}
+
+/*
+ * Funcao: agregadosRetirar
+ * Desconta um item da chave.
+ *
+ * Complexidade: O(1)
+ */
+void agregadosRetirar(TabelaAgregados* tabela, int chave, int quantidade) {
+    if (!chaveValida(chave) || chave >= tabela->capacidade) {
+        return;
+    }
+    tabela->grupos[chave].itens--;
+    tabela->grupos[chave].quantidade -= quantidade;
+}
+
+/*
+ * Funcao: agregadosConsultar
+ * Agregado da chave (zerado se nenhum item foi contado nela).
+ *
+ * Complexidade: O(1)
+ */
+Agregado agregadosConsultar(const TabelaAgregados* tabela, int chave) {
+    Agregado vazio = {0, 0};
+
+    if (!chaveValida(chave) || chave >= tabela->capacidade) {
+        return vazio;
+    }
+    return tabela->grupos[chave];
+}
@@ -0,0 +1,48 @@
+/*
+ * LIBMOCHILA - AGREGADOS POR GRUPO
+ *
+ * Descricao: Contadores de itens e soma das quantidades por grupo (id de
+ * tipo ou prioridade), mantidos pela Mochila a cada insercao e remocao.
+ * Perguntas como "total de municao" ou "quantos itens de prioridade 5"
+ * sao respondidas em O(1), sem percorrer o inventario.
+ */
+
+#ifndef AGREGADOS_H
+#define AGREGADOS_H
+
+#define LIMITE_CHAVE_AGREGADA 65536  // Chaves agrupadas: 0 a LIMITE - 1
+
+/*
+ * Struct: Agregado
+ *
+ * Campos:
+ *   - itens: quantidade de itens do grupo
+ *   - quantidade: soma do campo quantidade desses itens
+ */
+typedef struct {
+    int itens;
+    long long quantidade;
+} Agregado;
+
+/*
+ * Struct: TabelaAgregados
+ * Um Agregado por chave, em vetor indexado pela propria chave (ids de
+ * tipo e prioridades sao inteiros pequenos). Cresce sob demanda.
+ *
+ * Campos:
+ *   - grupos: agregado de cada chave em [0, capacidade)
+ *   - capacidade: chaves alocadas
+ */
+typedef struct {
+    Agregado* grupos;
+    int capacidade;
+} TabelaAgregados;
+
+void agregadosIniciar(TabelaAgregados* tabela);
+void agregadosLiberar(TabelaAgregados* tabela);
+int agregadosReservar(TabelaAgregados* tabela, int chave);
+void agregadosAdicionar(TabelaAgregados* tabela, int chave, int quantidade);
+void agregadosRetirar(TabelaAgregados* tabela, int chave, int quantidade);
+Agregado agregadosConsultar(const TabelaAgregados* tabela, int chave);
+
+#endif
@@ -0,0 +1,235 @@
+/*
+ * LIBMOCHILA - CRONOMETRO
+ *
+ * Implementacao do relogio monotono, do contador de ciclos e das
+ * medicoes repetidas.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cronometro.h"
+#include "latencia.h"
+
+#define LEITURAS_SOBRECARGA 64
+
+// ============================================================================
+// RELOGIOS
+// ============================================================================
+
+/*
+ * Funcao: cronometroNs
+ * Tempo monotono em nanossegundos (origem arbitraria; so diferencas
+ * entre duas leituras tem significado).
+ */
+uint64_t cronometroNs(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+/*
+ * Funcao: cronometroCiclos
+ * Contador de ciclos do processador: TSC no x86, contador virtual no
+ * ARM64. Retorna 0 nas demais arquiteturas ou com SEM_CONTADOR_CICLOS.
+ */
+uint64_t cronometroCiclos(void) {
+#if !CRONOMETRO_TEM_CICLOS
+    return 0;
+#elif defined(__aarch64__)
+    uint64_t valor;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(valor));
+    return valor;
+#else
+    return (uint64_t)__builtin_ia32_rdtsc();
+#endif
+}
+
+/*
+ * Funcao: cronometroTemCiclos
+ * Retorno: true se cronometroCiclos le um contador de verdade
+ */
+bool cronometroTemCiclos(void) {
+    return CRONOMETRO_TEM_CICLOS;
+}
+
+/*
+ * Funcao: sobrecarga
+ * Menor custo observado de duas leituras seguidas de cada relogio. E
+ * descontado das amostras: sem isso, uma busca de 30 ns apareceria com
+ * o custo do proprio clock_gettime somado.
+ */
+static void sobrecarga(uint64_t* ns, uint64_t* ciclos) {
+    static bool calculada = false;
+    static uint64_t sobrecargaNs = 0;
+    static uint64_t sobrecargaCiclos = 0;
+
+    if (!calculada) {
+        sobrecargaNs = UINT64_MAX;
+        sobrecargaCiclos = UINT64_MAX;
+        for (int i = 0; i < LEITURAS_SOBRECARGA; i++) {
+            uint64_t c0 = cronometroCiclos();
+            uint64_t t0 = cronometroNs();
+            uint64_t t1 = cronometroNs();
+            uint64_t c1 = cronometroCiclos();
+            if (t1 - t0 < sobrecargaNs) {
+                sobrecargaNs = t1 - t0;
+            }
+            if (c1 - c0 < sobrecargaCiclos) {
+                sobrecargaCiclos = c1 - c0;
+            }
+        }
+        calculada = true;
+    }
+    *ns = sobrecargaNs;
+    *ciclos = sobrecargaCiclos;
+}
+
+// ============================================================================
+// MEDICAO REPETIDA
+// ============================================================================
+
+static int compararAmostras(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t descontar(uint64_t amostra, uint64_t custo) {
+    return amostra > custo ? amostra - custo : 0;
+}
+
+/*
+ * Funcao: cronometroMedir
+ * Executa a operacao ate 'repeticoes' vezes e resume os tempos.
+ *
+ * Complexidade: O(r log r) alem das proprias execucoes (r = repeticoes)
+ *
+ * Parametros:
+ *   - preparar: chamada antes de cada execucao, fora do tempo medido
+ *               (restaurar a entrada de uma ordenacao, por exemplo); pode
+ *               ser NULL
+ *   - operacao: a operacao medida
+ *   - contexto: repassado as duas funcoes
+ *   - medicao: recebe minimo, mediana e p99
+ *
+ * As repeticoes nao entram nos histogramas de latencia (latencia.h).
+ *
+ * Retorno: 1 se sucesso, 0 se faltou memoria para as amostras
+ */
+int cronometroMedir(void (*preparar)(void* contexto), void (*operacao)(void* contexto), void* contexto,
+                    int repeticoes, Medicao* medicao) {
+    memset(medicao, 0, sizeof(Medicao));
+    if (repeticoes < 1) {
+        repeticoes = 1;
+    }
+
+    uint64_t* amostrasNs = (uint64_t*)malloc(sizeof(uint64_t) * (size_t)repeticoes * 2);
+    if (amostrasNs == NULL) {
+        return 0;
+    }
+    uint64_t* amostrasCiclos = amostrasNs + repeticoes;
+
+    uint64_t custoNs, custoCiclos;
+    sobrecarga(&custoNs, &custoCiclos);
+
+    uint64_t acumulado = 0;
+    int coletadas = 0;
+    latenciaSuspender(true);
+    while (coletadas < repeticoes && acumulado < LIMITE_MEDICAO_NS) {
+        if (preparar != NULL) {
+            preparar(contexto);
+        }
+        uint64_t c0 = cronometroCiclos();
+        uint64_t t0 = cronometroNs();
+        operacao(contexto);
+        uint64_t t1 = cronometroNs();
+        uint64_t c1 = cronometroCiclos();
+
+        amostrasNs[coletadas] = descontar(t1 - t0, custoNs);
+        amostrasCiclos[coletadas] = descontar(c1 - c0, custoCiclos);
+        acumulado += t1 - t0;
+        coletadas++;
+    }
+    latenciaSuspender(false);
+
+    qsort(amostrasNs, (size_t)coletadas, sizeof(uint64_t), compararAmostras);
+    qsort(amostrasCiclos, (size_t)coletadas, sizeof(uint64_t), compararAmostras);
+
+    medicao->repeticoes = coletadas;
+    medicao->minimoNs = amostrasNs[0];
+    medicao->medianaNs = amostrasNs[coletadas / 2];
+    medicao->p99Ns = amostrasNs[(int)(((long)coletadas * 99) / 100)];
+    medicao->medianaCiclos = amostrasCiclos[coletadas / 2];
+
+    free(amostrasNs);
+    return 1;
+}
+
+// ============================================================================
+// MEDICAO DE ORDENACAO
+// ============================================================================
+
+/*
+ * Struct: EnsaioOrdenacao
+ * Contexto das repeticoes de cronometroMedirOrdenacao: cada execucao
+ * ordena uma copia nova da entrada.
+ */
+typedef struct {
+    const Item* itens;
+    Item* copia;
+    int* ordem;
+    int n;
+    CriterioOrdenacao criterio;
+    AlgoritmoOrdenacao algoritmo;
+} EnsaioOrdenacao;
+
+static void restaurarEntrada(void* contexto) {
+    EnsaioOrdenacao* ensaio = (EnsaioOrdenacao*)contexto;
+    if (ensaio->ordem != NULL) {
+        preencherIndices(ensaio->ordem, ensaio->n);
+    } else {
+        memcpy(ensaio->copia, ensaio->itens, sizeof(Item) * (size_t)ensaio->n);
+    }
+}
+
+static void executarOrdenacao(void* contexto) {
+    EnsaioOrdenacao* ensaio = (EnsaioOrdenacao*)contexto;
+    if (ensaio->ordem != NULL) {
+        ordenarIndices(ensaio->itens, ensaio->ordem, ensaio->n, ensaio->criterio, ensaio->algoritmo, NULL);
+    } else {
+        ordenarItens(ensaio->copia, ensaio->n, ensaio->criterio, ensaio->algoritmo, NULL);
+    }
+}
+
+/*
+ * Funcao: cronometroMedirOrdenacao
+ * Mede a ordenacao dos itens sem altera-los: cada repeticao ordena uma
+ * copia (ou, com porIndices, um vetor de indices, como
+ * mochilaOrdenarPorIndices), restaurada fora do tempo medido.
+ *
+ * Retorno: 1 se sucesso, 0 se faltou memoria
+ */
+int cronometroMedirOrdenacao(const Item* itens, int n, CriterioOrdenacao criterio,
+                             AlgoritmoOrdenacao algoritmo, bool porIndices, int repeticoes,
+                             Medicao* medicao) {
+    EnsaioOrdenacao ensaio = {itens, NULL, NULL, n, criterio, algoritmo};
+    size_t elementos = (size_t)(n > 0 ? n : 1);
+
+    if (porIndices) {
+        ensaio.ordem = (int*)malloc(sizeof(int) * elementos);
+    } else {
+        ensaio.copia = (Item*)malloc(sizeof(Item) * elementos);
+    }
+    if (ensaio.ordem == NULL && ensaio.copia == NULL) {
+        return 0;
+    }
+
+    int resultado = cronometroMedir(restaurarEntrada, executarOrdenacao, &ensaio, repeticoes, medicao);
+    free(ensaio.ordem);
+    free(ensaio.copia);
+    return resultado;
+}
@@ -0,0 +1,63 @@
+/*
+ * LIBMOCHILA - CRONOMETRO
+ *
+ * Descricao: Medicao de tempo para analise de desempenho. Usa um relogio
+ * monotono em nanossegundos (clock() mede tempo de CPU com resolucao de
+ * milissegundos e devolvia 0.0000 ms para uma busca em 100 itens) e,
+ * onde existir, o contador de ciclos do processador.
+ *
+ * Uma unica execucao de uma operacao de nanossegundos e so ruido: a
+ * medicao repete a operacao varias vezes e resume as amostras em minimo,
+ * mediana e percentil 99. O custo de ler o relogio e descontado de cada
+ * amostra.
+ *
+ * Compilar com -DSEM_CONTADOR_CICLOS desliga a leitura de ciclos.
+ */
+
+#ifndef CRONOMETRO_H
+#define CRONOMETRO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "ordenacao.h"
+
+#define LIMITE_MEDICAO_NS 2000000000ULL  // Repeticoes param ao somar 2 s
+
+// 1 onde cronometroCiclos le um contador de verdade
+#if !defined(SEM_CONTADOR_CICLOS) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__))
+#define CRONOMETRO_TEM_CICLOS 1
+#else
+#define CRONOMETRO_TEM_CICLOS 0
+#endif
+
+/*
+ * Struct: Medicao
+ * Resumo das repeticoes de uma operacao.
+ *
+ * Campos:
+ *   - repeticoes: amostras coletadas (pode ser menor que o pedido se a
+ *                 soma passar de LIMITE_MEDICAO_NS)
+ *   - minimoNs / medianaNs / p99Ns: tempo por execucao, em nanossegundos
+ *   - medianaCiclos: ciclos por execucao (0 sem contador de ciclos)
+ */
+typedef struct {
+    int repeticoes;
+    uint64_t minimoNs;
+    uint64_t medianaNs;
+    uint64_t p99Ns;
+    uint64_t medianaCiclos;
+} Medicao;
+
+uint64_t cronometroNs(void);
+uint64_t cronometroCiclos(void);
+bool cronometroTemCiclos(void);
+
+int cronometroMedir(void (*preparar)(void* contexto), void (*operacao)(void* contexto), void* contexto,
+                    int repeticoes, Medicao* medicao);
+int cronometroMedirOrdenacao(const Item* itens, int n, CriterioOrdenacao criterio,
+                             AlgoritmoOrdenacao algoritmo, bool porIndices, int repeticoes,
+                             Medicao* medicao);
+
+#endif
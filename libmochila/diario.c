@@ -0,0 +1,430 @@
+/*
+ * LIBMOCHILA - DIARIO DE OPERACOES
+ *
+ * Implementacao do acrescimo com group commit e da reaplicacao.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "diario.h"
+#include "latencia.h"
+
+#define REGISTROS_POR_LEITURA 256    // Registros lidos por chamada ao reaplicar
+
+// ============================================================================
+// CRC-32
+// ============================================================================
+
+/*
+ * Funcao: crc32Bytes
+ * CRC-32 (polinomio 0xEDB88320, o do zlib e do PNG), com a tabela de 256
+ * entradas montada na primeira chamada.
+ */
+static uint32_t crc32Bytes(const void* dados, size_t tamanho) {
+    static uint32_t tabela[256];
+    static int montada = 0;
+
+    if (!montada) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t valor = i;
+            for (int bit = 0; bit < 8; bit++) {
+                valor = (valor & 1) ? (valor >> 1) ^ 0xEDB88320u : valor >> 1;
+            }
+            tabela[i] = valor;
+        }
+        montada = 1;
+    }
+
+    const unsigned char* bytes = (const unsigned char*)dados;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < tamanho; i++) {
+        crc = tabela[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+static uint32_t crcRegistro(const RegistroDiario* registro) {
+    return crc32Bytes((const unsigned char*)registro + sizeof(uint32_t), sizeof(RegistroDiario) - sizeof(uint32_t));
+}
+
+// ============================================================================
+// ARQUIVO
+// ============================================================================
+
+/*
+ * Funcao: escreverTudo
+ * write ate gravar todos os bytes (write pode gravar so uma parte).
+ */
+static int escreverTudo(int descritor, const void* dados, size_t tamanho) {
+    const char* p = (const char*)dados;
+
+    while (tamanho > 0) {
+        ssize_t gravados = write(descritor, p, tamanho);
+        if (gravados < 0 && errno == EINTR) {
+            continue;
+        }
+        if (gravados <= 0) {
+            return 0;
+        }
+        p += gravados;
+        tamanho -= (size_t)gravados;
+    }
+    return 1;
+}
+
+/*
+ * Funcao: lerTudo
+ * read ate encher o buffer ou chegar ao fim do arquivo.
+ *
+ * Retorno: bytes lidos, -1 em erro de leitura
+ */
+static long lerTudo(int descritor, void* dados, size_t tamanho) {
+    char* p = (char*)dados;
+    size_t lidos = 0;
+
+    while (lidos < tamanho) {
+        ssize_t parte = read(descritor, p + lidos, tamanho - lidos);
+        if (parte < 0 && errno == EINTR) {
+            continue;
+        }
+        if (parte < 0) {
+            return -1;
+        }
+        if (parte == 0) {
+            break;
+        }
+        lidos += (size_t)parte;
+    }
+    return (long)lidos;
+}
+
+/*
+ * Funcao: fimRegistros
+ * Posicao logo apos o ultimo registro valido.
+ */
+static off_t fimRegistros(const Diario* diario) {
+    return (off_t)sizeof(CabecalhoDiario) + (off_t)diario->registros * (off_t)sizeof(RegistroDiario);
+}
+
+// ============================================================================
+// REAPLICACAO
+// ============================================================================
+
+/*
+ * Funcao: registroValido
+ * CRC e campos do registro conferem.
+ */
+static int registroValido(const RegistroDiario* registro) {
+    if (registro->crc != crcRegistro(registro)) {
+        return 0;
+    }
+    switch (registro->operacao) {
+        case DIARIO_INSERIR:
+        case DIARIO_REMOVER:
+        case DIARIO_QUANTIDADE:
+            return 1;
+        case DIARIO_ORDENAR:
+            return registro->criterio >= 0 && registro->criterio < TOTAL_CRITERIOS && registro->algoritmo >= 0 &&
+                   registro->algoritmo <= MERGE_SORT_PARALELO;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * Funcao: aplicarRegistro
+ * Refaz a operacao na mochila. As operacoes sao deterministicas: a
+ * partir do mesmo snapshot, a mesma sequencia leva a mesma mochila
+ * (inclusive na ordem dos itens).
+ *
+ * Retorno: 1 se sucesso, 0 se faltou memoria
+ */
+static int aplicarRegistro(Mochila* mochila, const RegistroDiario* registro) {
+    char nome[TAM_NOME];
+    memcpy(nome, registro->nome, TAM_NOME);
+    nome[TAM_NOME - 1] = '\0';
+
+    switch (registro->operacao) {
+        case DIARIO_INSERIR: {
+            char tipo[TAM_TIPO];
+            memcpy(tipo, registro->tipo, TAM_TIPO);
+            tipo[TAM_TIPO - 1] = '\0';
+
+            Item item;
+            memset(&item, 0, sizeof(Item));
+            memcpy(item.nome, nome, TAM_NOME);
+            item.idTipo = tipoRegistrar(tipo);
+            item.quantidade = registro->quantidade;
+            item.prioridade = registro->prioridade;
+            return item.idTipo != TIPO_INVALIDO && mochilaInserir(mochila, item);
+        }
+        case DIARIO_REMOVER:
+            mochilaRemover(mochila, nome);
+            return 1;
+        case DIARIO_QUANTIDADE:
+            mochilaAlterarQuantidade(mochila, nome, registro->quantidade);
+            return 1;
+        default:
+            mochilaOrdenar(mochila, (CriterioOrdenacao)registro->criterio, (AlgoritmoOrdenacao)registro->algoritmo,
+                           NULL);
+            return 1;
+    }
+}
+
+/*
+ * Funcao: reaplicar
+ * Le os registros a partir da posicao atual e os aplica, ate o fim do
+ * arquivo ou o primeiro registro invalido (cortado por uma queda). Chamada
+ * com a latencia suspensa (latencia.h).
+ *
+ * Retorno: 1 se sucesso, 0 se a leitura falhou ou faltou memoria
+ */
+static int reaplicar(Diario* diario, Mochila* mochila) {
+    RegistroDiario bloco[REGISTROS_POR_LEITURA];
+
+    for (;;) {
+        long lidos = lerTudo(diario->descritor, bloco, sizeof(bloco));
+        if (lidos < 0) {
+            return 0;
+        }
+
+        int completos = (int)(lidos / (long)sizeof(RegistroDiario));
+        for (int i = 0; i < completos; i++) {
+            if (!registroValido(&bloco[i])) {
+                return 1;
+            }
+            if (!aplicarRegistro(mochila, &bloco[i])) {
+                return 0;
+            }
+            diario->registros++;
+        }
+        if (completos < REGISTROS_POR_LEITURA) {
+            return 1;
+        }
+    }
+}
+
+// ============================================================================
+// CICLO DE VIDA
+// ============================================================================
+
+/*
+ * Funcao: diarioAbrir
+ * Abre (ou cria) o diario e reaplica na mochila os registros da geracao
+ * informada. Um diario de outra geracao, ou de outro formato, e
+ * esvaziado. Um fim de arquivo cortado por uma queda e descartado.
+ *
+ * Complexidade: O(r) operacoes da mochila (r = registros reaplicados)
+ *
+ * Parametros:
+ *   - geracao: geracao lida do snapshot (snapshotCarregar; 0 sem snapshot)
+ *   - mochila: mochila ja carregada do snapshot (ou vazia)
+ *   - reaplicados: se nao for NULL, recebe quantos registros foram reaplicados
+ *
+ * Retorno: 1 se sucesso, 0 se o arquivo nao pode ser aberto ou lido ou
+ *          faltou memoria (diario->descritor fica -1)
+ */
+int diarioAbrir(Diario* diario, const char* caminho, uint32_t geracao, Mochila* mochila, long* reaplicados) {
+    diario->geracao = geracao;
+    diario->registros = 0;
+    diario->pendentes = 0;
+    diario->inicioPendentes = 0;
+    diario->commits = 0;
+    if (reaplicados != NULL) {
+        *reaplicados = 0;
+    }
+
+    diario->descritor = open(caminho, O_RDWR | O_CREAT, 0644);
+    if (diario->descritor < 0) {
+        return 0;
+    }
+
+    CabecalhoDiario cabecalho;
+    int valido = lerTudo(diario->descritor, &cabecalho, sizeof(CabecalhoDiario)) == (long)sizeof(CabecalhoDiario) &&
+                 memcmp(cabecalho.magica, MAGICA_DIARIO, sizeof(MAGICA_DIARIO)) == 0 &&
+                 cabecalho.versao == VERSAO_DIARIO && cabecalho.tamanhoRegistro == sizeof(RegistroDiario) &&
+                 cabecalho.geracao == geracao;
+
+    int ok;
+    if (valido) {
+        // Reaplicar refaz operacoes de outra sessao: nao entram nos histogramas
+        latenciaSuspender(true);
+        int reaplicou = reaplicar(diario, mochila);
+        latenciaSuspender(false);
+        ok = reaplicou && ftruncate(diario->descritor, fimRegistros(diario)) == 0 &&
+             lseek(diario->descritor, fimRegistros(diario), SEEK_SET) >= 0;
+        if (reaplicados != NULL) {
+            *reaplicados = diario->registros;
+        }
+    } else {
+        ok = diarioReiniciar(diario, geracao);
+    }
+
+    if (!ok) {
+        close(diario->descritor);
+        diario->descritor = -1;
+    }
+    return ok;
+}
+
+/*
+ * Funcao: diarioFechar
+ * Faz o fsync pendente e fecha o arquivo.
+ */
+void diarioFechar(Diario* diario) {
+    if (diario->descritor < 0) {
+        return;
+    }
+    diarioSincronizar(diario);
+    close(diario->descritor);
+    diario->descritor = -1;
+}
+
+/*
+ * Funcao: diarioReiniciar
+ * Esvazia o diario e o marca com a nova geracao. Chamada logo depois de
+ * gravar um snapshot com essa geracao (snapshotSalvar).
+ *
+ * Retorno: 1 se sucesso, 0 se a gravacao falhou
+ */
+int diarioReiniciar(Diario* diario, uint32_t geracao) {
+    if (diario->descritor < 0) {
+        return 0;
+    }
+
+    CabecalhoDiario cabecalho;
+    memset(&cabecalho, 0, sizeof(CabecalhoDiario));
+    memcpy(cabecalho.magica, MAGICA_DIARIO, sizeof(MAGICA_DIARIO));
+    cabecalho.versao = VERSAO_DIARIO;
+    cabecalho.tamanhoRegistro = sizeof(RegistroDiario);
+    cabecalho.geracao = geracao;
+
+    // Primeiro some com os registros: um cabecalho novo sobre registros
+    // antigos os faria ser reaplicados sobre o snapshot que ja os contem
+    if (ftruncate(diario->descritor, 0) != 0 || lseek(diario->descritor, 0, SEEK_SET) < 0 ||
+        !escreverTudo(diario->descritor, &cabecalho, sizeof(CabecalhoDiario)) || fsync(diario->descritor) != 0) {
+        return 0;
+    }
+
+    diario->geracao = geracao;
+    diario->registros = 0;
+    diario->pendentes = 0;
+    diario->commits++;
+    return 1;
+}
+
+/*
+ * Funcao: diarioSincronizar
+ * fsync dos registros pendentes. Util antes de uma pausa longa (esperar
+ * o jogador, por exemplo), quando nenhuma escrita nova dispararia o
+ * commit da janela.
+ *
+ * Retorno: 1 se sucesso (ou nada pendente), 0 se o fsync falhou
+ */
+int diarioSincronizar(Diario* diario) {
+    if (diario->descritor < 0) {
+        return 0;
+    }
+    if (diario->pendentes == 0) {
+        return 1;
+    }
+    if (fsync(diario->descritor) != 0) {
+        return 0;
+    }
+    diario->pendentes = 0;
+    diario->commits++;
+    return 1;
+}
+
+// ============================================================================
+// REGISTRO DAS OPERACOES
+// ============================================================================
+
+/*
+ * Funcao: acrescentar
+ * Grava o registro no fim do arquivo e faz o fsync quando o grupo
+ * pendente enche ou envelhece.
+ *
+ * Complexidade: uma escrita sequencial; um fsync a cada grupo
+ *
+ * Retorno: 1 se sucesso, 0 se a gravacao falhou (o registro nao fica
+ *          no diario)
+ */
+static int acrescentar(Diario* diario, RegistroDiario* registro) {
+    if (diario->descritor < 0) {
+        return 0;
+    }
+
+    registro->crc = crcRegistro(registro);
+    if (!escreverTudo(diario->descritor, registro, sizeof(RegistroDiario))) {
+        // Um pedaco de registro no fim esconderia os registros seguintes
+        if (ftruncate(diario->descritor, fimRegistros(diario)) == 0) {
+            lseek(diario->descritor, fimRegistros(diario), SEEK_SET);
+        }
+        return 0;
+    }
+    diario->registros++;
+
+    uint64_t agora = cronometroNs();
+    if (diario->pendentes++ == 0) {
+        diario->inicioPendentes = agora;
+    }
+    if (diario->pendentes >= REGISTROS_POR_COMMIT || agora - diario->inicioPendentes >= JANELA_COMMIT_NS) {
+        return diarioSincronizar(diario);
+    }
+    return 1;
+}
+
+/*
+ * Funcao: novoRegistro
+ * Registro zerado (inclusive o preenchimento, que entra no CRC).
+ */
+static void novoRegistro(RegistroDiario* registro, OperacaoDiario operacao, const char* nome) {
+    memset(registro, 0, sizeof(RegistroDiario));
+    registro->operacao = operacao;
+    if (nome != NULL) {
+        size_t tamanho = strlen(nome);
+        memcpy(registro->nome, nome, tamanho < TAM_NOME - 1 ? tamanho : TAM_NOME - 1);
+    }
+}
+
+int diarioRegistrarInsercao(Diario* diario, const Item* item) {
+    RegistroDiario registro;
+    novoRegistro(&registro, DIARIO_INSERIR, item->nome);
+    strncpy(registro.tipo, tipoNome(item->idTipo), TAM_TIPO - 1);
+    registro.quantidade = item->quantidade;
+    registro.prioridade = item->prioridade;
+    return acrescentar(diario, &registro);
+}
+
+int diarioRegistrarRemocao(Diario* diario, const char* nome) {
+    RegistroDiario registro;
+    novoRegistro(&registro, DIARIO_REMOVER, nome);
+    return acrescentar(diario, &registro);
+}
+
+int diarioRegistrarQuantidade(Diario* diario, const char* nome, int quantidade) {
+    RegistroDiario registro;
+    novoRegistro(&registro, DIARIO_QUANTIDADE, nome);
+    registro.quantidade = quantidade;
+    return acrescentar(diario, &registro);
+}
+
+/*
+ * Funcao: diarioRegistrarOrdenacao
+ * Registra uma ordenacao: ela muda as posicoes dos itens, e as remocoes
+ * seguintes dependem delas para serem reaplicadas do mesmo jeito.
+ */
+int diarioRegistrarOrdenacao(Diario* diario, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo) {
+    RegistroDiario registro;
+    novoRegistro(&registro, DIARIO_ORDENAR, NULL);
+    registro.criterio = criterio;
+    registro.algoritmo = algoritmo;
+    return acrescentar(diario, &registro);
+}
@@ -0,0 +1,119 @@
+/*
+ * LIBMOCHILA - DIARIO DE OPERACOES
+ *
+ * Descricao: Registro binario, so de acrescimo, das operacoes feitas na
+ * mochila desde o ultimo snapshot (snapshot.h): insercoes, remocoes,
+ * mudancas de quantidade e ordenacoes. Cada coleta custa a escrita
+ * sequencial de um registro de tamanho fixo, em vez de regravar o
+ * inventario inteiro; ao iniciar, o diario e reaplicado sobre o snapshot.
+ *
+ * Cada registro vai para o arquivo (write) assim que a operacao termina,
+ * entao sobrevive a uma queda do programa. O fsync e feito em grupo
+ * (group commit): a cada REGISTROS_POR_COMMIT registros ou quando o mais
+ * antigo pendente passa de JANELA_COMMIT_NS, alem de diarioSincronizar.
+ * Uma queda do sistema perde no maximo essa janela.
+ *
+ * Cada registro tem CRC-32: um registro cortado pela queda (ou corrompido)
+ * encerra a reaplicacao e e descartado do fim do arquivo.
+ *
+ * O diario tem a geracao do snapshot que continua. Depois de gravar um
+ * snapshot novo com a geracao seguinte, diarioReiniciar esvazia o diario;
+ * se a queda vier entre os dois passos, o diario antigo tem outra geracao
+ * e e ignorado, pois suas operacoes ja estao no snapshot.
+ */
+
+#ifndef DIARIO_H
+#define DIARIO_H
+
+#include <stdint.h>
+
+#include "mochila.h"
+
+#define MAGICA_DIARIO "DIARIO"          // 8 bytes com o '\0'
+#define VERSAO_DIARIO 1
+#define REGISTROS_POR_COMMIT 64          // Registros pendentes que forcam um fsync
+#define JANELA_COMMIT_NS 10000000ULL     // Idade maxima (10 ms) de um registro sem fsync
+
+/*
+ * Enum: OperacaoDiario
+ * Operacoes registradas.
+ */
+typedef enum {
+    DIARIO_INSERIR = 1,
+    DIARIO_REMOVER,
+    DIARIO_QUANTIDADE,
+    DIARIO_ORDENAR
+} OperacaoDiario;
+
+/*
+ * Struct: CabecalhoDiario
+ * Inicio do arquivo; os registros vem em seguida.
+ *
+ * Campos:
+ *   - magica / versao: identificam o formato
+ *   - tamanhoRegistro: sizeof(RegistroDiario) de quem gravou
+ *   - geracao: geracao do snapshot que este diario continua
+ */
+typedef struct {
+    char magica[8];
+    uint32_t versao;
+    uint32_t tamanhoRegistro;
+    uint32_t geracao;
+    uint32_t reservado;
+} CabecalhoDiario;
+
+/*
+ * Struct: RegistroDiario
+ * Uma operacao. O tipo vai pelo nome, pois os ids do dicionario de tipos
+ * valem so dentro de um processo.
+ *
+ * Campos:
+ *   - crc: CRC-32 dos demais bytes do registro
+ *   - operacao: OperacaoDiario
+ *   - nome: item inserido, removido ou alterado
+ *   - tipo / quantidade / prioridade: item inserido (quantidade tambem
+ *     e o novo valor em DIARIO_QUANTIDADE)
+ *   - criterio / algoritmo: argumentos de DIARIO_ORDENAR
+ */
+typedef struct {
+    uint32_t crc;
+    uint32_t operacao;
+    char nome[TAM_NOME];
+    char tipo[TAM_TIPO];
+    int32_t quantidade;
+    int32_t prioridade;
+    int32_t criterio;
+    int32_t algoritmo;
+} RegistroDiario;
+
+/*
+ * Struct: Diario
+ *
+ * Campos:
+ *   - descritor: arquivo aberto (-1 se o diario nao esta aberto)
+ *   - geracao: geracao gravada no cabecalho
+ *   - registros: registros validos no arquivo
+ *   - pendentes: registros escritos desde o ultimo fsync
+ *   - inicioPendentes: cronometroNs do primeiro pendente
+ *   - commits: fsyncs feitos desde a abertura
+ */
+typedef struct {
+    int descritor;
+    uint32_t geracao;
+    long registros;
+    int pendentes;
+    uint64_t inicioPendentes;
+    long commits;
+} Diario;
+
+int diarioAbrir(Diario* diario, const char* caminho, uint32_t geracao, Mochila* mochila, long* reaplicados);
+void diarioFechar(Diario* diario);
+int diarioReiniciar(Diario* diario, uint32_t geracao);
+int diarioSincronizar(Diario* diario);
+
+int diarioRegistrarInsercao(Diario* diario, const Item* item);
+int diarioRegistrarRemocao(Diario* diario, const char* nome);
+int diarioRegistrarQuantidade(Diario* diario, const char* nome, int quantidade);
+int diarioRegistrarOrdenacao(Diario* diario, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo);
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ * LIBMOCHILA - ESTATISTICAS DE TRABALHO
+ */
+
+#include <string.h>
+
+#include "estatisticas.h"
+
+/*
+ * Funcao: estatisticasZerar
+ * Zera o contexto antes de uma operacao (ou de um lote).
+ */
+void estatisticasZerar(Estatisticas* estatisticas) {
+    memset(estatisticas, 0, sizeof(Estatisticas));
+}
+
+/*
+ * Funcao: estatisticasSomar
+ * Acumula em destino o trabalho registrado em origem (por exemplo, o de
+ * cada thread de uma operacao paralela).
+ */
+void estatisticasSomar(Estatisticas* destino, const Estatisticas* origem) {
+    destino->comparacoes += origem->comparacoes;
+    destino->trocas += origem->trocas;
+    destino->movimentos += origem->movimentos;
+    destino->bytesMovidos += origem->bytesMovidos;
+}
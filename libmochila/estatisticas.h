@@ -0,0 +1,36 @@
+/*
+ * LIBMOCHILA - ESTATISTICAS DE TRABALHO
+ *
+ * Descricao: Contexto que as ordenacoes e buscas recebem para registrar o
+ * trabalho realizado. Cada chamada soma no contexto que recebeu (nada e
+ * global): duas operacoes simultaneas, ou uma busca dentro de uma
+ * ordenacao, contam separadamente se usarem contextos diferentes, e um
+ * lote de operacoes pode acumular no mesmo contexto.
+ *
+ * Todas as funcoes aceitam NULL quando as estatisticas nao interessam.
+ */
+
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+/*
+ * Struct: Estatisticas
+ *
+ * Campos:
+ *   - comparacoes: comparacoes entre elementos (ou entre um nome e a chave)
+ *   - trocas: trocas de dois elementos de posicao
+ *   - movimentos: copias de um elemento (para o vetor, um auxiliar ou uma
+ *                 variavel temporaria); uma troca custa 3
+ *   - bytesMovidos: bytes dessas copias (um Item ou um indice de 4 bytes)
+ */
+typedef struct {
+    long comparacoes;
+    long trocas;
+    long movimentos;
+    long long bytesMovidos;
+} Estatisticas;
+
+void estatisticasZerar(Estatisticas* estatisticas);
+void estatisticasSomar(Estatisticas* destino, const Estatisticas* origem);
+
+#endif
@@ -0,0 +1,434 @@
+/*
+ * LIBMOCHILA - IMPORTACAO DE INVENTARIO EM CSV/TSV
+ *
+ * Implementacao da leitura em fluxo, da separacao dos campos no proprio
+ * buffer e dos destinos de cada estrutura.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cronometro.h"
+#include "importacao.h"
+#include "lista.h"
+#include "lista_desenrolada.h"
+#include "mochila.h"
+
+#define CAMPOS_MAXIMOS 4   // nome, tipo, quantidade, prioridade
+
+/*
+ * Struct: Campo
+ * Trecho de uma linha dentro do buffer de leitura (nao termina em '\0').
+ */
+typedef struct {
+    char* inicio;
+    int tamanho;
+} Campo;
+
+/*
+ * Struct: Importacao
+ * Estado de uma importacao em andamento.
+ *
+ * Campos:
+ *   - separador: ',' ou '\t' (0 ate a primeira linha decidir)
+ *   - primeiraLinha: a proxima linha nao vazia pode ser o cabecalho
+ *   - numeroLinha: linhas lidas ate agora, contando as vazias
+ *   - lote / noLote: itens montados e ainda nao entregues ao destino
+ *   - tipoCache / tamanhoTipoCache / idTipoCache: ultimo tipo registrado,
+ *     para nao consultar o dicionario em linhas seguidas do mesmo tipo
+ */
+typedef struct {
+    char separador;
+    bool primeiraLinha;
+    long long numeroLinha;
+    Item* lote;
+    int noLote;
+    char tipoCache[TAM_TIPO];
+    int tamanhoTipoCache;
+    unsigned short idTipoCache;
+    DestinoImportacao destino;
+    void* contexto;
+    ResultadoImportacao* resultado;
+} Importacao;
+
+// ============================================================================
+// SEPARACAO DOS CAMPOS
+// ============================================================================
+
+/*
+ * Funcao: separarCampos
+ * Divide a linha [linha, fim) nos campos, sem copiar: cada Campo aponta
+ * para dentro do buffer. Um campo entre aspas tem o "" trocado por " no
+ * proprio lugar (o texto so encolhe).
+ *
+ * Retorno: quantidade de campos, ou -1 se a linha tem mais que
+ *          CAMPOS_MAXIMOS campos ou aspas mal formadas
+ */
+static int separarCampos(char* linha, char* fim, char separador, Campo* campos) {
+    char* p = linha;
+    int total = 0;
+
+    for (;;) {
+        if (total == CAMPOS_MAXIMOS) {
+            return -1;
+        }
+        Campo* campo = &campos[total++];
+
+        if (p < fim && *p == '"') {
+            char* escrita = ++p;
+            campo->inicio = p;
+            for (;;) {
+                if (p == fim) {
+                    return -1;  // Aspas sem fechar
+                }
+                if (*p == '"') {
+                    if (p + 1 < fim && p[1] == '"') {
+                        *escrita++ = '"';
+                        p += 2;
+                        continue;
+                    }
+                    p++;
+                    break;
+                }
+                *escrita++ = *p++;
+            }
+            campo->tamanho = (int)(escrita - campo->inicio);
+            if (p < fim && *p != separador) {
+                return -1;  // Texto depois da aspa de fechamento
+            }
+        } else {
+            char* fimCampo = (char*)memchr(p, separador, (size_t)(fim - p));
+            campo->inicio = p;
+            p = fimCampo != NULL ? fimCampo : fim;
+            campo->tamanho = (int)(p - campo->inicio);
+        }
+
+        if (p == fim) {
+            return total;
+        }
+        p++;  // Separador
+    }
+}
+
+/*
+ * Funcao: lerInteiro
+ * Converte um campo em int: sinal opcional e digitos, com espacos em
+ * volta permitidos.
+ *
+ * Retorno: 1 se sucesso, 0 se o campo nao e um inteiro ou nao cabe em int
+ */
+static int lerInteiro(const Campo* campo, int* valor) {
+    const char* p = campo->inicio;
+    const char* fim = p + campo->tamanho;
+    bool negativo = false;
+    long long acumulado = 0;
+
+    while (p < fim && *p == ' ') {
+        p++;
+    }
+    while (fim > p && fim[-1] == ' ') {
+        fim--;
+    }
+    if (p < fim && (*p == '-' || *p == '+')) {
+        negativo = *p == '-';
+        p++;
+    }
+    if (p == fim) {
+        return 0;
+    }
+
+    for (; p < fim; p++) {
+        if (*p < '0' || *p > '9') {
+            return 0;
+        }
+        acumulado = acumulado * 10 + (*p - '0');
+        if (acumulado > (long long)INT_MAX + 1) {
+            return 0;
+        }
+    }
+    if (negativo) {
+        acumulado = -acumulado;
+    } else if (acumulado > INT_MAX) {
+        return 0;
+    }
+
+    *valor = (int)acumulado;
+    return 1;
+}
+
+// ============================================================================
+// MONTAGEM DOS ITENS
+// ============================================================================
+
+/*
+ * Funcao: idDoTipo
+ * Registra o tipo do campo no dicionario (ou reaproveita o da linha
+ * anterior). Termina o campo com '\0' dentro do buffer: a posicao seguinte
+ * e o separador, a aspa, o fim da linha ou o byte de folga do buffer.
+ */
+static unsigned short idDoTipo(Importacao* importacao, Campo* campo) {
+    int tamanho = campo->tamanho < TAM_TIPO - 1 ? campo->tamanho : TAM_TIPO - 1;
+
+    if (tamanho == importacao->tamanhoTipoCache &&
+        memcmp(campo->inicio, importacao->tipoCache, (size_t)tamanho) == 0) {
+        return importacao->idTipoCache;
+    }
+
+    campo->inicio[tamanho] = '\0';
+    unsigned short id = tipoRegistrar(campo->inicio);
+    if (id != TIPO_INVALIDO) {
+        memcpy(importacao->tipoCache, campo->inicio, (size_t)tamanho);
+        importacao->tamanhoTipoCache = tamanho;
+        importacao->idTipoCache = id;
+    }
+    return id;
+}
+
+/*
+ * Funcao: entregarLote
+ * Passa os itens montados ao destino e esvazia o lote.
+ *
+ * Retorno: 1 se sucesso, 0 se o destino recusou (falta de memoria)
+ */
+static int entregarLote(Importacao* importacao) {
+    if (importacao->noLote == 0) {
+        return 1;
+    }
+
+    int aceito = importacao->destino(importacao->contexto, importacao->lote, importacao->noLote);
+    if (aceito) {
+        importacao->resultado->importados += importacao->noLote;
+    }
+    importacao->noLote = 0;
+    return aceito;
+}
+
+static void rejeitar(Importacao* importacao) {
+    ResultadoImportacao* resultado = importacao->resultado;
+
+    resultado->linhas++;
+    resultado->rejeitados++;
+    if (resultado->primeiraRejeitada == 0) {
+        resultado->primeiraRejeitada = importacao->numeroLinha;
+    }
+}
+
+/*
+ * Funcao: processarLinha
+ * Interpreta a linha [linha, fim) (sem o '\n') e acrescenta o item ao
+ * lote, entregando-o ao destino quando enche.
+ *
+ * Retorno: 1 para continuar, 0 se o destino recusou o lote
+ */
+static int processarLinha(Importacao* importacao, char* linha, char* fim) {
+    importacao->numeroLinha++;
+
+    if (fim > linha && fim[-1] == '\r') {
+        fim--;
+    }
+    if (fim == linha) {
+        return 1;
+    }
+
+    bool primeira = importacao->primeiraLinha;
+    importacao->primeiraLinha = false;
+    if (importacao->separador == 0) {
+        importacao->separador = memchr(linha, '\t', (size_t)(fim - linha)) != NULL ? '\t' : ',';
+    }
+
+    Campo campos[CAMPOS_MAXIMOS];
+    int total = separarCampos(linha, fim, importacao->separador, campos);
+    int quantidade;
+    int prioridade = PRIORIDADE_PADRAO_IMPORTACAO;
+
+    if (total < 3) {
+        rejeitar(importacao);
+        return 1;
+    }
+    if (!lerInteiro(&campos[2], &quantidade)) {
+        // Na primeira linha, uma quantidade que nao e numero indica o cabecalho
+        if (!primeira) {
+            rejeitar(importacao);
+        }
+        return 1;
+    }
+    // Prioridade informada tem de ser inteiro positivo: 0 ou negativa cairia
+    // fora da faixa de todos os programas
+    if (campos[0].tamanho == 0 ||
+        (total == 4 && campos[3].tamanho > 0 && (!lerInteiro(&campos[3], &prioridade) || prioridade < 1))) {
+        rejeitar(importacao);
+        return 1;
+    }
+
+    // Tipo que o dicionario nao registrou (limite de tipos ou falta de
+    // memoria): os programas tambem recusam esses itens
+    unsigned short idTipo = idDoTipo(importacao, &campos[1]);
+    if (idTipo == TIPO_INVALIDO) {
+        rejeitar(importacao);
+        return 1;
+    }
+
+    Item* item = &importacao->lote[importacao->noLote];
+    int tamanhoNome = campos[0].tamanho < TAM_NOME - 1 ? campos[0].tamanho : TAM_NOME - 1;
+
+    memset(item, 0, sizeof(Item));
+    memcpy(item->nome, campos[0].inicio, (size_t)tamanhoNome);
+    item->idTipo = idTipo;
+    item->quantidade = quantidade;
+    item->prioridade = prioridade;
+
+    importacao->resultado->linhas++;
+    if (++importacao->noLote == ITENS_POR_LOTE_IMPORTACAO) {
+        return entregarLote(importacao);
+    }
+    return 1;
+}
+
+// ============================================================================
+// LEITURA DO ARQUIVO
+// ============================================================================
+
+/*
+ * Funcao: lerArquivo
+ * Le o arquivo em blocos de TAM_BUFFER_IMPORTACAO bytes e processa cada
+ * linha completa. O resto de linha no fim do bloco vai para o inicio do
+ * buffer e e completado pela leitura seguinte; uma linha que nao cabe no
+ * buffer inteiro e rejeitada e pulada ate o proximo '\n'.
+ *
+ * Retorno: 1 se sucesso, 0 se erro de leitura ou o destino recusou um lote
+ */
+static int lerArquivo(Importacao* importacao, FILE* arquivo, char* buffer) {
+    size_t guardados = 0;
+    bool descartando = false;
+
+    for (;;) {
+        size_t lidos = fread(buffer + guardados, 1, TAM_BUFFER_IMPORTACAO - guardados, arquivo);
+        char* fimDados = buffer + guardados + lidos;
+        char* linha = buffer;
+        char* quebra;
+
+        importacao->resultado->bytes += (long long)lidos;
+
+        while ((quebra = (char*)memchr(linha, '\n', (size_t)(fimDados - linha))) != NULL) {
+            if (descartando) {
+                descartando = false;
+            } else if (!processarLinha(importacao, linha, quebra)) {
+                return 0;
+            }
+            linha = quebra + 1;
+        }
+        guardados = (size_t)(fimDados - linha);
+
+        if (lidos == 0) {
+            // Fim do arquivo: a ultima linha pode nao terminar em '\n'
+            if (ferror(arquivo)) {
+                return 0;
+            }
+            return guardados == 0 || descartando || processarLinha(importacao, linha, fimDados);
+        }
+
+        if (guardados == TAM_BUFFER_IMPORTACAO) {
+            if (!descartando) {
+                importacao->numeroLinha++;
+                importacao->primeiraLinha = false;
+                rejeitar(importacao);
+                descartando = true;
+            }
+            guardados = 0;
+        } else if (guardados > 0 && linha != buffer) {
+            memmove(buffer, linha, guardados);
+        }
+    }
+}
+
+/*
+ * Funcao: importarArquivo
+ * Importa os itens do arquivo CSV/TSV para o destino (ver importacao.h
+ * para o formato).
+ *
+ * Complexidade: O(tamanho do arquivo) de tempo; memoria fixa
+ * (TAM_BUFFER_IMPORTACAO + ITENS_POR_LOTE_IMPORTACAO itens), alem da que
+ * o destino aloca
+ *
+ * Parametros:
+ *   - separador: ',' ou '\t'; 0 para detectar pela primeira linha (TSV se
+ *                ela tiver tabulacao)
+ *   - destino / contexto: recebem os itens em lotes (ex: importarParaMochila
+ *                         com a Mochila como contexto)
+ *   - resultado: contagens e duracao (preenchido mesmo se falhar)
+ *
+ * Retorno: 1 se sucesso, 0 se o arquivo nao pode ser lido, faltou memoria
+ *          ou o destino recusou um lote (os lotes anteriores ficam no destino)
+ */
+int importarArquivo(const char* caminho, char separador, DestinoImportacao destino, void* contexto,
+                    ResultadoImportacao* resultado) {
+    uint64_t inicio = cronometroNs();
+
+    memset(resultado, 0, sizeof(ResultadoImportacao));
+
+    FILE* arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) {
+        return 0;
+    }
+    // Os blocos vao direto para o buffer, sem a copia intermediaria do stdio
+    setvbuf(arquivo, NULL, _IONBF, 0);
+    posix_fadvise(fileno(arquivo), 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    // Um byte de folga para idDoTipo terminar o ultimo campo do buffer
+    char* buffer = (char*)malloc(TAM_BUFFER_IMPORTACAO + 1);
+    Importacao importacao;
+    importacao.separador = separador;
+    importacao.primeiraLinha = true;
+    importacao.numeroLinha = 0;
+    importacao.lote = (Item*)malloc(sizeof(Item) * ITENS_POR_LOTE_IMPORTACAO);
+    importacao.noLote = 0;
+    importacao.tamanhoTipoCache = -1;
+    importacao.idTipoCache = TIPO_INVALIDO;
+    importacao.destino = destino;
+    importacao.contexto = contexto;
+    importacao.resultado = resultado;
+
+    int sucesso = buffer != NULL && importacao.lote != NULL &&
+                  lerArquivo(&importacao, arquivo, buffer) &&
+                  entregarLote(&importacao);
+
+    free(importacao.lote);
+    free(buffer);
+    fclose(arquivo);
+
+    resultado->ns = cronometroNs() - inicio;
+    return sucesso;
+}
+
+/*
+ * Funcao: importacaoMBPorSegundo
+ * Vazao da importacao em megabytes (10^6 bytes) do arquivo por segundo.
+ */
+double importacaoMBPorSegundo(const ResultadoImportacao* resultado) {
+    if (resultado->ns == 0) {
+        return 0.0;
+    }
+    return ((double)resultado->bytes / 1e6) / ((double)resultado->ns / 1e9);
+}
+
+// ============================================================================
+// DESTINOS
+// ============================================================================
+
+int importarParaMochila(void* destino, const Item* itens, int total) {
+    return mochilaInserirLote((Mochila*)destino, itens, total) == total;
+}
+
+int importarParaLista(void* destino, const Item* itens, int total) {
+    return listaInserirLote((Lista*)destino, itens, total) == total;
+}
+
+int importarParaDesenrolada(void* destino, const Item* itens, int total) {
+    return desenroladaInserirLote((ListaDesenrolada*)destino, itens, total) == total;
+}
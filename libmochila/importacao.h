@@ -0,0 +1,77 @@
+/*
+ * LIBMOCHILA - IMPORTACAO DE INVENTARIO EM CSV/TSV
+ *
+ * Descricao: Carrega itens de um arquivo texto, uma linha por item:
+ *
+ *   nome,tipo,quantidade[,prioridade]
+ *
+ * separados por virgula (CSV) ou tabulacao (TSV). A prioridade e opcional
+ * (PRIORIDADE_PADRAO_IMPORTACAO quando falta ou vem vazia) e, quando
+ * informada, tem de ser positiva; o limite superior (5 no FreeFire, 10 no
+ * mestre) fica com quem importa. Um campo pode vir entre aspas (e entao conter o
+ * separador, com "" para uma aspa), mas nunca uma quebra de linha. Uma
+ * primeira linha cuja quantidade nao e numero e tratada como cabecalho;
+ * linhas vazias sao ignoradas e linhas mal formadas sao contadas como
+ * rejeitadas, sem interromper a importacao.
+ *
+ * O arquivo e lido em fluxo, por um buffer de tamanho fixo
+ * (TAM_BUFFER_IMPORTACAO): a memoria usada nao depende do tamanho do
+ * arquivo. Os campos sao separados no proprio buffer, sem copiar a linha,
+ * e os itens sao entregues ao destino em lotes (ITENS_POR_LOTE_IMPORTACAO),
+ * pelo caminho de insercao em massa de cada estrutura.
+ */
+
+#ifndef IMPORTACAO_H
+#define IMPORTACAO_H
+
+#include <stdint.h>
+
+#include "item.h"
+
+#define TAM_BUFFER_IMPORTACAO (1 << 20)   // Bytes lidos do arquivo por vez (1 MiB)
+#define ITENS_POR_LOTE_IMPORTACAO 4096     // Itens entregues ao destino por chamada
+#define PRIORIDADE_PADRAO_IMPORTACAO 1     // Sem prioridade no arquivo: a menor valida em todos os programas
+
+/*
+ * Tipo: DestinoImportacao
+ * Recebe um lote de itens ja montados (com o tipo registrado no
+ * dicionario) e os insere na estrutura 'destino'.
+ *
+ * Retorno: 1 se todos foram inseridos, 0 para interromper a importacao
+ */
+typedef int (*DestinoImportacao)(void* destino, const Item* itens, int total);
+
+/*
+ * Struct: ResultadoImportacao
+ *
+ * Campos:
+ *   - linhas: linhas de dados lidas (sem o cabecalho e as vazias)
+ *   - importados: itens entregues ao destino
+ *   - rejeitados: linhas mal formadas (campos faltando, aspas sem fechar,
+ *                 quantidade ou prioridade que nao e inteiro, prioridade
+ *                 menor que 1, linha maior que o buffer) ou com tipo que o dicionario nao aceitou
+ *                 (TIPO_INVALIDO)
+ *   - primeiraRejeitada: numero (a partir de 1) da primeira linha
+ *                        rejeitada, 0 se nenhuma
+ *   - bytes: bytes lidos do arquivo
+ *   - ns: duracao da importacao inteira (leitura, separacao e insercao)
+ */
+typedef struct {
+    long long linhas;
+    long long importados;
+    long long rejeitados;
+    long long primeiraRejeitada;
+    long long bytes;
+    uint64_t ns;
+} ResultadoImportacao;
+
+int importarArquivo(const char* caminho, char separador, DestinoImportacao destino, void* contexto,
+                    ResultadoImportacao* resultado);
+double importacaoMBPorSegundo(const ResultadoImportacao* resultado);
+
+// Destinos prontos; 'destino' e a Mochila, Lista ou ListaDesenrolada
+int importarParaMochila(void* destino, const Item* itens, int total);
+int importarParaLista(void* destino, const Item* itens, int total);
+int importarParaDesenrolada(void* destino, const Item* itens, int total);
+
+#endif
@@ -0,0 +1,391 @@
+/*
+ * LIBMOCHILA - INDICE HASH POR NOME
+ *
+ * Implementacao da tabela hash com sondagem linear e lapides.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "indice_hash.h"
+
+#define CAPACIDADE_MINIMA 16
+
+// Fator de carga maximo (usadas / capacidade) antes de redimensionar: 70%
+#define CARGA_MAXIMA_NUM 7
+#define CARGA_MAXIMA_DEN 10
+
+/*
+ * Funcao: hashNome
+ * Calcula o hash FNV-1a de 32 bits do nome.
+ */
+unsigned int hashNome(const char* nome) {
+    unsigned int hash = 2166136261u;
+
+    for (const unsigned char* p = (const unsigned char*)nome; *p != '\0'; p++) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/*
+ * Funcao: capacidadePara
+ * Menor potencia de 2 capaz de guardar n entradas sem passar da carga maxima.
+ */
+static int capacidadePara(int n) {
+    int capacidade = CAPACIDADE_MINIMA;
+
+    while ((long)n * CARGA_MAXIMA_DEN >= (long)capacidade * CARGA_MAXIMA_NUM) {
+        capacidade *= 2;
+    }
+
+    return capacidade;
+}
+
+/*
+ * Funcao: alocarTabela
+ * Aloca uma tabela vazia com a capacidade informada.
+ */
+static int alocarTabela(IndiceHash* indice, int capacidade) {
+    EntradaHash* entradas = (EntradaHash*)malloc(sizeof(EntradaHash) * (size_t)capacidade);
+    if (entradas == NULL) {
+        return 0;
+    }
+
+    for (int i = 0; i < capacidade; i++) {
+        entradas[i].hash = 0;
+        entradas[i].posicao = HASH_VAZIO;
+    }
+
+    indice->entradas = entradas;
+    indice->capacidade = capacidade;
+    indice->ocupadas = 0;
+    indice->usadas = 0;
+    return 1;
+}
+
+/*
+ * Funcao: inserirEntrada
+ * Coloca (hash, posicao) na primeira entrada livre da sequencia de sondagem.
+ * Supoe que a tabela tem espaco (fator de carga ja verificado).
+ */
+static void inserirEntrada(IndiceHash* indice, unsigned int hash, int posicao) {
+    int mascara = indice->capacidade - 1;
+    int i = (int)(hash & (unsigned int)mascara);
+
+    while (indice->entradas[i].posicao >= 0) {
+        i = (i + 1) & mascara;
+    }
+
+    if (indice->entradas[i].posicao == HASH_VAZIO) {
+        indice->usadas++;
+    }
+    indice->entradas[i].hash = hash;
+    indice->entradas[i].posicao = posicao;
+    indice->ocupadas++;
+}
+
+/*
+ * Funcao: redimensionar
+ * Recria a tabela com nova capacidade, descartando as lapides.
+ * Usa apenas os hashes guardados, sem reler os nomes.
+ */
+static int redimensionar(IndiceHash* indice, int capacidade) {
+    IndiceHash nova;
+    if (!alocarTabela(&nova, capacidade)) {
+        return 0;
+    }
+
+    for (int i = 0; i < indice->capacidade; i++) {
+        if (indice->entradas[i].posicao >= 0) {
+            inserirEntrada(&nova, indice->entradas[i].hash, indice->entradas[i].posicao);
+        }
+    }
+
+    free(indice->entradas);
+    *indice = nova;
+    return 1;
+}
+
+/*
+ * Funcao: localizarEntrada
+ * Retorna a entrada da tabela que aponta para a posicao informada, ou -1.
+ */
+static int localizarEntrada(const IndiceHash* indice, const char* nome, int posicao) {
+    unsigned int hash = hashNome(nome);
+    int mascara = indice->capacidade - 1;
+    int i = (int)(hash & (unsigned int)mascara);
+
+    while (indice->entradas[i].posicao != HASH_VAZIO) {
+        if (indice->entradas[i].posicao == posicao) {
+            return i;
+        }
+        i = (i + 1) & mascara;
+    }
+
+    return -1;
+}
+
+/*
+ * Funcao: indiceHashIniciar
+ * Cria um indice vazio dimensionado para a quantidade de itens informada.
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int indiceHashIniciar(IndiceHash* indice, int capacidade) {
+    return alocarTabela(indice, capacidadePara(capacidade));
+}
+
+/*
+ * Funcao: indiceHashLiberar
+ * Libera a memoria da tabela.
+ */
+void indiceHashLiberar(IndiceHash* indice) {
+    free(indice->entradas);
+    indice->entradas = NULL;
+    indice->capacidade = 0;
+    indice->ocupadas = 0;
+    indice->usadas = 0;
+}
+
+/*
+ * Funcao: esvaziarPara
+ * Deixa o indice vazio e dimensionado para 'total' itens, antes de
+ * reindexa-los.
+ *
+ * Retorno: 1 se sucesso, 0 se faltou memoria e a tabela atual e pequena
+ *          demais (o indice continua como estava)
+ */
+static int esvaziarPara(IndiceHash* indice, int total) {
+    int capacidade = capacidadePara(total);
+    IndiceHash nova;
+
+    // Sem memoria para a tabela nova, a atual e refeita no lugar se comporta os itens
+    if (capacidade != indice->capacidade && alocarTabela(&nova, capacidade)) {
+        free(indice->entradas);
+        *indice = nova;
+    } else if (capacidade > indice->capacidade) {
+        return 0;
+    } else {
+        for (int i = 0; i < indice->capacidade; i++) {
+            indice->entradas[i].posicao = HASH_VAZIO;
+        }
+        indice->ocupadas = 0;
+        indice->usadas = 0;
+    }
+    return 1;
+}
+
+/*
+ * Funcao: indiceHashReconstruir
+ * Reindexa todos os itens do vetor (usado depois de uma ordenacao,
+ * que muda a posicao de varios itens de uma vez).
+ *
+ * Complexidade: O(n)
+ *
+ * Retorno: 1 se sucesso, 0 se faltou memoria e a tabela atual e pequena
+ *          demais para 'total' itens (o indice continua como estava)
+ */
+int indiceHashReconstruir(IndiceHash* indice, const Item* itens, int total) {
+    if (!esvaziarPara(indice, total)) {
+        return 0;
+    }
+
+    for (int i = 0; i < total; i++) {
+        inserirEntrada(indice, hashNome(itens[i].nome), i);
+    }
+    return 1;
+}
+
+/*
+ * Funcao: indiceHashReconstruirNomes
+ * Como indiceHashReconstruir, para itens guardados em colunas: a posicao
+ * i e o nome nomes[i] (mochila_colunar.h).
+ */
+int indiceHashReconstruirNomes(IndiceHash* indice, const char (*nomes)[TAM_NOME], int total) {
+    if (!esvaziarPara(indice, total)) {
+        return 0;
+    }
+
+    for (int i = 0; i < total; i++) {
+        inserirEntrada(indice, hashNome(nomes[i]), i);
+    }
+    return 1;
+}
+
+/*
+ * Funcao: indiceHashCarregar
+ * Substitui a tabela por uma copia das entradas gravadas num snapshot
+ * (snapshot.h), sem recalcular nenhum hash.
+ *
+ * Complexidade: O(capacidade), uma copia e uma verificacao por entrada
+ *
+ * Parametros:
+ *   - entradas: tabela gravada (capacidade potencia de 2)
+ *   - totalItens: itens da mochila; posicoes fora da faixa tornam a
+ *                 tabela invalida
+ *
+ * Retorno: 1 se sucesso, 0 se a tabela e invalida ou faltou memoria (o
+ *          indice anterior continua valido)
+ */
+int indiceHashCarregar(IndiceHash* indice, const EntradaHash* entradas, int capacidade, int totalItens) {
+    if (capacidade < CAPACIDADE_MINIMA || (capacidade & (capacidade - 1)) != 0) {
+        return 0;
+    }
+
+    IndiceHash nova;
+    if (!alocarTabela(&nova, capacidade)) {
+        return 0;
+    }
+    memcpy(nova.entradas, entradas, sizeof(EntradaHash) * (size_t)capacidade);
+
+    for (int i = 0; i < capacidade; i++) {
+        int posicao = nova.entradas[i].posicao;
+        if (posicao >= totalItens || posicao < HASH_REMOVIDO) {
+            free(nova.entradas);
+            return 0;
+        }
+        nova.ocupadas += posicao >= 0;
+        nova.usadas += posicao != HASH_VAZIO;
+    }
+    if ((long)nova.usadas * CARGA_MAXIMA_DEN >= (long)capacidade * CARGA_MAXIMA_NUM) {
+        free(nova.entradas);
+        return 0;
+    }
+
+    free(indice->entradas);
+    *indice = nova;
+    return 1;
+}
+
+/*
+ * Funcao: indiceHashInserir
+ * Registra que o item com este nome esta na posicao informada.
+ *
+ * Complexidade: O(1) amortizado
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int indiceHashInserir(IndiceHash* indice, const char* nome, int posicao) {
+    if ((long)(indice->usadas + 1) * CARGA_MAXIMA_DEN >= (long)indice->capacidade * CARGA_MAXIMA_NUM) {
+        // Muitas lapides: basta limpar; tabela cheia de verdade: dobra
+        if (!redimensionar(indice, capacidadePara(indice->ocupadas + 1))) {
+            return 0;
+        }
+    }
+
+    inserirEntrada(indice, hashNome(nome), posicao);
+    return 1;
+}
+
+/*
+ * Funcao: buscarEntrada
+ * Sondagem comum as buscas por nome. O nome de cada candidato e
+ * confirmado no vetor de itens ou, se 'itens' for NULL, nas colunas.
+ */
+static int buscarEntrada(const IndiceHash* indice, const Item* itens, const uint64_t* prefixos,
+                         const char (*nomes)[TAM_NOME], const char* nome, Estatisticas* estatisticas) {
+    unsigned int hash = hashNome(nome);
+    uint64_t prefixo = prefixoNome(nome);
+    int mascara = indice->capacidade - 1;
+    int i = (int)(hash & (unsigned int)mascara);
+    int contador = 0;
+    int encontrado = -1;
+
+    while (indice->entradas[i].posicao != HASH_VAZIO) {
+        int posicao = indice->entradas[i].posicao;
+
+        if (posicao >= 0 && indice->entradas[i].hash == hash) {
+            contador++;
+            int resultado = itens != NULL ? compararNomeChave(&itens[posicao], prefixo, nome)
+                                          : compararPrefixados(prefixos[posicao], nomes[posicao], prefixo, nome);
+            if (resultado == 0) {
+                encontrado = posicao;
+                break;
+            }
+        }
+        i = (i + 1) & mascara;
+    }
+
+    if (estatisticas != NULL) {
+        estatisticas->comparacoes += contador;
+    }
+    return encontrado;
+}
+
+/*
+ * Funcao: indiceHashBuscar
+ * Localiza um item pelo nome.
+ *
+ * Complexidade: O(1) em media
+ *
+ * Parametros:
+ *   - itens: vetor da mochila (para confirmar o nome quando o hash bate)
+ *   - estatisticas: se nao for NULL, acumula as comparacoes de nome
+ *
+ * Retorno: posicao do item se encontrado, -1 caso contrario
+ */
+int indiceHashBuscar(const IndiceHash* indice, const Item* itens, const char* nome, Estatisticas* estatisticas) {
+    return buscarEntrada(indice, itens, NULL, NULL, nome, estatisticas);
+}
+
+/*
+ * Funcao: indiceHashBuscarColunas
+ * Como indiceHashBuscar, para itens guardados em colunas: o nome e
+ * confirmado pelas colunas de prefixos e de nomes (mochila_colunar.h).
+ */
+int indiceHashBuscarColunas(const IndiceHash* indice, const uint64_t* prefixos, const char (*nomes)[TAM_NOME],
+                            const char* nome, Estatisticas* estatisticas) {
+    return buscarEntrada(indice, NULL, prefixos, nomes, nome, estatisticas);
+}
+
+/*
+ * Funcao: indiceHashRemover
+ * Remove a entrada do item (nome, posicao), deixando uma lapide.
+ *
+ * Retorno: 1 se sucesso, 0 se a entrada nao existe
+ */
+int indiceHashRemover(IndiceHash* indice, const char* nome, int posicao) {
+    int i = localizarEntrada(indice, nome, posicao);
+    if (i == -1) {
+        return 0;
+    }
+
+    indice->entradas[i].posicao = HASH_REMOVIDO;
+    indice->ocupadas--;
+    return 1;
+}
+
+/*
+ * Funcao: indiceHashMover
+ * Atualiza a posicao de um item que foi deslocado no vetor.
+ *
+ * Retorno: 1 se sucesso, 0 se a entrada nao existe
+ */
+int indiceHashMover(IndiceHash* indice, const char* nome, int antiga, int nova) {
+    int i = localizarEntrada(indice, nome, antiga);
+    if (i == -1) {
+        return 0;
+    }
+
+    indice->entradas[i].posicao = nova;
+    return 1;
+}
+
+/*
+ * Funcao: indiceHashDeslocar
+ * Soma "deslocamento" a posicao de todos os itens a partir de aPartirDe,
+ * refletindo um bloco do vetor deslocado por insercao ou remocao no meio.
+ *
+ * Complexidade: O(capacidade da tabela), sem calcular nenhum hash - mais
+ * barato que chamar indiceHashMover para cada item deslocado
+ */
+void indiceHashDeslocar(IndiceHash* indice, int aPartirDe, int deslocamento) {
+    for (int i = 0; i < indice->capacidade; i++) {
+        if (indice->entradas[i].posicao >= aPartirDe) {
+            indice->entradas[i].posicao += deslocamento;
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * LIBMOCHILA - INDICE HASH POR NOME
+ *
+ * Descricao: Tabela hash de enderecamento aberto (sondagem linear) que
+ * associa o nome de cada item a sua posicao no vetor da Mochila.
+ * Busca e remocao por nome passam a custar O(1) em media, em vez do
+ * percurso O(n) com strcmp em todos os itens. A MochilaColunar usa a
+ * mesma tabela, com os nomes confirmados nas suas colunas.
+ */
+
+#ifndef INDICE_HASH_H
+#define INDICE_HASH_H
+
+#include "estatisticas.h"
+#include "item.h"
+
+/*
+ * Struct: EntradaHash
+ * Uma posicao da tabela.
+ *
+ * Campos:
+ *   - hash: hash completo do nome (evita strcmp em colisoes)
+ *   - posicao: indice do item no vetor, HASH_VAZIO ou HASH_REMOVIDO
+ */
+typedef struct {
+    unsigned int hash;
+    int posicao;
+} EntradaHash;
+
+#define HASH_VAZIO    -1    // Posicao nunca usada: encerra a sondagem
+#define HASH_REMOVIDO -2    // Lapide: item removido, a sondagem continua
+
+/*
+ * Struct: IndiceHash
+ *
+ * Campos:
+ *   - entradas: vetor da tabela (tamanho sempre potencia de 2)
+ *   - capacidade: numero de entradas da tabela
+ *   - ocupadas: entradas que apontam para um item
+ *   - usadas: ocupadas + lapides (controla o fator de carga)
+ */
+typedef struct {
+    EntradaHash* entradas;
+    int capacidade;
+    int ocupadas;
+    int usadas;
+} IndiceHash;
+
+unsigned int hashNome(const char* nome);
+
+int indiceHashIniciar(IndiceHash* indice, int capacidade);
+void indiceHashLiberar(IndiceHash* indice);
+int indiceHashReconstruir(IndiceHash* indice, const Item* itens, int total);
+int indiceHashReconstruirNomes(IndiceHash* indice, const char (*nomes)[TAM_NOME], int total);
+int indiceHashCarregar(IndiceHash* indice, const EntradaHash* entradas, int capacidade, int totalItens);
+int indiceHashInserir(IndiceHash* indice, const char* nome, int posicao);
+int indiceHashBuscar(const IndiceHash* indice, const Item* itens, const char* nome, Estatisticas* estatisticas);
+int indiceHashBuscarColunas(const IndiceHash* indice, const uint64_t* prefixos, const char (*nomes)[TAM_NOME],
+                            const char* nome, Estatisticas* estatisticas);
+int indiceHashRemover(IndiceHash* indice, const char* nome, int posicao);
+int indiceHashMover(IndiceHash* indice, const char* nome, int antiga, int nova);
+void indiceHashDeslocar(IndiceHash* indice, int aPartirDe, int deslocamento);
+
+#endif
@@ -0,0 +1,243 @@
+/*
+ * LIBMOCHILA - INDICE ORDENADO (INDICE SECUNDARIO)
+ *
+ * Implementacao do vetor de posicoes mantido em ordem.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "indice_ordenado.h"
+#include "ordenacao.h"
+
+#define CAPACIDADE_MINIMA 16
+
+/*
+ * Funcao: compararEntrada
+ * Compara o item da posicao "a" com o da posicao "b": primeiro pelo
+ * criterio e, no empate, pela posicao.
+ */
+static int compararEntrada(const IndiceOrdenado* indice, const Item* itens, int a, int b) {
+    int resultado = compararItens(&itens[a], &itens[b], indice->criterio);
+    if (resultado != 0) {
+        return resultado;
+    }
+    return (a > b) - (a < b);
+}
+
+/*
+ * Funcao: localizar
+ * Busca binaria pelo lugar da posicao informada no indice: a primeira
+ * entrada que nao vem antes dela.
+ */
+static int localizar(const IndiceOrdenado* indice, const Item* itens, int posicao) {
+    int esquerda = 0;
+    int direita = indice->total;
+
+    while (esquerda < direita) {
+        int meio = esquerda + (direita - esquerda) / 2;
+        if (compararEntrada(indice, itens, indice->ordem[meio], posicao) < 0) {
+            esquerda = meio + 1;
+        } else {
+            direita = meio;
+        }
+    }
+
+    return esquerda;
+}
+
+/*
+ * Funcao: indiceOrdenadoIniciar
+ * Inicializa um indice vazio para o criterio informado (nada e alocado).
+ */
+void indiceOrdenadoIniciar(IndiceOrdenado* indice, CriterioOrdenacao criterio) {
+    indice->ordem = NULL;
+    indice->total = 0;
+    indice->capacidade = 0;
+    indice->criterio = criterio;
+}
+
+/*
+ * Funcao: indiceOrdenadoLiberar
+ * Libera o vetor de posicoes.
+ */
+void indiceOrdenadoLiberar(IndiceOrdenado* indice) {
+    free(indice->ordem);
+    indice->ordem = NULL;
+    indice->total = 0;
+    indice->capacidade = 0;
+}
+
+/*
+ * Funcao: indiceOrdenadoReservar
+ * Garante espaco para ao menos "capacidade" entradas (dobrando a
+ * alocacao), para que as insercoes seguintes nao precisem alocar.
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (o indice continua valido)
+ */
+int indiceOrdenadoReservar(IndiceOrdenado* indice, int capacidade) {
+    if (capacidade <= indice->capacidade) {
+        return 1;
+    }
+
+    int nova = indice->capacidade > 0 ? indice->capacidade : CAPACIDADE_MINIMA;
+    while (nova < capacidade) {
+        nova *= 2;
+    }
+
+    int* ordem = (int*)realloc(indice->ordem, sizeof(int) * (size_t)nova);
+    if (ordem == NULL) {
+        return 0;
+    }
+
+    indice->ordem = ordem;
+    indice->capacidade = nova;
+    return 1;
+}
+
+/*
+ * Funcao: indiceOrdenadoReconstruir
+ * Refaz o indice a partir do vetor de itens, ignorando as posicoes
+ * marcadas em lapides (pode ser NULL). Usado depois de operacoes que
+ * movem muitos itens de uma vez (ordenacao, compactacao).
+ *
+ * Complexidade: Radix Sort das posicoes (nome) ou Counting/Merge Sort
+ * (tipo e prioridade); todos estaveis, e como partem das posicoes em ordem
+ * crescente, os empates ja saem por posicao
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int indiceOrdenadoReconstruir(IndiceOrdenado* indice, const Item* itens, int total,
+                              const unsigned char* lapides) {
+    if (!indiceOrdenadoReservar(indice, total)) {
+        return 0;
+    }
+
+    indice->total = 0;
+    for (int i = 0; i < total; i++) {
+        if (lapides == NULL || !lapides[i]) {
+            indice->ordem[indice->total++] = i;
+        }
+    }
+
+    AlgoritmoOrdenacao algoritmo = indice->criterio == NOME ? RADIX_SORT : COUNTING_SORT;
+    ordenarIndices(itens, indice->ordem, indice->total, indice->criterio, algoritmo, NULL);
+    return 1;
+}
+
+/*
+ * Funcao: indiceOrdenadoCarregar
+ * Substitui o indice por uma copia das posicoes gravadas num snapshot
+ * (snapshot.h), sem reordenar.
+ *
+ * Complexidade: O(total)
+ *
+ * Retorno: 1 se sucesso, 0 se alguma posicao esta fora de 0..total-1 ou
+ *          faltou memoria
+ */
+int indiceOrdenadoCarregar(IndiceOrdenado* indice, const int* ordem, int total) {
+    if (!indiceOrdenadoReservar(indice, total)) {
+        return 0;
+    }
+
+    if (total > 0) {
+        memcpy(indice->ordem, ordem, sizeof(int) * (size_t)total);
+    }
+    for (int i = 0; i < total; i++) {
+        if (indice->ordem[i] < 0 || indice->ordem[i] >= total) {
+            indice->total = 0;
+            return 0;
+        }
+    }
+    indice->total = total;
+    return 1;
+}
+
+/*
+ * Funcao: indiceOrdenadoInserir
+ * Registra o item que acabou de ser gravado em itens[posicao].
+ * Supoe espaco reservado (indiceOrdenadoReservar).
+ *
+ * Complexidade: O(log n) comparacoes + deslocamento O(n) de ints
+ */
+void indiceOrdenadoInserir(IndiceOrdenado* indice, const Item* itens, int posicao) {
+    int lugar = localizar(indice, itens, posicao);
+
+    memmove(&indice->ordem[lugar + 1], &indice->ordem[lugar],
+            sizeof(int) * (size_t)(indice->total - lugar));
+    indice->ordem[lugar] = posicao;
+    indice->total++;
+}
+
+/*
+ * Funcao: indiceOrdenadoRemover
+ * Retira a entrada de itens[posicao]. Deve ser chamada antes de o item
+ * ser sobrescrito, pois a busca usa o conteudo dele.
+ *
+ * Complexidade: O(log n) comparacoes + deslocamento O(n) de ints
+ */
+void indiceOrdenadoRemover(IndiceOrdenado* indice, const Item* itens, int posicao) {
+    int lugar = localizar(indice, itens, posicao);
+    if (lugar >= indice->total || indice->ordem[lugar] != posicao) {
+        return;
+    }
+
+    memmove(&indice->ordem[lugar], &indice->ordem[lugar + 1],
+            sizeof(int) * (size_t)(indice->total - lugar - 1));
+    indice->total--;
+}
+
+/*
+ * Funcao: indiceOrdenadoDeslocar
+ * Soma "deslocamento" as posicoes a partir de aPartirDe, refletindo um
+ * bloco do vetor de itens deslocado. A ordem relativa das posicoes nao
+ * muda, entao o indice continua ordenado.
+ */
+void indiceOrdenadoDeslocar(IndiceOrdenado* indice, int aPartirDe, int deslocamento) {
+    for (int i = 0; i < indice->total; i++) {
+        if (indice->ordem[i] >= aPartirDe) {
+            indice->ordem[i] += deslocamento;
+        }
+    }
+}
+
+/*
+ * Funcao: indiceOrdenadoBuscarNome
+ * Busca binaria por nome num indice de criterio NOME.
+ *
+ * Complexidade: O(log n)
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, acumula as comparacoes de nome
+ *
+ * Retorno: posicao do item no vetor de itens, -1 se nao encontrado
+ */
+int indiceOrdenadoBuscarNome(const IndiceOrdenado* indice, const Item* itens, const char* nome,
+                             Estatisticas* estatisticas) {
+    uint64_t prefixo = prefixoNome(nome);
+    int esquerda = 0;
+    int direita = indice->total - 1;
+    int contador = 0;
+    int encontrado = -1;
+
+    while (esquerda <= direita) {
+        int meio = esquerda + (direita - esquerda) / 2;
+        contador++;
+
+        int resultado = compararNomeChave(&itens[indice->ordem[meio]], prefixo, nome);
+
+        if (resultado == 0) {
+            encontrado = indice->ordem[meio];
+            break;
+        } else if (resultado < 0) {
+            esquerda = meio + 1;
+        } else {
+            direita = meio - 1;
+        }
+    }
+
+    if (estatisticas != NULL) {
+        estatisticas->comparacoes += contador;
+    }
+    return encontrado;
+}
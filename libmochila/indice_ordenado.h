@@ -0,0 +1,49 @@
+/*
+ * LIBMOCHILA - INDICE ORDENADO (INDICE SECUNDARIO)
+ *
+ * Descricao: Vetor com as posicoes dos itens vivos da Mochila, mantido em
+ * ordem por um CriterioOrdenacao. A Mochila guarda um indice por criterio
+ * (nome, tipo e prioridade), atualizados a cada insercao e remocao, de
+ * forma que listar em qualquer ordem ou fazer busca binaria por nome nao
+ * exige reordenar os itens.
+ *
+ * Itens empatados no criterio ficam em ordem de posicao no vetor da
+ * Mochila; assim cada entrada tem um lugar exato e pode ser localizada
+ * por busca binaria mesmo com muitos empates (ex.: prioridade).
+ */
+
+#ifndef INDICE_ORDENADO_H
+#define INDICE_ORDENADO_H
+
+#include "estatisticas.h"
+#include "item.h"
+
+/*
+ * Struct: IndiceOrdenado
+ *
+ * Campos:
+ *   - ordem: posicoes dos itens, em ordem de (criterio, posicao)
+ *   - total: entradas em uso
+ *   - capacidade: entradas alocadas
+ *   - criterio: criterio que define a ordem
+ */
+typedef struct {
+    int* ordem;
+    int total;
+    int capacidade;
+    CriterioOrdenacao criterio;
+} IndiceOrdenado;
+
+void indiceOrdenadoIniciar(IndiceOrdenado* indice, CriterioOrdenacao criterio);
+void indiceOrdenadoLiberar(IndiceOrdenado* indice);
+int indiceOrdenadoReservar(IndiceOrdenado* indice, int capacidade);
+int indiceOrdenadoReconstruir(IndiceOrdenado* indice, const Item* itens, int total,
+                              const unsigned char* lapides);
+int indiceOrdenadoCarregar(IndiceOrdenado* indice, const int* ordem, int total);
+void indiceOrdenadoInserir(IndiceOrdenado* indice, const Item* itens, int posicao);
+void indiceOrdenadoRemover(IndiceOrdenado* indice, const Item* itens, int posicao);
+void indiceOrdenadoDeslocar(IndiceOrdenado* indice, int aPartirDe, int deslocamento);
+int indiceOrdenadoBuscarNome(const IndiceOrdenado* indice, const Item* itens, const char* nome,
+                             Estatisticas* estatisticas);
+
+#endif
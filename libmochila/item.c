@@ -0,0 +1,121 @@
+/*
+ * LIBMOCHILA - ITEM DO INVENTARIO
+ *
+ * Comparacao de itens pelos criterios de ordenacao e prefixo do nome
+ * usado para acelerar as comparacoes de texto.
+ */
+
+#include <string.h>
+
+#include "item.h"
+
+// ============================================================================
+// PREFIXO DO NOME
+// ============================================================================
+
+/*
+ * Funcao: prefixoNome
+ * Empacota os primeiros TAM_PREFIXO bytes do nome num inteiro de 64 bits,
+ * o primeiro byte na posicao mais significativa (big-endian). Os bytes
+ * depois do fim do nome ficam zerados.
+ *
+ * Como o strcmp compara os bytes como unsigned char, da esquerda para a
+ * direita, comparar dois prefixos como inteiros da o mesmo resultado que
+ * comparar os 8 primeiros caracteres com strcmp.
+ */
+uint64_t prefixoNome(const char* nome) {
+    uint64_t prefixo = 0;
+    int i = 0;
+
+    for (; i < TAM_PREFIXO && nome[i] != '\0'; i++) {
+        prefixo = (prefixo << 8) | (unsigned char)nome[i];
+    }
+    for (; i < TAM_PREFIXO; i++) {
+        prefixo <<= 8;
+    }
+
+    return prefixo;
+}
+
+/*
+ * Funcao: itemAtualizarPrefixo
+ * Recalcula o prefixo a partir do nome. A mochila e as listas fazem isso
+ * ao inserir; quem ordena um vetor proprio com ordenarItens por NOME deve
+ * chamar esta funcao antes, para cada item.
+ */
+void itemAtualizarPrefixo(Item* item) {
+    item->prefixoNome = prefixoNome(item->nome);
+}
+
+/*
+ * Funcao: compararPrefixados
+ * Compara dois nomes cujos prefixos ja sao conhecidos. A maioria dos
+ * pares se resolve com uma comparacao de inteiros. Nos empates, se o
+ * ultimo byte do prefixo e zero o nome terminou dentro dele e os dois sao
+ * iguais; senao ambos tem ao menos TAM_PREFIXO bytes e o strcmp continua
+ * dali.
+ *
+ * Retorno: mesmo sinal de strcmp(a, b)
+ */
+int compararPrefixados(uint64_t prefixoA, const char* a, uint64_t prefixoB, const char* b) {
+#ifdef SEM_PREFIXO_NOME
+    (void)prefixoA;
+    (void)prefixoB;
+    return strcmp(a, b);
+#else
+    if (prefixoA != prefixoB) {
+        return prefixoA < prefixoB ? -1 : 1;
+    }
+    if ((prefixoA & 0xFF) == 0) {
+        return 0;
+    }
+    return strcmp(a + TAM_PREFIXO, b + TAM_PREFIXO);
+#endif
+}
+
+/*
+ * Funcao: compararNomes
+ * Compara os nomes de dois itens pelo prefixo (strcmp so nos empates).
+ *
+ * Retorno: mesmo sinal de strcmp(a->nome, b->nome)
+ */
+int compararNomes(const Item* a, const Item* b) {
+    return compararPrefixados(a->prefixoNome, a->nome, b->prefixoNome, b->nome);
+}
+
+/*
+ * Funcao: compararNomeChave
+ * Compara o nome de um item com uma chave de busca cujo prefixo
+ * (prefixoNome(nome)) foi calculado uma unica vez pelo chamador.
+ *
+ * Retorno: mesmo sinal de strcmp(item->nome, nome)
+ */
+int compararNomeChave(const Item* item, uint64_t prefixo, const char* nome) {
+    return compararPrefixados(item->prefixoNome, item->nome, prefixo, nome);
+}
+
+// ============================================================================
+// CRITERIOS DE ORDENACAO
+// ============================================================================
+
+/*
+ * Funcao: compararItens
+ * Compara dois itens segundo o criterio informado.
+ *
+ * Retorno: valor negativo se a vem antes de b, zero se empatam e
+ *          positivo se a vem depois de b. PRIORIDADE e decrescente
+ *          (maior prioridade primeiro). TIPO compara as posicoes
+ *          alfabeticas do dicionario de tipos (inteiros), o que da a
+ *          mesma ordem que comparar os nomes.
+ */
+int compararItens(const Item* a, const Item* b, CriterioOrdenacao criterio) {
+    switch (criterio) {
+        case NOME:
+            return compararNomes(a, b);
+        case TIPO:
+            return tipoPosicao(a->idTipo) - tipoPosicao(b->idTipo);
+        case PRIORIDADE:
+            return b->prioridade - a->prioridade;
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * LIBMOCHILA - ITEM DO INVENTARIO
+ *
+ * Descricao: Definicao do Item e dos criterios de comparacao, comuns a
+ * todas as estruturas da biblioteca (vetor, lista e indices).
+ */
+
+#ifndef ITEM_H
+#define ITEM_H
+
+#include <stdint.h>
+
+#include "tipos.h"
+
+// ============================================================================
+// DEFINICAO DE CONSTANTES
+// ============================================================================
+
+#define TAM_NOME 30         // Tamanho maximo do nome do item
+#define TAM_PREFIXO 8       // Bytes do nome guardados em prefixoNome
+
+/*
+ * Struct: Item
+ * Representa um item (ou componente) do inventario.
+ *
+ * Campos:
+ *   - prefixoNome: os 8 primeiros bytes do nome em big-endian (ver
+ *                  prefixoNome), preenchido pela biblioteca ao inserir.
+ *                  Comparar prefixos como inteiros da a mesma ordem do
+ *                  strcmp, que so e chamado quando os prefixos empatam
+ *   - nome: identificador do item (ex: "AK-47", "Kit Medico")
+ *   - idTipo: categoria do item (arma, municao, cura, ferramenta...),
+ *             como id do dicionario de tipos (tipoRegistrar/tipoNome).
+ *             Ocupa 2 bytes em vez de 20
+ *   - quantidade: numero de unidades deste item
+ *   - prioridade: importancia do item (0 quando o programa nao usa)
+ */
+typedef struct {
+    uint64_t prefixoNome;
+    char nome[TAM_NOME];
+    unsigned short idTipo;
+    int quantidade;
+    int prioridade;
+} Item;
+
+/*
+ * Enum: CriterioOrdenacao
+ * Criterios possiveis para ordenacao (nome, tipo ou prioridade).
+ * NOME e TIPO usam ordem alfabetica; PRIORIDADE usa ordem decrescente.
+ */
+typedef enum {
+    NOME,
+    TIPO,
+    PRIORIDADE
+} CriterioOrdenacao;
+
+#define TOTAL_CRITERIOS 3   // Quantidade de valores de CriterioOrdenacao
+
+uint64_t prefixoNome(const char* nome);
+void itemAtualizarPrefixo(Item* item);
+int compararPrefixados(uint64_t prefixoA, const char* a, uint64_t prefixoB, const char* b);
+int compararNomes(const Item* a, const Item* b);
+int compararNomeChave(const Item* item, uint64_t prefixo, const char* nome);
+int compararItens(const Item* a, const Item* b, CriterioOrdenacao criterio);
+
+#endif
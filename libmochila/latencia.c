@@ -0,0 +1,244 @@
+/*
+ * LIBMOCHILA - HISTOGRAMAS DE LATENCIA
+ *
+ * Implementacao dos histogramas por operacao e da exportacao em CSV.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cronometro.h"
+#include "latencia.h"
+
+#define CALIBRAGEM_NS 20000000ULL  // 20 ms para medir ticks por nanossegundo
+
+// Incremento sem ordem de memoria: varias threads podem registrar ao
+// mesmo tempo, e a exportacao tolera uma contagem em andamento
+#if defined(__GNUC__)
+#define SOMAR_RELAXADO(destino, valor) __atomic_fetch_add(&(destino), (valor), __ATOMIC_RELAXED)
+#define LER_RELAXADO(origem) __atomic_load_n(&(origem), __ATOMIC_RELAXED)
+#else
+#define SOMAR_RELAXADO(destino, valor) ((destino) += (valor))
+#define LER_RELAXADO(origem) (origem)
+#endif
+
+static uint64_t baldes[TOTAL_LATENCIAS][BALDES_LATENCIA];
+static uint64_t somaTicks[TOTAL_LATENCIAS];
+
+// Suspensoes por thread: uma medicao (ou reaplicacao do diario) numa
+// thread nao apaga o que as outras registram no mesmo periodo
+#if defined(__GNUC__)
+static __thread int suspensoes = 0;
+#else
+static int suspensoes = 0;
+#endif
+
+static const char* nomes[TOTAL_LATENCIAS] = {
+    "inserir", "remover", "buscar", "busca_sequencial", "busca_binaria", "ordenar",
+    "alterar_quantidade", "lista_inserir", "lista_remover", "lista_buscar",
+    "desenrolada_inserir", "desenrolada_remover", "desenrolada_buscar"
+};
+
+// ============================================================================
+// REGISTRO
+// ============================================================================
+
+/*
+ * Funcao: latenciaMarcar
+ * Leitura do relogio no inicio de uma operacao (ticks do contador de
+ * ciclos ou nanossegundos; ver latenciaRegistrar).
+ */
+uint64_t latenciaMarcar(void) {
+#if CRONOMETRO_TEM_CICLOS
+    return cronometroCiclos();
+#else
+    return cronometroNs();
+#endif
+}
+
+/*
+ * Funcao: balde
+ * Balde de uma duracao: 0 para 0 ticks, senao o numero de bits
+ * significativos (1 tick -> 1, 2-3 -> 2, 4-7 -> 3...).
+ */
+static int balde(uint64_t ticks) {
+    if (ticks == 0) {
+        return 0;
+    }
+#if defined(__GNUC__)
+    int b = 64 - __builtin_clzll(ticks);
+#else
+    int b = 0;
+    while (ticks != 0) {
+        ticks >>= 1;
+        b++;
+    }
+#endif
+    return b < BALDES_LATENCIA ? b : BALDES_LATENCIA - 1;
+}
+
+/*
+ * Funcao: latenciaRegistrar
+ * Conta uma execucao da operacao iniciada em 'inicio' (latenciaMarcar).
+ *
+ * Complexidade: O(1), sem travas
+ */
+void latenciaRegistrar(OperacaoLatencia operacao, uint64_t inicio) {
+    uint64_t ticks = latenciaMarcar() - inicio;
+
+    if (suspensoes > 0) {
+        return;
+    }
+    SOMAR_RELAXADO(baldes[operacao][balde(ticks)], 1);
+    SOMAR_RELAXADO(somaTicks[operacao], ticks);
+}
+
+/*
+ * Funcao: latenciaSuspender
+ * Suspende (ou retoma) o registro na thread que chama. Usada por
+ * cronometroMedir, cujas repeticoes artificiais nao devem entrar na
+ * sessao, e pela reaplicacao do diario (diario.h). As chamadas podem ser
+ * aninhadas.
+ */
+void latenciaSuspender(bool suspender) {
+    suspensoes += suspender ? 1 : -1;
+}
+
+/*
+ * Funcao: latenciaZerar
+ * Descarta tudo o que foi registrado.
+ */
+void latenciaZerar(void) {
+    memset(baldes, 0, sizeof(baldes));
+    memset(somaTicks, 0, sizeof(somaTicks));
+}
+
+// ============================================================================
+// CONSULTA E EXPORTACAO
+// ============================================================================
+
+const char* nomeLatencia(OperacaoLatencia operacao) {
+    return operacao < TOTAL_LATENCIAS ? nomes[operacao] : "desconhecida";
+}
+
+/*
+ * Funcao: nsPorTick
+ * Duracao de um tick em nanossegundos. Com contador de ciclos, e medida
+ * uma vez contra o relogio monotono (CALIBRAGEM_NS de espera ativa).
+ */
+static double nsPorTick(void) {
+#if CRONOMETRO_TEM_CICLOS
+    static double calibrado = 0.0;
+
+    if (calibrado == 0.0) {
+        uint64_t t0 = cronometroNs();
+        uint64_t c0 = cronometroCiclos();
+        uint64_t t1 = t0;
+        while (t1 - t0 < CALIBRAGEM_NS) {
+            t1 = cronometroNs();
+        }
+        uint64_t c1 = cronometroCiclos();
+        calibrado = c1 > c0 ? (double)(t1 - t0) / (double)(c1 - c0) : 1.0;
+    }
+    return calibrado;
+#else
+    return 1.0;
+#endif
+}
+
+/*
+ * Funcao: limiteSuperior
+ * Maior duracao (em ticks) contada no balde b.
+ */
+static double limiteSuperior(int b) {
+    return b == 0 ? 0.0 : (double)((2ULL << (b - 1)) - 1);
+}
+
+static double limiteInferior(int b) {
+    return b == 0 ? 0.0 : (double)(1ULL << (b - 1));
+}
+
+/*
+ * Funcao: latenciaResumo
+ * Contagem, media e percentis da operacao.
+ *
+ * Complexidade: O(BALDES_LATENCIA)
+ */
+ResumoLatencia latenciaResumo(OperacaoLatencia operacao) {
+    ResumoLatencia resumo = {0, 0.0, 0.0, 0.0, 0.0};
+    uint64_t copia[BALDES_LATENCIA];
+
+    for (int b = 0; b < BALDES_LATENCIA; b++) {
+        copia[b] = LER_RELAXADO(baldes[operacao][b]);
+        resumo.contagem += copia[b];
+    }
+    if (resumo.contagem == 0) {
+        return resumo;
+    }
+
+    double escala = nsPorTick();
+    uint64_t acumulado = 0;
+    uint64_t alvo50 = (resumo.contagem + 1) / 2;
+    uint64_t alvo99 = resumo.contagem - resumo.contagem / 100;
+
+    for (int b = 0; b < BALDES_LATENCIA; b++) {
+        if (copia[b] == 0) {
+            continue;
+        }
+        acumulado += copia[b];
+        if (resumo.p50Ns == 0.0 && acumulado >= alvo50) {
+            resumo.p50Ns = limiteSuperior(b) * escala;
+        }
+        if (resumo.p99Ns == 0.0 && acumulado >= alvo99) {
+            resumo.p99Ns = limiteSuperior(b) * escala;
+        }
+        resumo.maximoNs = limiteSuperior(b) * escala;
+    }
+    resumo.mediaNs = (double)LER_RELAXADO(somaTicks[operacao]) * escala / (double)resumo.contagem;
+    return resumo;
+}
+
+/*
+ * Funcao: latenciaSalvar
+ * Grava os histogramas em CSV, uma linha por balde nao vazio:
+ *
+ *   operacao,min_ns,max_ns,contagem
+ *
+ * Retorno: 1 se sucesso, 0 se o arquivo nao pode ser gravado
+ */
+int latenciaSalvar(const char* caminho) {
+    FILE* arquivo = fopen(caminho, "w");
+    if (arquivo == NULL) {
+        return 0;
+    }
+
+    double escala = nsPorTick();
+    fprintf(arquivo, "operacao,min_ns,max_ns,contagem\n");
+    for (int op = 0; op < TOTAL_LATENCIAS; op++) {
+        for (int b = 0; b < BALDES_LATENCIA; b++) {
+            uint64_t contagem = LER_RELAXADO(baldes[op][b]);
+            if (contagem > 0) {
+                fprintf(arquivo, "%s,%.1f,%.1f,%llu\n", nomes[op], limiteInferior(b) * escala,
+                        limiteSuperior(b) * escala, (unsigned long long)contagem);
+            }
+        }
+    }
+
+    return fclose(arquivo) == 0;
+}
+
+/*
+ * Funcao: latenciaSalvarSeConfigurado
+ * Grava os histogramas no arquivo indicado pela variavel de ambiente
+ * MOCHILA_LATENCIAS, se ela existir. Chamada pelos programas ao sair.
+ *
+ * Retorno: 1 se gravou, 0 se a variavel nao existe ou a gravacao falhou
+ */
+int latenciaSalvarSeConfigurado(void) {
+    const char* caminho = getenv(VARIAVEL_LATENCIAS);
+    if (caminho == NULL || caminho[0] == '\0') {
+        return 0;
+    }
+    return latenciaSalvar(caminho);
+}
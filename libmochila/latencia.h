@@ -0,0 +1,80 @@
+/*
+ * LIBMOCHILA - HISTOGRAMAS DE LATENCIA
+ *
+ * Descricao: Latencia de cada operacao da Mochila (insercao, remocao,
+ * troca de quantidade, buscas e ordenacao) e das listas (lista.h e
+ * lista_desenrolada.h) acumulada durante toda a sessao, para responder
+ * "qual e o p99 das buscas" e nao so "quanto levou a ultima".
+ *
+ * Cada operacao tem um histograma com baldes em potencias de 2: o balde
+ * b conta as execucoes que levaram de 2^(b-1) a 2^b - 1 ticks. Registrar
+ * custa duas leituras do contador de ciclos (relogio monotono onde nao
+ * houver contador) e dois incrementos atomicos relaxados, entao pode
+ * ficar sempre ligado. Ticks sao convertidos para nanossegundos so ao
+ * exportar.
+ *
+ * Os histogramas sao globais ao processo (como o dicionario de tipos):
+ * todas as mochilas alimentam os mesmos contadores. A suspensao
+ * (latenciaSuspender) vale so para a thread que a pediu.
+ */
+
+#ifndef LATENCIA_H
+#define LATENCIA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BALDES_LATENCIA 64
+#define VARIAVEL_LATENCIAS "MOCHILA_LATENCIAS"  // Arquivo CSV gravado ao sair
+
+/*
+ * Enum: OperacaoLatencia
+ * Operacoes com histograma proprio. As da Mochila vem primeiro; cada
+ * lista tem os seus, para que uma nao dilua os percentis da outra.
+ */
+typedef enum {
+    LATENCIA_INSERIR,
+    LATENCIA_REMOVER,
+    LATENCIA_BUSCAR,             // Indice hash
+    LATENCIA_BUSCA_SEQUENCIAL,
+    LATENCIA_BUSCA_BINARIA,
+    LATENCIA_ORDENAR,
+    LATENCIA_ALTERAR_QUANTIDADE,
+    LATENCIA_LISTA_INSERIR,      // Lista encadeada (lista.h)
+    LATENCIA_LISTA_REMOVER,
+    LATENCIA_LISTA_BUSCAR,
+    LATENCIA_DESENROLADA_INSERIR,  // Lista desenrolada (lista_desenrolada.h)
+    LATENCIA_DESENROLADA_REMOVER,
+    LATENCIA_DESENROLADA_BUSCAR,
+    TOTAL_LATENCIAS
+} OperacaoLatencia;
+
+/*
+ * Struct: ResumoLatencia
+ * Resumo de um histograma, em nanossegundos. Os percentis sao o limite
+ * superior do balde onde caem (precisao de um fator 2).
+ *
+ * Campos:
+ *   - contagem: execucoes registradas
+ *   - mediaNs: tempo medio
+ *   - p50Ns / p99Ns / maximoNs: limites superiores dos baldes
+ */
+typedef struct {
+    uint64_t contagem;
+    double mediaNs;
+    double p50Ns;
+    double p99Ns;
+    double maximoNs;
+} ResumoLatencia;
+
+uint64_t latenciaMarcar(void);
+void latenciaRegistrar(OperacaoLatencia operacao, uint64_t inicio);
+void latenciaSuspender(bool suspender);
+void latenciaZerar(void);
+
+const char* nomeLatencia(OperacaoLatencia operacao);
+ResumoLatencia latenciaResumo(OperacaoLatencia operacao);
+int latenciaSalvar(const char* caminho);
+int latenciaSalvarSeConfigurado(void);
+
+#endif
@@ -0,0 +1,200 @@
+/*
+ * LIBMOCHILA - LISTA ENCADEADA
+ *
+ * Implementacao das operacoes de insercao, remocao, busca e percurso
+ * sobre a lista encadeada de itens.
+ */
+
+#include "latencia.h"
+#include "lista.h"
+
+#define NOS_POR_SLAB_INICIAL 32
+
+/*
+ * Funcao: listaIniciar
+ * Inicializa uma lista vazia.
+ */
+void listaIniciar(Lista* lista) {
+    lista->inicio = NULL;
+    lista->fim = NULL;
+    lista->total = 0;
+    poolIniciar(&lista->nos, sizeof(No), NOS_POR_SLAB_INICIAL);
+}
+
+/*
+ * Funcao: listaLiberar
+ * Libera toda a memoria alocada pela lista encadeada.
+ *
+ * Importante: sempre liberar a memoria ao final do programa
+ * para evitar memory leaks!
+ *
+ * Complexidade: O(numero de slabs) - os nos nao sao percorridos, o pool
+ * devolve os blocos grandes de uma vez
+ */
+void listaLiberar(Lista* lista) {
+    poolLiberar(&lista->nos);
+
+    lista->inicio = NULL;
+    lista->fim = NULL;
+    lista->total = 0;
+}
+
+// Corpo de listaInserir, que mede a latencia (latencia.h)
+static int inserir(Lista* lista, Item item) {
+    No* novoNo = (No*)poolAlocar(&lista->nos);
+    if (novoNo == NULL) {
+        return 0;
+    }
+
+    novoNo->dados = item;
+    itemAtualizarPrefixo(&novoNo->dados);
+    novoNo->proximo = NULL;
+
+    // Se a lista esta vazia, o novo no e o primeiro
+    if (lista->inicio == NULL) {
+        lista->inicio = novoNo;
+    } else {
+        lista->fim->proximo = novoNo;
+    }
+    lista->fim = novoNo;
+
+    lista->total++;
+    return 1;
+}
+
+/*
+ * Funcao: listaInserir
+ * Insere um novo item no final da lista encadeada.
+ *
+ * Complexidade: O(1) - o ponteiro "fim" evita percorrer a lista e o no
+ * vem do pool, sem malloc por insercao
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int listaInserir(Lista* lista, Item item) {
+    uint64_t inicio = latenciaMarcar();
+    int resultado = inserir(lista, item);
+    latenciaRegistrar(LATENCIA_LISTA_INSERIR, inicio);
+    return resultado;
+}
+
+/*
+ * Funcao: listaInserirLote
+ * Insere varios itens no final da lista, na ordem do vetor recebido
+ * (carga em massa, ex: importacao.h). A latencia nao e registrada item
+ * a item.
+ *
+ * Complexidade: O(total) - um no do pool por item
+ *
+ * Retorno: quantos itens foram inseridos (menos que 'total' so se faltou
+ * memoria)
+ */
+int listaInserirLote(Lista* lista, const Item* itens, int total) {
+    int inseridos = 0;
+    while (inseridos < total && inserir(lista, itens[inseridos])) {
+        inseridos++;
+    }
+    return inseridos;
+}
+
+// Corpo de listaRemover, que mede a latencia (latencia.h)
+static int remover(Lista* lista, const char* nome) {
+    uint64_t prefixo = prefixoNome(nome);
+    No* atual = lista->inicio;
+    No* anterior = NULL;
+
+    // Busca o no a ser removido
+    while (atual != NULL && compararNomeChave(&atual->dados, prefixo, nome) != 0) {
+        anterior = atual;
+        atual = atual->proximo;
+    }
+
+    if (atual == NULL) {
+        return 0;
+    }
+
+    // Se e o primeiro no
+    if (anterior == NULL) {
+        lista->inicio = atual->proximo;
+    } else {
+        anterior->proximo = atual->proximo;
+    }
+
+    // Se era o ultimo no, o anterior passa a ser o fim
+    if (lista->fim == atual) {
+        lista->fim = anterior;
+    }
+
+    poolDevolver(&lista->nos, atual);
+    lista->total--;
+    return 1;
+}
+
+/*
+ * Funcao: listaRemover
+ * Remove um item da lista encadeada pelo nome.
+ *
+ * Complexidade: O(n) - busca pelo elemento
+ *
+ * Retorno: 1 se sucesso, 0 se nao encontrado
+ */
+int listaRemover(Lista* lista, const char* nome) {
+    uint64_t inicio = latenciaMarcar();
+    int resultado = remover(lista, nome);
+    latenciaRegistrar(LATENCIA_LISTA_REMOVER, inicio);
+    return resultado;
+}
+
+// Corpo de listaBuscar, que mede a latencia (latencia.h)
+static No* buscar(const Lista* lista, const char* nome, Estatisticas* estatisticas) {
+    uint64_t prefixo = prefixoNome(nome);
+    int contador = 0;
+    No* atual = lista->inicio;
+
+    while (atual != NULL) {
+        contador++;
+        if (compararNomeChave(&atual->dados, prefixo, nome) == 0) {
+            break;
+        }
+        atual = atual->proximo;
+    }
+
+    if (estatisticas != NULL) {
+        estatisticas->comparacoes += contador;
+    }
+    return atual;
+}
+
+/*
+ * Funcao: listaBuscar
+ * Realiza busca sequencial na lista encadeada.
+ *
+ * Complexidade: O(n) - precisa percorrer os nos sequencialmente
+ * Nota: Lista encadeada NAO permite busca binaria!
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, acumula as comparacoes feitas
+ *
+ * Retorno: ponteiro para o no se encontrado, NULL caso contrario
+ */
+No* listaBuscar(const Lista* lista, const char* nome, Estatisticas* estatisticas) {
+    uint64_t inicio = latenciaMarcar();
+    No* resultado = buscar(lista, nome, estatisticas);
+    latenciaRegistrar(LATENCIA_LISTA_BUSCAR, inicio);
+    return resultado;
+}
+
+/*
+ * Funcao: listaPercorrer
+ * Visita todos os itens da lista, do inicio ao fim.
+ */
+void listaPercorrer(const Lista* lista,
+                    void (*visitar)(const Item* item, int posicao, void* contexto),
+                    void* contexto) {
+    int posicao = 0;
+
+    for (No* atual = lista->inicio; atual != NULL; atual = atual->proximo) {
+        visitar(&atual->dados, posicao, contexto);
+        posicao++;
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * LIBMOCHILA - LISTA ENCADEADA
+ *
+ * Descricao: Inventario em lista encadeada simples, usado pelo nivel
+ * aventureiro para comparar com o vetor sequencial da Mochila.
+ */
+
+#ifndef LISTA_H
+#define LISTA_H
+
+#include "estatisticas.h"
+#include "item.h"
+#include "pool.h"
+
+/*
+ * Struct: No
+ * Representa um no da lista encadeada.
+ *
+ * Campos:
+ *   - dados: estrutura Item contendo os dados do inventario
+ *   - proximo: ponteiro para o proximo no da lista
+ */
+typedef struct No {
+    Item dados;
+    struct No* proximo;
+} No;
+
+/*
+ * Struct: Lista
+ * Cabecalho da lista encadeada.
+ *
+ * Campos:
+ *   - inicio: primeiro no da lista (NULL se vazia)
+ *   - fim: ultimo no da lista, para inserir no final em O(1)
+ *   - total: quantidade de nos
+ *   - nos: pool de onde os nos sao alocados (ver pool.h)
+ */
+typedef struct {
+    No* inicio;
+    No* fim;
+    int total;
+    Pool nos;
+} Lista;
+
+void listaIniciar(Lista* lista);
+void listaLiberar(Lista* lista);
+int listaInserir(Lista* lista, Item item);
+int listaInserirLote(Lista* lista, const Item* itens, int total);
+int listaRemover(Lista* lista, const char* nome);
+No* listaBuscar(const Lista* lista, const char* nome, Estatisticas* estatisticas);
+void listaPercorrer(const Lista* lista,
+                    void (*visitar)(const Item* item, int posicao, void* contexto),
+                    void* contexto);
+
+#endif
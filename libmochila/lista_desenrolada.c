@@ -0,0 +1,265 @@
+/*
+ * LIBMOCHILA - LISTA ENCADEADA DESENROLADA
+ *
+ * Implementacao das operacoes de insercao, remocao, busca e percurso
+ * sobre a lista de blocos de itens.
+ */
+
+#include <string.h>
+
+#include "latencia.h"
+#include "lista_desenrolada.h"
+
+#define BLOCOS_POR_SLAB_INICIAL 8
+
+/*
+ * Funcao: desenroladaIniciar
+ * Inicializa uma lista desenrolada vazia.
+ */
+void desenroladaIniciar(ListaDesenrolada* lista) {
+    lista->inicio = NULL;
+    lista->fim = NULL;
+    lista->total = 0;
+    lista->blocos = 0;
+    poolIniciar(&lista->pool, sizeof(BlocoItens), BLOCOS_POR_SLAB_INICIAL);
+}
+
+/*
+ * Funcao: desenroladaLiberar
+ * Libera todos os blocos de uma vez (via pool).
+ */
+void desenroladaLiberar(ListaDesenrolada* lista) {
+    poolLiberar(&lista->pool);
+
+    lista->inicio = NULL;
+    lista->fim = NULL;
+    lista->total = 0;
+    lista->blocos = 0;
+}
+
+/*
+ * Funcao: blocoComEspaco
+ * Devolve o ultimo bloco, ou um bloco novo ligado ao fim se ele estiver
+ * cheio (ou a lista vazia).
+ *
+ * Retorno: o bloco, ou NULL se faltou memoria
+ */
+static BlocoItens* blocoComEspaco(ListaDesenrolada* lista) {
+    BlocoItens* bloco = lista->fim;
+
+    if (bloco == NULL || bloco->usados == (int)ITENS_POR_BLOCO) {
+        bloco = (BlocoItens*)poolAlocar(&lista->pool);
+        if (bloco == NULL) {
+            return NULL;
+        }
+        bloco->usados = 0;
+        bloco->proximo = NULL;
+
+        if (lista->fim == NULL) {
+            lista->inicio = bloco;
+        } else {
+            lista->fim->proximo = bloco;
+        }
+        lista->fim = bloco;
+        lista->blocos++;
+    }
+    return bloco;
+}
+
+// Corpo de desenroladaInserir, que mede a latencia (latencia.h)
+static int inserir(ListaDesenrolada* lista, Item item) {
+    BlocoItens* bloco = blocoComEspaco(lista);
+    if (bloco == NULL) {
+        return 0;
+    }
+
+    bloco->itens[bloco->usados] = item;
+    itemAtualizarPrefixo(&bloco->itens[bloco->usados]);
+    bloco->usados++;
+    lista->total++;
+    return 1;
+}
+
+/*
+ * Funcao: desenroladaInserir
+ * Insere um item no final da lista. Um novo bloco so e alocado quando o
+ * ultimo bloco esta cheio.
+ *
+ * Complexidade: O(1)
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int desenroladaInserir(ListaDesenrolada* lista, Item item) {
+    uint64_t inicio = latenciaMarcar();
+    int resultado = inserir(lista, item);
+    latenciaRegistrar(LATENCIA_DESENROLADA_INSERIR, inicio);
+    return resultado;
+}
+
+/*
+ * Funcao: desenroladaInserirLote
+ * Insere varios itens no final da lista, na ordem do vetor recebido
+ * (carga em massa, ex: importacao.h). Cada bloco e preenchido com uma
+ * unica copia do trecho que cabe nele.
+ *
+ * Complexidade: O(total)
+ *
+ * Retorno: quantos itens foram inseridos (menos que 'total' so se faltou
+ * memoria)
+ */
+int desenroladaInserirLote(ListaDesenrolada* lista, const Item* itens, int total) {
+    int inseridos = 0;
+
+    while (inseridos < total) {
+        BlocoItens* bloco = blocoComEspaco(lista);
+        if (bloco == NULL) {
+            break;
+        }
+
+        int trecho = (int)ITENS_POR_BLOCO - bloco->usados;
+        if (trecho > total - inseridos) {
+            trecho = total - inseridos;
+        }
+        Item* destino = &bloco->itens[bloco->usados];
+        memcpy(destino, &itens[inseridos], sizeof(Item) * (size_t)trecho);
+        for (int i = 0; i < trecho; i++) {
+            itemAtualizarPrefixo(&destino[i]);
+        }
+
+        bloco->usados += trecho;
+        lista->total += trecho;
+        inseridos += trecho;
+    }
+    return inseridos;
+}
+
+/*
+ * Funcao: desligarBloco
+ * Retira um bloco da lista e o devolve ao pool.
+ */
+static void desligarBloco(ListaDesenrolada* lista, BlocoItens* anterior, BlocoItens* bloco) {
+    if (anterior == NULL) {
+        lista->inicio = bloco->proximo;
+    } else {
+        anterior->proximo = bloco->proximo;
+    }
+    if (lista->fim == bloco) {
+        lista->fim = anterior;
+    }
+
+    poolDevolver(&lista->pool, bloco);
+    lista->blocos--;
+}
+
+// Corpo de desenroladaRemover, que mede a latencia (latencia.h)
+static int remover(ListaDesenrolada* lista, const char* nome) {
+    uint64_t prefixo = prefixoNome(nome);
+    BlocoItens* anterior = NULL;
+
+    for (BlocoItens* bloco = lista->inicio; bloco != NULL; anterior = bloco, bloco = bloco->proximo) {
+        for (int i = 0; i < bloco->usados; i++) {
+            if (compararNomeChave(&bloco->itens[i], prefixo, nome) != 0) {
+                continue;
+            }
+
+            memmove(&bloco->itens[i], &bloco->itens[i + 1],
+                    sizeof(Item) * (size_t)(bloco->usados - i - 1));
+            bloco->usados--;
+            lista->total--;
+
+            if (bloco->usados == 0) {
+                desligarBloco(lista, anterior, bloco);
+                return 1;
+            }
+
+            BlocoItens* seguinte = bloco->proximo;
+            if (bloco->usados < (int)ITENS_POR_BLOCO / 2 && seguinte != NULL &&
+                bloco->usados + seguinte->usados <= (int)ITENS_POR_BLOCO) {
+                memcpy(&bloco->itens[bloco->usados], seguinte->itens,
+                       sizeof(Item) * (size_t)seguinte->usados);
+                bloco->usados += seguinte->usados;
+                desligarBloco(lista, bloco, seguinte);
+            }
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Funcao: desenroladaRemover
+ * Remove um item pelo nome.
+ *
+ * Apenas os itens seguintes do mesmo bloco sao deslocados. Se o bloco
+ * fica com menos da metade e cabe junto com o seguinte, os dois sao
+ * fundidos, mantendo a lista densa; blocos vazios sao devolvidos ao pool.
+ *
+ * Complexidade: O(n / B) blocos visitados + O(B) deslocamentos, onde B e
+ * ITENS_POR_BLOCO
+ *
+ * Retorno: 1 se sucesso, 0 se nao encontrado
+ */
+int desenroladaRemover(ListaDesenrolada* lista, const char* nome) {
+    uint64_t inicio = latenciaMarcar();
+    int resultado = remover(lista, nome);
+    latenciaRegistrar(LATENCIA_DESENROLADA_REMOVER, inicio);
+    return resultado;
+}
+
+// Corpo de desenroladaBuscar, que mede a latencia (latencia.h)
+static const Item* buscar(const ListaDesenrolada* lista, const char* nome, Estatisticas* estatisticas) {
+    uint64_t prefixo = prefixoNome(nome);
+    int contador = 0;
+    const Item* encontrado = NULL;
+
+    for (const BlocoItens* bloco = lista->inicio; bloco != NULL && encontrado == NULL; bloco = bloco->proximo) {
+        for (int i = 0; i < bloco->usados; i++) {
+            contador++;
+            if (compararNomeChave(&bloco->itens[i], prefixo, nome) == 0) {
+                encontrado = &bloco->itens[i];
+                break;
+            }
+        }
+    }
+
+    if (estatisticas != NULL) {
+        estatisticas->comparacoes += contador;
+    }
+    return encontrado;
+}
+
+/*
+ * Funcao: desenroladaBuscar
+ * Realiza busca sequencial, bloco a bloco.
+ *
+ * Complexidade: O(n) comparacoes, mas apenas O(n / B) saltos de ponteiro
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, acumula as comparacoes feitas
+ *
+ * Retorno: ponteiro para o item se encontrado, NULL caso contrario
+ */
+const Item* desenroladaBuscar(const ListaDesenrolada* lista, const char* nome, Estatisticas* estatisticas) {
+    uint64_t inicio = latenciaMarcar();
+    const Item* resultado = buscar(lista, nome, estatisticas);
+    latenciaRegistrar(LATENCIA_DESENROLADA_BUSCAR, inicio);
+    return resultado;
+}
+
+/*
+ * Funcao: desenroladaPercorrer
+ * Visita todos os itens da lista, do inicio ao fim.
+ */
+void desenroladaPercorrer(const ListaDesenrolada* lista,
+                          void (*visitar)(const Item* item, int posicao, void* contexto),
+                          void* contexto) {
+    int posicao = 0;
+
+    for (const BlocoItens* bloco = lista->inicio; bloco != NULL; bloco = bloco->proximo) {
+        for (int i = 0; i < bloco->usados; i++) {
+            visitar(&bloco->itens[i], posicao, contexto);
+            posicao++;
+        }
+    }
+}
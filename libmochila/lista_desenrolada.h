@@ -0,0 +1,64 @@
+/*
+ * LIBMOCHILA - LISTA ENCADEADA DESENROLADA
+ *
+ * Descricao: Lista encadeada em que cada no (bloco) guarda um vetor de
+ * itens em vez de um unico item. A busca percorre itens contiguos dentro
+ * de cada bloco (bom para o cache) e so segue um ponteiro a cada bloco;
+ * a remocao desloca apenas os itens do proprio bloco, nunca a lista toda.
+ */
+
+#ifndef LISTA_DESENROLADA_H
+#define LISTA_DESENROLADA_H
+
+#include "estatisticas.h"
+#include "item.h"
+#include "pool.h"
+
+#define TAM_BLOCO_BYTES 1024    // Tamanho alvo de cada bloco (16 linhas de cache de 64 bytes)
+
+// Quantos itens cabem no bloco depois do cabecalho (contador + ponteiro)
+#define ITENS_POR_BLOCO ((TAM_BLOCO_BYTES - 2 * sizeof(void*)) / sizeof(Item))
+
+/*
+ * Struct: BlocoItens
+ * No da lista desenrolada.
+ *
+ * Campos:
+ *   - usados: quantidade de itens ocupados em itens[]
+ *   - proximo: proximo bloco da lista
+ *   - itens: itens do bloco, sempre compactados em [0, usados)
+ */
+typedef struct BlocoItens {
+    int usados;
+    struct BlocoItens* proximo;
+    Item itens[ITENS_POR_BLOCO];
+} BlocoItens;
+
+/*
+ * Struct: ListaDesenrolada
+ *
+ * Campos:
+ *   - inicio / fim: primeiro e ultimo bloco (fim permite inserir em O(1))
+ *   - total: quantidade de itens
+ *   - blocos: quantidade de blocos alocados
+ *   - pool: pool de onde os blocos sao alocados
+ */
+typedef struct {
+    BlocoItens* inicio;
+    BlocoItens* fim;
+    int total;
+    int blocos;
+    Pool pool;
+} ListaDesenrolada;
+
+void desenroladaIniciar(ListaDesenrolada* lista);
+void desenroladaLiberar(ListaDesenrolada* lista);
+int desenroladaInserir(ListaDesenrolada* lista, Item item);
+int desenroladaInserirLote(ListaDesenrolada* lista, const Item* itens, int total);
+int desenroladaRemover(ListaDesenrolada* lista, const char* nome);
+const Item* desenroladaBuscar(const ListaDesenrolada* lista, const char* nome, Estatisticas* estatisticas);
+void desenroladaPercorrer(const ListaDesenrolada* lista,
+                          void (*visitar)(const Item* item, int posicao, void* contexto),
+                          void* contexto);
+
+#endif
@@ -0,0 +1,225 @@
+/*
+ * LIBMOCHILA - BUSCA EM LOTE
+ *
+ * Implementacao da leitura do arquivo de nomes e da busca dividida entre
+ * threads.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "lote.h"
+
+#define MAX_THREADS_LOTE 64
+
+// ============================================================================
+// ARQUIVO DE NOMES
+// ============================================================================
+
+/*
+ * Funcao: loteLerNomes
+ * Le um arquivo com um nome por linha. Linhas vazias sao ignoradas, o
+ * "\r" de arquivos gravados no Windows e descartado e nomes com mais de
+ * TAM_NOME - 1 bytes sao cortados (marcados em lista->cortados).
+ *
+ * Complexidade: O(tamanho do arquivo); uma unica alocacao para o texto
+ *
+ * Parametros:
+ *   - lista: recebe os nomes (liberar com loteLiberarNomes)
+ *
+ * Retorno: 1 se sucesso, 0 se o arquivo nao pode ser lido ou faltou memoria
+ */
+int loteLerNomes(const char* caminho, ListaNomes* lista) {
+    lista->texto = NULL;
+    lista->nomes = NULL;
+    lista->cortados = NULL;
+    lista->total = 0;
+
+    FILE* arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) {
+        return 0;
+    }
+
+    long tamanho = -1;
+    if (fseek(arquivo, 0, SEEK_END) == 0) {
+        tamanho = ftell(arquivo);
+        rewind(arquivo);
+    }
+    if (tamanho < 0) {
+        fclose(arquivo);
+        return 0;
+    }
+
+    lista->texto = (char*)malloc((size_t)tamanho + 1);
+    if (lista->texto == NULL || fread(lista->texto, 1, (size_t)tamanho, arquivo) != (size_t)tamanho) {
+        fclose(arquivo);
+        loteLiberarNomes(lista);
+        return 0;
+    }
+    fclose(arquivo);
+    lista->texto[tamanho] = '\0';
+
+    // Cada nome termina em '\n', entao ha no maximo uma linha a mais que '\n's
+    int linhas = 1;
+    for (long i = 0; i < tamanho; i++) {
+        linhas += lista->texto[i] == '\n';
+    }
+    lista->nomes = (const char**)malloc(sizeof(char*) * (size_t)linhas);
+    lista->cortados = (bool*)malloc(sizeof(bool) * (size_t)linhas);
+    if (lista->nomes == NULL || lista->cortados == NULL) {
+        loteLiberarNomes(lista);
+        return 0;
+    }
+
+    char* linha = lista->texto;
+    while (*linha != '\0') {
+        char* fim = strchr(linha, '\n');
+        char* proxima = fim != NULL ? fim + 1 : linha + strlen(linha);
+        if (fim == NULL) {
+            fim = proxima;
+        }
+        if (fim > linha && fim[-1] == '\r') {
+            fim--;
+        }
+        *fim = '\0';
+
+        if (fim > linha) {
+            bool cortado = fim - linha > TAM_NOME - 1;
+            if (cortado) {
+                linha[TAM_NOME - 1] = '\0';
+            }
+            lista->cortados[lista->total] = cortado;
+            lista->nomes[lista->total++] = linha;
+        }
+        linha = proxima;
+    }
+    return 1;
+}
+
+void loteLiberarNomes(ListaNomes* lista) {
+    free(lista->texto);
+    free((void*)lista->nomes);
+    free(lista->cortados);
+    lista->texto = NULL;
+    lista->nomes = NULL;
+    lista->cortados = NULL;
+    lista->total = 0;
+}
+
+// ============================================================================
+// BUSCA
+// ============================================================================
+
+/*
+ * Struct: FatiaLote
+ * Parte do lote buscada por uma thread, com estatisticas proprias
+ * (somadas depois que todas terminam).
+ */
+typedef struct {
+    const Mochila* mochila;
+    const char* const* nomes;
+    int* posicoes;
+    int inicio;
+    int fim;
+    int encontrados;
+    Estatisticas estatisticas;
+} FatiaLote;
+
+/*
+ * Funcao: buscarFatia
+ * Busca os nomes da fatia direto no indice hash. mochilaBuscar nao e
+ * usada porque registra cada busca nos histogramas globais de latencia
+ * (latencia.h): as threads disputariam os mesmos contadores, e o lote
+ * encheria o histograma BUSCAR da sessao interativa.
+ */
+static void* buscarFatia(void* argumento) {
+    FatiaLote* fatia = (FatiaLote*)argumento;
+    const Mochila* mochila = fatia->mochila;
+
+    for (int i = fatia->inicio; i < fatia->fim; i++) {
+        fatia->posicoes[i] = indiceHashBuscar(&mochila->indiceNome, mochila->itens, fatia->nomes[i],
+                                              &fatia->estatisticas);
+        fatia->encontrados += fatia->posicoes[i] >= 0;
+    }
+    return NULL;
+}
+
+/*
+ * Funcao: loteThreads
+ * Quantas threads loteBuscar usa para 'total' nomes: no maximo uma a
+ * cada MIN_NOMES_POR_THREAD nomes.
+ *
+ * Parametros:
+ *   - threads: threads pedidas; 0 para uma por processador disponivel
+ */
+int loteThreads(int total, int threads) {
+    if (threads <= 0) {
+        long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = processadores > 0 ? (int)(processadores < MAX_THREADS_LOTE ? processadores : MAX_THREADS_LOTE)
+                                    : 1;
+    }
+    if (threads > MAX_THREADS_LOTE) {
+        threads = MAX_THREADS_LOTE;
+    }
+    if (threads > total / MIN_NOMES_POR_THREAD) {
+        threads = total / MIN_NOMES_POR_THREAD;
+    }
+    return threads > 1 ? threads : 1;
+}
+
+/*
+ * Funcao: loteBuscar
+ * Busca cada nome na mochila pelo indice hash, dividindo os nomes em
+ * fatias contiguas, uma por thread. A mochila nao e alterada.
+ *
+ * Complexidade: O(total / p) em media com p threads
+ *
+ * Parametros:
+ *   - posicoes: recebe, para cada nome, a posicao do item na mochila
+ *               (mochilaItem) ou -1 se nao encontrado
+ *   - threads: threads a usar; 0 para uma por processador (ver loteThreads)
+ *   - estatisticas: se nao for NULL, acumula as comparacoes de todas
+ *
+ * Retorno: quantos nomes foram encontrados
+ */
+int loteBuscar(const Mochila* mochila, const char* const* nomes, int total, int* posicoes, int threads,
+               Estatisticas* estatisticas) {
+    FatiaLote fatias[MAX_THREADS_LOTE];
+    pthread_t ids[MAX_THREADS_LOTE];
+    int criada[MAX_THREADS_LOTE];
+
+    threads = loteThreads(total, threads);
+    for (int t = 0; t < threads; t++) {
+        FatiaLote* fatia = &fatias[t];
+        fatia->mochila = mochila;
+        fatia->nomes = nomes;
+        fatia->posicoes = posicoes;
+        fatia->inicio = (int)((long)total * t / threads);
+        fatia->fim = (int)((long)total * (t + 1) / threads);
+        fatia->encontrados = 0;
+        estatisticasZerar(&fatia->estatisticas);
+        criada[t] = t > 0 && pthread_create(&ids[t], NULL, buscarFatia, fatia) == 0;
+    }
+
+    // A thread atual busca a primeira fatia (e as que nao ganharam thread)
+    buscarFatia(&fatias[0]);
+
+    int encontrados = 0;
+    for (int t = 0; t < threads; t++) {
+        if (criada[t]) {
+            pthread_join(ids[t], NULL);
+        } else if (t > 0) {
+            buscarFatia(&fatias[t]);
+        }
+        encontrados += fatias[t].encontrados;
+        if (estatisticas != NULL) {
+            estatisticasSomar(estatisticas, &fatias[t].estatisticas);
+        }
+    }
+    return encontrados;
+}
@@ -0,0 +1,48 @@
+/*
+ * LIBMOCHILA - BUSCA EM LOTE
+ *
+ * Descricao: Confere muitos nomes de uma vez contra uma mochila (por
+ * exemplo, as dezenas de milhares de nomes de uma conciliacao de
+ * inventario). Os nomes sao divididos entre threads que consultam o
+ * indice hash da mesma mochila. A busca so le a mochila, entao ela e
+ * compartilhada sem travas; basta que ninguem a altere durante o lote.
+ *
+ * Os nomes podem vir de um arquivo texto, um por linha (loteLerNomes).
+ * Como a mochila guarda no maximo TAM_NOME - 1 bytes de cada nome, os
+ * nomes mais longos sao cortados na leitura, do mesmo jeito que na
+ * insercao; assim um nome longo presente no inventario e na consulta
+ * continua sendo encontrado.
+ */
+
+#ifndef LOTE_H
+#define LOTE_H
+
+#include "mochila.h"
+
+#define MIN_NOMES_POR_THREAD 1024  // Lotes menores usam menos threads
+
+/*
+ * Struct: ListaNomes
+ * Nomes lidos de um arquivo.
+ *
+ * Campos:
+ *   - texto: conteudo do arquivo; os nomes apontam para dentro dele
+ *   - nomes: um ponteiro por nome, na ordem do arquivo
+ *   - cortados: para cada nome, true se foi cortado em TAM_NOME - 1 bytes
+ *   - total: quantidade de nomes
+ */
+typedef struct {
+    char* texto;
+    const char** nomes;
+    bool* cortados;
+    int total;
+} ListaNomes;
+
+int loteLerNomes(const char* caminho, ListaNomes* lista);
+void loteLiberarNomes(ListaNomes* lista);
+
+int loteBuscar(const Mochila* mochila, const char* const* nomes, int total, int* posicoes, int threads,
+               Estatisticas* estatisticas);
+int loteThreads(int total, int threads);
+
+#endif
@@ -0,0 +1,1318 @@
+/*
+ * LIBMOCHILA - NUCLEO DO INVENTARIO FREE FIRE
+ *
+ * Implementacao do inventario sequencial (vetor), das buscas e das
+ * ordenacoes compartilhadas pelos programas de menu.
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "latencia.h"
+#include "mochila.h"
+
+// ============================================================================
+// CICLO DE VIDA
+// ============================================================================
+
+#define CAPACIDADE_MINIMA 4     // Menor vetor alocado quando a mochila cresce
+
+/*
+ * Funcao: realocarItens
+ * Troca o vetor de itens por um com exatamente a capacidade informada.
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (os vetores continuam validos para
+ *          mochila->capacidade itens)
+ */
+static int realocarItens(Mochila* mochila, int capacidade) {
+    if (capacidade == 0) {
+        free(mochila->itens);
+        free(mochila->lapides);
+        mochila->itens = NULL;
+        mochila->lapides = NULL;
+        mochila->capacidade = 0;
+        return 1;
+    }
+
+    Item* novo = (Item*)realloc(mochila->itens, sizeof(Item) * (size_t)capacidade);
+    if (novo == NULL) {
+        return 0;
+    }
+    mochila->itens = novo;
+
+    // As marcas de lapide acompanham o vetor de itens quando existem
+    if (mochila->lapides != NULL || mochila->remocaoPreguicosa) {
+        unsigned char* lapides = (unsigned char*)realloc(mochila->lapides, (size_t)capacidade);
+        if (lapides == NULL) {
+            // Ao crescer, a capacidade antiga vale para os dois vetores. Ao
+            // encolher, o vetor de itens ja diminuiu: a capacidade passa a
+            // ser a nova, e as marcas antigas (maiores) continuam servindo
+            if (capacidade < mochila->capacidade) {
+                mochila->capacidade = capacidade;
+                return mochila->lapides != NULL;
+            }
+            return 0;
+        }
+        if (capacidade > mochila->capacidade) {
+            memset(lapides + mochila->capacidade, 0, (size_t)(capacidade - mochila->capacidade));
+        }
+        mochila->lapides = lapides;
+    }
+
+    mochila->capacidade = capacidade;
+    return 1;
+}
+
+/*
+ * Funcao: crescer
+ * Garante espaco para pelo menos 'minimo' itens, multiplicando a
+ * capacidade pelo fator de crescimento. O custo O(n) da copia e diluido
+ * entre as insercoes seguintes (O(1) amortizado).
+ */
+static int crescer(Mochila* mochila, int minimo) {
+    double proposta = (double)mochila->capacidade * mochila->fatorCrescimento;
+    int capacidade;
+
+    if (proposta >= (double)INT_MAX) {
+        capacidade = INT_MAX;
+    } else {
+        capacidade = (int)proposta;
+    }
+    if (capacidade < minimo) {
+        capacidade = minimo;
+    }
+    if (capacidade < CAPACIDADE_MINIMA) {
+        capacidade = CAPACIDADE_MINIMA;
+    }
+
+    return realocarItens(mochila, capacidade);
+}
+
+/*
+ * Funcao: mochilaIniciar
+ * Cria uma mochila vazia com espaco pre-alocado para a capacidade informada.
+ * A capacidade e apenas inicial: o vetor cresce conforme necessario.
+ *
+ * Parametros:
+ *   - mochila: mochila a ser inicializada
+ *   - capacidade: numero de itens reservados de inicio (pode ser 0)
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int mochilaIniciar(Mochila* mochila, int capacidade) {
+    mochila->itens = NULL;
+    mochila->total = 0;
+    mochila->capacidade = 0;
+    mochila->fatorCrescimento = FATOR_CRESCIMENTO_PADRAO;
+    mochila->encolherAutomatico = false;
+    mochila->lapides = NULL;
+    mochila->removidos = 0;
+    mochila->remocaoPreguicosa = false;
+    mochila->limiteRemovidos = LIMITE_REMOVIDOS_PADRAO;
+    mochila->ordenada = false;
+    mochila->criterioOrdem = NOME;
+    mochila->algoritmoUsado = INSERTION_SORT;
+    mochila->insercaoOrdenada = false;
+    mochila->indicesSecundarios = false;
+    for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+        indiceOrdenadoIniciar(&mochila->indicesOrdem[c], (CriterioOrdenacao)c);
+    }
+    agregadosIniciar(&mochila->agregadosTipo);
+    agregadosIniciar(&mochila->agregadosPrioridade);
+    mochila->agregadoGeral.itens = 0;
+    mochila->agregadoGeral.quantidade = 0;
+
+    if (!realocarItens(mochila, capacidade)) {
+        return 0;
+    }
+
+    if (!indiceHashIniciar(&mochila->indiceNome, capacidade)) {
+        free(mochila->itens);
+        mochila->itens = NULL;
+        mochila->capacidade = 0;
+        return 0;
+    }
+
+    return 1;
+}
+
+/*
+ * Funcao: mochilaLiberar
+ * Libera a memoria do vetor de itens e zera a mochila.
+ */
+void mochilaLiberar(Mochila* mochila) {
+    free(mochila->itens);
+    free(mochila->lapides);
+    indiceHashLiberar(&mochila->indiceNome);
+    for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+        indiceOrdenadoLiberar(&mochila->indicesOrdem[c]);
+    }
+    agregadosLiberar(&mochila->agregadosTipo);
+    agregadosLiberar(&mochila->agregadosPrioridade);
+    mochila->agregadoGeral.itens = 0;
+    mochila->agregadoGeral.quantidade = 0;
+    mochila->indicesSecundarios = false;
+    mochila->itens = NULL;
+    mochila->lapides = NULL;
+    mochila->removidos = 0;
+    mochila->total = 0;
+    mochila->capacidade = 0;
+    mochila->ordenada = false;
+}
+
+// ============================================================================
+// GERENCIAMENTO DE CAPACIDADE
+// ============================================================================
+
+/*
+ * Funcao: mochilaReservar
+ * Garante espaco para pelo menos a capacidade informada, com uma unica
+ * realocacao. Util antes de carregar muitos itens de uma vez.
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int mochilaReservar(Mochila* mochila, int capacidade) {
+    if (capacidade <= mochila->capacidade) {
+        return 1;
+    }
+    return realocarItens(mochila, capacidade);
+}
+
+/*
+ * Funcao: mochilaAjustarCapacidade
+ * Reduz o vetor (e o indice hash) ao tamanho exato dos itens armazenados,
+ * devolvendo a memoria excedente (shrink-to-fit).
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int mochilaAjustarCapacidade(Mochila* mochila) {
+    if (!mochilaCompactar(mochila)) {
+        return 0;
+    }
+    if (mochila->capacidade == mochila->total) {
+        return 1;
+    }
+    if (!realocarItens(mochila, mochila->total)) {
+        return 0;
+    }
+    return indiceHashReconstruir(&mochila->indiceNome, mochila->itens, mochila->total);
+}
+
+/*
+ * Funcao: mochilaDefinirCrescimento
+ * Define o multiplicador da capacidade usado quando o vetor enche.
+ * Fatores menores economizam memoria; maiores realocam menos vezes.
+ */
+void mochilaDefinirCrescimento(Mochila* mochila, double fator) {
+    if (fator < FATOR_CRESCIMENTO_MINIMO) {
+        fator = FATOR_CRESCIMENTO_MINIMO;
+    }
+    mochila->fatorCrescimento = fator;
+}
+
+/*
+ * Funcao: mochilaDefinirEncolhimento
+ * Liga ou desliga o modo que devolve memoria automaticamente: quando a
+ * ocupacao cai abaixo de 1/4 da capacidade, o vetor e reduzido a metade.
+ * (A folga entre 1/4 e 1/2 evita realocar a cada insercao/remocao.)
+ */
+void mochilaDefinirEncolhimento(Mochila* mochila, bool ativo) {
+    mochila->encolherAutomatico = ativo;
+}
+
+/*
+ * Funcao: encolherSeNecessario
+ * Aplica o modo de encolhimento automatico depois de uma remocao.
+ */
+static void encolherSeNecessario(Mochila* mochila) {
+    if (!mochila->encolherAutomatico || mochila->capacidade <= CAPACIDADE_MINIMA) {
+        return;
+    }
+
+    if (mochila->total < mochila->capacidade / 4) {
+        int capacidade = mochila->capacidade / 2;
+        if (capacidade < CAPACIDADE_MINIMA) {
+            capacidade = CAPACIDADE_MINIMA;
+        }
+        // Se a realocacao falhar, a mochila apenas continua com a folga atual
+        realocarItens(mochila, capacidade);
+    }
+}
+
+// ============================================================================
+// MANUTENCAO DOS INDICES SECUNDARIOS
+// ============================================================================
+
+/*
+ * Funcao: reservarIndices
+ * Garante espaco nos indices secundarios para mais um item. E chamada
+ * antes de qualquer alteracao, para que a insercao nao falhe no meio.
+ */
+static int reservarIndices(Mochila* mochila) {
+    if (!mochila->indicesSecundarios) {
+        return 1;
+    }
+    for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+        if (!indiceOrdenadoReservar(&mochila->indicesOrdem[c], mochila->total - mochila->removidos + 1)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void registrarNosIndices(Mochila* mochila, int posicao) {
+    if (mochila->indicesSecundarios) {
+        for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+            indiceOrdenadoInserir(&mochila->indicesOrdem[c], mochila->itens, posicao);
+        }
+    }
+}
+
+static void retirarDosIndices(Mochila* mochila, int posicao) {
+    if (mochila->indicesSecundarios) {
+        for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+            indiceOrdenadoRemover(&mochila->indicesOrdem[c], mochila->itens, posicao);
+        }
+    }
+}
+
+static void deslocarNosIndices(Mochila* mochila, int aPartirDe, int deslocamento) {
+    if (mochila->indicesSecundarios) {
+        for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+            indiceOrdenadoDeslocar(&mochila->indicesOrdem[c], aPartirDe, deslocamento);
+        }
+    }
+}
+
+/*
+ * Funcao: reconstruirIndices
+ * Refaz os indices secundarios depois de operacoes que movem muitos itens
+ * de uma vez (ordenacao, compactacao).
+ *
+ * Retorno: 1 se sucesso, 0 se faltou memoria (os indices sao desligados,
+ *          para nunca apontarem para posicoes antigas)
+ */
+static int reconstruirIndices(Mochila* mochila) {
+    if (!mochila->indicesSecundarios) {
+        return 1;
+    }
+    const unsigned char* lapides = mochila->removidos > 0 ? mochila->lapides : NULL;
+    for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+        if (!indiceOrdenadoReconstruir(&mochila->indicesOrdem[c], mochila->itens, mochila->total, lapides)) {
+            mochilaDefinirIndicesSecundarios(mochila, false);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// ============================================================================
+// REMOCAO PREGUICOSA (LAPIDES)
+// ============================================================================
+
+/*
+ * Funcao: estaRemovido
+ * Indica se a posicao do vetor guarda uma lapide.
+ */
+static bool estaRemovido(const Mochila* mochila, int indice) {
+    return mochila->removidos > 0 && mochila->lapides[indice];
+}
+
+/*
+ * Funcao: mochilaDefinirRemocaoPreguicosa
+ * Liga ou desliga o modo de remocao por lapides.
+ *
+ * Com o modo ligado, remover um item apenas marca sua posicao: nenhum item
+ * e copiado. Quando as lapides passam da fracao "limite" das posicoes
+ * ocupadas, uma unica compactacao O(n) remove todas de uma vez. Remover
+ * centenas de itens seguidos deixa de ser quadratico.
+ *
+ * Parametros:
+ *   - ativo: liga (true) ou desliga (false) o modo; desligar compacta o vetor
+ *   - limite: fracao de lapides entre 0 e 1 (<= 0 usa o padrao)
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int mochilaDefinirRemocaoPreguicosa(Mochila* mochila, bool ativo, double limite) {
+    if (limite <= 0.0 || limite > 1.0) {
+        limite = LIMITE_REMOVIDOS_PADRAO;
+    }
+    mochila->limiteRemovidos = limite;
+
+    if (!ativo) {
+        mochila->remocaoPreguicosa = false;
+        return mochilaCompactar(mochila);
+    }
+
+    if (mochila->lapides == NULL && mochila->capacidade > 0) {
+        mochila->lapides = (unsigned char*)calloc((size_t)mochila->capacidade, 1);
+        if (mochila->lapides == NULL) {
+            return 0;
+        }
+    }
+
+    mochila->remocaoPreguicosa = true;
+    return 1;
+}
+
+/*
+ * Funcao: mochilaCompactar
+ * Remove todas as lapides de uma vez, deslocando cada item vivo uma unica
+ * vez para a primeira posicao livre (a ordem relativa e preservada).
+ * O indice hash e reconstruido com as novas posicoes.
+ *
+ * Complexidade: O(n)
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao no indice)
+ */
+int mochilaCompactar(Mochila* mochila) {
+    if (mochila->removidos == 0) {
+        return 1;
+    }
+
+    int destino = 0;
+    for (int i = 0; i < mochila->total; i++) {
+        if (mochila->lapides[i]) {
+            mochila->lapides[i] = 0;
+            continue;
+        }
+        if (destino != i) {
+            mochila->itens[destino] = mochila->itens[i];
+        }
+        destino++;
+    }
+
+    mochila->total = destino;
+    mochila->removidos = 0;
+    return indiceHashReconstruir(&mochila->indiceNome, mochila->itens, mochila->total) &&
+           reconstruirIndices(mochila);
+}
+
+/*
+ * Funcao: mochilaRemovidos
+ * Retorna quantas lapides aguardam a proxima compactacao.
+ */
+int mochilaRemovidos(const Mochila* mochila) {
+    return mochila->removidos;
+}
+
+/*
+ * Funcao: removerPreguicoso
+ * Marca a posicao como lapide e compacta se o limite foi ultrapassado.
+ */
+static void removerPreguicoso(Mochila* mochila, int indice) {
+    mochila->lapides[indice] = 1;
+    mochila->removidos++;
+
+    if (mochila->removidos > mochila->limiteRemovidos * mochila->total) {
+        mochilaCompactar(mochila);
+        encolherSeNecessario(mochila);
+    }
+}
+
+// ============================================================================
+// OPERACOES BASICAS
+// ============================================================================
+
+/*
+ * Funcao: reservarAgregados
+ * Garante os contadores do tipo e da prioridade do item antes da insercao,
+ * para que a contagem depois dela nao possa falhar.
+ */
+static int reservarAgregados(Mochila* mochila, const Item* item) {
+    return agregadosReservar(&mochila->agregadosTipo, item->idTipo) &&
+           agregadosReservar(&mochila->agregadosPrioridade, item->prioridade);
+}
+
+/*
+ * Funcao: contarItem
+ * Soma (sinal = 1) ou desconta (sinal = -1) o item nos agregados.
+ */
+static void contarItem(Mochila* mochila, const Item* item, int sinal) {
+    if (sinal > 0) {
+        agregadosAdicionar(&mochila->agregadosTipo, item->idTipo, item->quantidade);
+        agregadosAdicionar(&mochila->agregadosPrioridade, item->prioridade, item->quantidade);
+    } else {
+        agregadosRetirar(&mochila->agregadosTipo, item->idTipo, item->quantidade);
+        agregadosRetirar(&mochila->agregadosPrioridade, item->prioridade, item->quantidade);
+    }
+    mochila->agregadoGeral.itens += sinal;
+    mochila->agregadoGeral.quantidade += (long long)sinal * item->quantidade;
+}
+
+/*
+ * Funcao: posicaoPorNome
+ * Busca binaria pela primeira posicao cujo nome e maior que o informado
+ * (apos os nomes iguais, para que itens repetidos mantenham a ordem de
+ * chegada). As lapides guardam o nome do item removido e continuam na
+ * ordem, entao participam da busca normalmente.
+ */
+static int posicaoPorNome(const Mochila* mochila, const Item* item) {
+    int esquerda = 0;
+    int direita = mochila->total;
+
+    while (esquerda < direita) {
+        int meio = esquerda + (direita - esquerda) / 2;
+        if (compararNomes(&mochila->itens[meio], item) <= 0) {
+            esquerda = meio + 1;
+        } else {
+            direita = meio;
+        }
+    }
+
+    return esquerda;
+}
+
+/*
+ * Funcao: inserirOrdenado
+ * Insere mantendo o vetor ordenado por nome. Se houver uma lapide
+ * exatamente no ponto de insercao, ela e reaproveitada sem mover nada;
+ * senao, os itens a partir da posicao andam uma casa (um unico memmove)
+ * e o indice hash e corrigido em bloco.
+ */
+static int inserirOrdenado(Mochila* mochila, Item item) {
+    int posicao = posicaoPorNome(mochila, &item);
+
+    if (mochila->removidos > 0) {
+        int lapide = -1;
+        if (posicao > 0 && mochila->lapides[posicao - 1]) {
+            lapide = posicao - 1;
+        } else if (posicao < mochila->total && mochila->lapides[posicao]) {
+            lapide = posicao;
+        }
+
+        if (lapide != -1) {
+            if (!indiceHashInserir(&mochila->indiceNome, item.nome, lapide)) {
+                return 0;
+            }
+            mochila->itens[lapide] = item;
+            mochila->lapides[lapide] = 0;
+            mochila->removidos--;
+            registrarNosIndices(mochila, lapide);
+            return 1;
+        }
+    }
+
+    if (!indiceHashInserir(&mochila->indiceNome, item.nome, mochila->total)) {
+        return 0;
+    }
+
+    int deslocados = mochila->total - posicao;
+    if (deslocados > 0) {
+        // A entrada recem-inserida aponta para total; corrige junto com o bloco
+        indiceHashDeslocar(&mochila->indiceNome, posicao, 1);
+        indiceHashMover(&mochila->indiceNome, item.nome, mochila->total + 1, posicao);
+        deslocarNosIndices(mochila, posicao, 1);
+
+        memmove(&mochila->itens[posicao + 1], &mochila->itens[posicao],
+                sizeof(Item) * (size_t)deslocados);
+        if (mochila->lapides != NULL) {
+            memmove(&mochila->lapides[posicao + 1], &mochila->lapides[posicao], (size_t)deslocados);
+            mochila->lapides[posicao] = 0;
+        }
+    }
+
+    mochila->itens[posicao] = item;
+    mochila->total++;
+    registrarNosIndices(mochila, posicao);
+    return 1;
+}
+
+// Corpo de mochilaInserir, que mede a latencia (latencia.h)
+static int inserir(Mochila* mochila, Item item) {
+    if (mochila->total >= mochila->capacidade && !crescer(mochila, mochila->total + 1)) {
+        return 0;
+    }
+
+    if (!reservarIndices(mochila)) {
+        return 0;
+    }
+
+    if (!reservarAgregados(mochila, &item)) {
+        return 0;
+    }
+
+    itemAtualizarPrefixo(&item);
+
+    if (mochila->insercaoOrdenada && mochilaOrdenadaPorNome(mochila)) {
+        if (!inserirOrdenado(mochila, item)) {
+            return 0;
+        }
+        contarItem(mochila, &item, 1);
+        return 1;
+    }
+
+    if (!indiceHashInserir(&mochila->indiceNome, item.nome, mochila->total)) {
+        return 0;
+    }
+
+    mochila->itens[mochila->total] = item;
+    registrarNosIndices(mochila, mochila->total);
+    contarItem(mochila, &item, 1);
+    mochila->total++;
+    mochila->ordenada = false;
+    return 1;
+}
+
+/*
+ * Funcao: mochilaInserir
+ * Insere um novo item no final do vetor e o registra no indice hash.
+ * No modo de insercao ordenada (mochilaDefinirInsercaoOrdenada), o item
+ * vai direto para sua posicao pela ordem do nome.
+ *
+ * Complexidade: O(1) amortizado - insercao no final (o vetor cresce
+ * pelo fator de crescimento quando enche); O(log n) comparacoes + um
+ * deslocamento O(n) no modo de insercao ordenada
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int mochilaInserir(Mochila* mochila, Item item) {
+    uint64_t inicio = latenciaMarcar();
+    int resultado = inserir(mochila, item);
+    latenciaRegistrar(LATENCIA_INSERIR, inicio);
+    return resultado;
+}
+
+/*
+ * Funcao: mochilaInserirLote
+ * Insere varios itens de uma vez, na ordem do vetor recebido (carga em
+ * massa, ex: importacao.h). O vetor cresce no maximo uma vez para o lote
+ * inteiro e a latencia nao e registrada item a item.
+ *
+ * Complexidade: O(total) amortizado; no modo de insercao ordenada, cada
+ * item custa o mesmo que em mochilaInserir
+ *
+ * Retorno: quantos itens foram inseridos (menos que 'total' so se faltou
+ * memoria; os inseridos continuam na mochila)
+ */
+int mochilaInserirLote(Mochila* mochila, const Item* itens, int total) {
+    if (total <= 0) {
+        return 0;
+    }
+    if (total > INT_MAX - mochila->total) {
+        total = INT_MAX - mochila->total;
+    }
+    if (mochila->total + total > mochila->capacidade && !crescer(mochila, mochila->total + total)) {
+        return 0;
+    }
+
+    int inseridos = 0;
+    while (inseridos < total && inserir(mochila, itens[inseridos])) {
+        inseridos++;
+    }
+    return inseridos;
+}
+
+// Corpo de mochilaRemover, que mede a latencia (latencia.h)
+static int remover(Mochila* mochila, const char* nome) {
+    int encontrado = indiceHashBuscar(&mochila->indiceNome, mochila->itens, nome, NULL);
+    if (encontrado == -1) {
+        return 0;
+    }
+
+    int ultimo = mochila->total - 1;
+    indiceHashRemover(&mochila->indiceNome, mochila->itens[encontrado].nome, encontrado);
+    retirarDosIndices(mochila, encontrado);
+    contarItem(mochila, &mochila->itens[encontrado], -1);
+
+    if (mochila->remocaoPreguicosa) {
+        removerPreguicoso(mochila, encontrado);
+        return 1;
+    }
+
+    if (!mochila->ordenada) {
+        if (encontrado != ultimo) {
+            // O ultimo muda de posicao: sai dos indices secundarios e volta
+            // na nova posicao (o desempate por posicao muda)
+            retirarDosIndices(mochila, ultimo);
+            mochila->itens[encontrado] = mochila->itens[ultimo];
+            indiceHashMover(&mochila->indiceNome, mochila->itens[encontrado].nome, ultimo, encontrado);
+            registrarNosIndices(mochila, encontrado);
+        }
+    } else if (encontrado != ultimo) {
+        memmove(&mochila->itens[encontrado], &mochila->itens[encontrado + 1],
+                sizeof(Item) * (size_t)(ultimo - encontrado));
+        indiceHashDeslocar(&mochila->indiceNome, encontrado + 1, -1);
+        deslocarNosIndices(mochila, encontrado + 1, -1);
+    }
+
+    mochila->total--;
+    encolherSeNecessario(mochila);
+    return 1;
+}
+
+/*
+ * Funcao: mochilaRemover
+ * Remove um item pelo nome, localizado pelo indice hash.
+ *
+ * Se a mochila nao esta ordenada, o ultimo item ocupa o lugar do removido
+ * (uma unica copia). Se esta ordenada, os posteriores sao deslocados uma
+ * posicao para tras para manter a ordem, atualizando o indice de cada um.
+ *
+ * No modo de remocao preguicosa, a posicao vira uma lapide (ver
+ * mochilaDefinirRemocaoPreguicosa) e a ordem e sempre preservada.
+ *
+ * Complexidade: O(1) sem ordenacao ou no modo preguicoso,
+ *               O(n) com a mochila ordenada
+ *
+ * Retorno: 1 se sucesso, 0 se nao encontrado
+ */
+int mochilaRemover(Mochila* mochila, const char* nome) {
+    uint64_t inicio = latenciaMarcar();
+    int resultado = remover(mochila, nome);
+    latenciaRegistrar(LATENCIA_REMOVER, inicio);
+    return resultado;
+}
+
+// Corpo de mochilaAlterarQuantidade, que mede a latencia (latencia.h)
+static int alterarQuantidade(Mochila* mochila, const char* nome, int quantidade) {
+    int encontrado = indiceHashBuscar(&mochila->indiceNome, mochila->itens, nome, NULL);
+    if (encontrado == -1) {
+        return 0;
+    }
+
+    Item* item = &mochila->itens[encontrado];
+    contarItem(mochila, item, -1);
+    item->quantidade = quantidade;
+    contarItem(mochila, item, 1);
+    return 1;
+}
+
+/*
+ * Funcao: mochilaAlterarQuantidade
+ * Troca a quantidade do item (por exemplo, ao coletar mais unidades de
+ * algo que ja esta na mochila). Os agregados acompanham a mudanca; a
+ * posicao do item e os indices nao mudam, pois quantidade nao e criterio
+ * de ordenacao.
+ *
+ * Complexidade: O(1)
+ *
+ * Retorno: 1 se sucesso, 0 se nao encontrado
+ */
+int mochilaAlterarQuantidade(Mochila* mochila, const char* nome, int quantidade) {
+    uint64_t inicio = latenciaMarcar();
+    int resultado = alterarQuantidade(mochila, nome, quantidade);
+    latenciaRegistrar(LATENCIA_ALTERAR_QUANTIDADE, inicio);
+    return resultado;
+}
+
+/*
+ * Funcao: mochilaTotal
+ * Retorna a quantidade de itens armazenados (sem contar lapides).
+ */
+int mochilaTotal(const Mochila* mochila) {
+    return mochila->total - mochila->removidos;
+}
+
+/*
+ * Funcao: mochilaCapacidade
+ * Retorna quantos itens cabem no vetor alocado atualmente.
+ */
+int mochilaCapacidade(const Mochila* mochila) {
+    return mochila->capacidade;
+}
+
+/*
+ * Funcao: mochilaItem
+ * Retorna o item armazenado na posicao informada (ou NULL se a posicao
+ * for invalida ou guardar uma lapide).
+ */
+const Item* mochilaItem(const Mochila* mochila, int indice) {
+    if (indice < 0 || indice >= mochila->total || estaRemovido(mochila, indice)) {
+        return NULL;
+    }
+    return &mochila->itens[indice];
+}
+
+/*
+ * Funcao: mochilaPercorrer
+ * Visita todos os itens da mochila na ordem em que estao armazenados,
+ * pulando as lapides. E a forma de "listar" sem que a biblioteca precise
+ * imprimir nada.
+ *
+ * Parametros:
+ *   - visitar: funcao chamada para cada item (item, posicao, contexto)
+ *   - contexto: ponteiro repassado sem alteracao para visitar
+ */
+void mochilaPercorrer(const Mochila* mochila,
+                      void (*visitar)(const Item* item, int posicao, void* contexto),
+                      void* contexto) {
+    int posicao = 0;
+
+    for (int i = 0; i < mochila->total; i++) {
+        if (estaRemovido(mochila, i)) {
+            continue;
+        }
+        visitar(&mochila->itens[i], posicao, contexto);
+        posicao++;
+    }
+}
+
+/*
+ * Funcao: mochilaPercorrerPorTipo
+ * Visita, na ordem de armazenamento, apenas os itens de uma categoria.
+ * O filtro compara o id do tipo (um inteiro), sem strcmp; para filtrar
+ * por nome use tipoBuscar para obter o id.
+ *
+ * Complexidade: O(n), uma comparacao de inteiros por item
+ *
+ * Parametros:
+ *   - idTipo: id do tipo no dicionario (tipos.h)
+ *   - visitar: funcao chamada para cada item do tipo (item, posicao, contexto);
+ *              posicao conta apenas os itens visitados
+ *   - contexto: ponteiro repassado sem alteracao para visitar
+ *
+ * Retorno: quantidade de itens visitados
+ */
+int mochilaPercorrerPorTipo(const Mochila* mochila, unsigned short idTipo,
+                            void (*visitar)(const Item* item, int posicao, void* contexto),
+                            void* contexto) {
+    int posicao = 0;
+
+    for (int i = 0; i < mochila->total; i++) {
+        if (mochila->itens[i].idTipo != idTipo || estaRemovido(mochila, i)) {
+            continue;
+        }
+        visitar(&mochila->itens[i], posicao, contexto);
+        posicao++;
+    }
+    return posicao;
+}
+
+// ============================================================================
+// BUSCA
+// ============================================================================
+
+/*
+ * Funcao: mochilaBuscar
+ * Localiza um item pelo nome usando o indice hash.
+ *
+ * Complexidade: O(1) em media, independente do tamanho da mochila
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, acumula as comparacoes de nome
+ *
+ * Retorno: indice do item se encontrado, -1 caso contrario
+ */
+int mochilaBuscar(const Mochila* mochila, const char* nome, Estatisticas* estatisticas) {
+    uint64_t inicio = latenciaMarcar();
+    int encontrado = indiceHashBuscar(&mochila->indiceNome, mochila->itens, nome, estatisticas);
+    latenciaRegistrar(LATENCIA_BUSCAR, inicio);
+    return encontrado;
+}
+
+// Corpo de mochilaBuscarSequencial, que mede a latencia (latencia.h)
+static int buscarSequencial(const Mochila* mochila, const char* nome, Estatisticas* estatisticas) {
+    uint64_t prefixo = prefixoNome(nome);
+    int contador = 0;
+    int encontrado = -1;
+
+    for (int i = 0; i < mochila->total; i++) {
+        if (estaRemovido(mochila, i)) {
+            continue;
+        }
+        contador++;
+        if (compararNomeChave(&mochila->itens[i], prefixo, nome) == 0) {
+            encontrado = i;
+            break;
+        }
+    }
+
+    if (estatisticas != NULL) {
+        estatisticas->comparacoes += contador;
+    }
+    return encontrado;
+}
+
+/*
+ * Funcao: mochilaBuscarSequencial
+ * Realiza busca sequencial pelo nome.
+ *
+ * Complexidade: O(n) - pior caso percorre todos os elementos
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, acumula as comparacoes feitas
+ *
+ * Retorno: indice do item se encontrado, -1 caso contrario
+ */
+int mochilaBuscarSequencial(const Mochila* mochila, const char* nome, Estatisticas* estatisticas) {
+    uint64_t inicio = latenciaMarcar();
+    int resultado = buscarSequencial(mochila, nome, estatisticas);
+    latenciaRegistrar(LATENCIA_BUSCA_SEQUENCIAL, inicio);
+    return resultado;
+}
+
+/*
+ * Funcao: buscarVivoComMesmoNome
+ * A lapide mantem o nome do item removido, entao a ordem do vetor continua
+ * valida para a busca binaria. Se ela parar em uma lapide, procura um item
+ * vivo com o mesmo nome entre os vizinhos (duplicatas ficam adjacentes).
+ *
+ * Retorno: posicao do item vivo, -1 se todos com esse nome foram removidos
+ */
+static int buscarVivoComMesmoNome(const Mochila* mochila, int meio) {
+    if (!estaRemovido(mochila, meio)) {
+        return meio;
+    }
+
+    const Item* item = &mochila->itens[meio];
+    for (int i = meio - 1; i >= 0 && compararNomes(&mochila->itens[i], item) == 0; i--) {
+        if (!estaRemovido(mochila, i)) {
+            return i;
+        }
+    }
+    for (int i = meio + 1; i < mochila->total && compararNomes(&mochila->itens[i], item) == 0; i++) {
+        if (!estaRemovido(mochila, i)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+// Corpo de mochilaBuscarBinaria, que mede a latencia (latencia.h)
+static int buscarBinaria(const Mochila* mochila, const char* nome, Estatisticas* estatisticas) {
+    if (mochila->indicesSecundarios && !mochilaOrdenadaPorNome(mochila)) {
+        return indiceOrdenadoBuscarNome(&mochila->indicesOrdem[NOME], mochila->itens, nome, estatisticas);
+    }
+
+    uint64_t prefixo = prefixoNome(nome);
+    int esquerda = 0;
+    int direita = mochila->total - 1;
+    int contador = 0;
+    int encontrado = -1;
+
+    while (esquerda <= direita) {
+        int meio = esquerda + (direita - esquerda) / 2;
+        contador++;
+
+        int resultado = compararNomeChave(&mochila->itens[meio], prefixo, nome);
+
+        if (resultado == 0) {
+            encontrado = buscarVivoComMesmoNome(mochila, meio);
+            break;
+        } else if (resultado < 0) {
+            esquerda = meio + 1;  // Busca na metade direita
+        } else {
+            direita = meio - 1;  // Busca na metade esquerda
+        }
+    }
+
+    if (estatisticas != NULL) {
+        estatisticas->comparacoes += contador;
+    }
+    return encontrado;
+}
+
+/*
+ * Funcao: mochilaBuscarBinaria
+ * Realiza busca binaria pelo nome (REQUER MOCHILA ORDENADA POR NOME ou
+ * indices secundarios ligados - ver mochilaBuscaBinariaDisponivel).
+ * Se os itens nao estao em ordem de nome, a busca percorre o indice
+ * secundario de NOME.
+ *
+ * Complexidade: O(log n) - divide o espaco de busca pela metade a cada passo
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, acumula as comparacoes feitas
+ *
+ * Retorno: indice do item se encontrado, -1 caso contrario
+ */
+int mochilaBuscarBinaria(const Mochila* mochila, const char* nome, Estatisticas* estatisticas) {
+    uint64_t inicio = latenciaMarcar();
+    int resultado = buscarBinaria(mochila, nome, estatisticas);
+    latenciaRegistrar(LATENCIA_BUSCA_BINARIA, inicio);
+    return resultado;
+}
+
+// ============================================================================
+// ORDENACAO
+// ============================================================================
+
+/*
+ * Funcao: concluirOrdenacao
+ * Refaz o indice hash e os indices secundarios com as posicoes novas e
+ * marca a ordem da mochila.
+ *
+ * Parametros:
+ *   - indicesRefeitos: resultado da compactacao feita antes de ordenar
+ *
+ * Retorno: 1 se todos os indices foram refeitos, 0 se faltou memoria
+ */
+static int concluirOrdenacao(Mochila* mochila, CriterioOrdenacao criterio, int indicesRefeitos) {
+    if (!indiceHashReconstruir(&mochila->indiceNome, mochila->itens, mochila->total)) {
+        indicesRefeitos = 0;
+    }
+    if (!reconstruirIndices(mochila)) {
+        indicesRefeitos = 0;
+    }
+    mochila->ordenada = true;
+    mochila->criterioOrdem = criterio;
+    return indicesRefeitos;
+}
+
+// Corpo de mochilaOrdenar, que mede a latencia (latencia.h)
+static long ordenar(Mochila* mochila, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                    Estatisticas* estatisticas) {
+    int indicesRefeitos = mochilaCompactar(mochila);
+
+    mochila->algoritmoUsado = algoritmoEfetivo(mochila->itens, mochila->total, criterio, algoritmo);
+    long comparacoes = ordenarItens(mochila->itens, mochila->total, criterio, algoritmo, estatisticas);
+
+    return concluirOrdenacao(mochila, criterio, indicesRefeitos) ? comparacoes : -1;
+}
+
+/*
+ * Funcao: mochilaOrdenar
+ * Ordena a mochila pelo criterio informado usando o algoritmo escolhido
+ * (ver ordenacao.h).
+ * As lapides sao descartadas antes (compactacao), para que nao participem
+ * das comparacoes. Como as posicoes mudam, o indice hash e reconstruido
+ * ao final (O(n)).
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, acumula comparacoes, trocas e movimentos
+ *
+ * Retorno: numero de comparacoes realizadas (analise de desempenho), ou -1
+ * se faltou memoria para refazer os indices. O indice hash so fica sem
+ * refazer se a tabela atual nao comporta os itens, o que nao acontece ao
+ * ordenar; os indices secundarios que falharem sao desligados.
+ */
+long mochilaOrdenar(Mochila* mochila, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                    Estatisticas* estatisticas) {
+    uint64_t inicio = latenciaMarcar();
+    long comparacoes = ordenar(mochila, criterio, algoritmo, estatisticas);
+    latenciaRegistrar(LATENCIA_ORDENAR, inicio);
+    return comparacoes;
+}
+
+/*
+ * Funcao: mochilaOrdenarRapido
+ * Ordena com o algoritmo mais rapido para o criterio. Nome usa Radix
+ * Sort (estavel, sem strcmp). Tipo e prioridade sao chaves inteiras e
+ * usam Counting Sort quando a faixa e pequena (sempre, no caso do tipo,
+ * que tem poucas categorias); senao, Merge Sort se a ordenacao precisa ser estavel
+ * (itens empatados mantem a ordem relativa) ou Introsort se nao precisa
+ * (sem vetor auxiliar). E o unico caminho da Mochila em que o algoritmo
+ * e escolhido pela biblioteca.
+ *
+ * Retorno: numero de comparacoes realizadas
+ */
+long mochilaOrdenarRapido(Mochila* mochila, CriterioOrdenacao criterio, bool estavel,
+                          Estatisticas* estatisticas) {
+    if (criterio == NOME) {
+        return mochilaOrdenar(mochila, criterio, RADIX_SORT, estatisticas);
+    }
+    // Counting Sort se a faixa for pequena, senao Merge Sort (ver algoritmoEfetivo)
+    AlgoritmoOrdenacao algoritmo = algoritmoEfetivo(mochila->itens, mochila->total, criterio, COUNTING_SORT);
+    if (algoritmo != COUNTING_SORT && !estavel) {
+        algoritmo = INTRO_SORT;
+    }
+    return mochilaOrdenar(mochila, criterio, algoritmo, estatisticas);
+}
+
+// Corpo de mochilaOrdenarPorIndices, que mede a latencia (latencia.h)
+static long ordenarPorIndices(Mochila* mochila, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                              Estatisticas* estatisticas) {
+    int indicesRefeitos = mochilaCompactar(mochila);
+
+    int n = mochila->total;
+    int* ordem = (int*)malloc(sizeof(int) * (size_t)(n > 0 ? n : 1));
+    if (ordem == NULL) {
+        return ordenar(mochila, criterio, algoritmo, estatisticas);
+    }
+
+    preencherIndices(ordem, n);
+    mochila->algoritmoUsado = algoritmoEfetivo(mochila->itens, n, criterio, algoritmo);
+    long comparacoes = ordenarIndices(mochila->itens, ordem, n, criterio, algoritmo, estatisticas);
+    aplicarPermutacao(mochila->itens, ordem, n, estatisticas);
+    free(ordem);
+
+    return concluirOrdenacao(mochila, criterio, indicesRefeitos) ? comparacoes : -1;
+}
+
+/*
+ * Funcao: mochilaOrdenarPorIndices
+ * Mesmo resultado de mochilaOrdenar, mas o algoritmo ordena um vetor de
+ * posicoes (int) em vez de trocar os itens inteiros; a permutacao final
+ * e aplicada aos itens uma unica vez, em O(n).
+ *
+ * Com os algoritmos quadraticos a diferenca e grande: o Bubble Sort faz
+ * ate n^2/2 trocas, cada uma movendo 4 bytes em vez de sizeof(Item).
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, acumula comparacoes, trocas e
+ *                   movimentos (dos indices e da permutacao final)
+ *
+ * Retorno: numero de comparacoes realizadas, ou -1 como em mochilaOrdenar.
+ * Se faltar memoria para o vetor de posicoes, ordena os itens diretamente
+ * (mochilaOrdenar).
+ */
+long mochilaOrdenarPorIndices(Mochila* mochila, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                              Estatisticas* estatisticas) {
+    uint64_t inicio = latenciaMarcar();
+    long comparacoes = ordenarPorIndices(mochila, criterio, algoritmo, estatisticas);
+    latenciaRegistrar(LATENCIA_ORDENAR, inicio);
+    return comparacoes;
+}
+
+/*
+ * Funcao: mochilaMedirOrdenacao
+ * Mede o tempo de ordenar a mochila sem altera-la: os itens vivos sao
+ * copiados uma vez e cada repeticao ordena a copia restaurada (ver
+ * cronometroMedirOrdenacao). A ordenacao de verdade continua sendo
+ * feita por mochilaOrdenar ou mochilaOrdenarPorIndices.
+ *
+ * Parametros:
+ *   - porIndices: mede como mochilaOrdenarPorIndices em vez de mochilaOrdenar
+ *   - medicao: recebe minimo, mediana e p99 das repeticoes
+ *
+ * Retorno: 1 se sucesso, 0 se faltou memoria
+ */
+int mochilaMedirOrdenacao(const Mochila* mochila, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                          bool porIndices, int repeticoes, Medicao* medicao) {
+    Item* vivos = (Item*)malloc(sizeof(Item) * (size_t)(mochila->total > 0 ? mochila->total : 1));
+    if (vivos == NULL) {
+        return 0;
+    }
+
+    int n = 0;
+    for (int i = 0; i < mochila->total; i++) {
+        if (!estaRemovido(mochila, i)) {
+            vivos[n++] = mochila->itens[i];
+        }
+    }
+
+    int resultado = cronometroMedirOrdenacao(vivos, n, criterio, algoritmo, porIndices, repeticoes, medicao);
+    free(vivos);
+    return resultado;
+}
+
+/*
+ * Funcao: mochilaUltimoAlgoritmo
+ * Algoritmo executado na ultima ordenacao. Pode diferir do pedido quando
+ * o pedido nao se aplica ao criterio, ou quando e COUNTING_SORT e a faixa
+ * de valores e grande (ver algoritmoEfetivo).
+ */
+AlgoritmoOrdenacao mochilaUltimoAlgoritmo(const Mochila* mochila) {
+    return mochila->algoritmoUsado;
+}
+
+/*
+ * Funcao: mochilaOrdenadaPorNome
+ * Indica se os itens estao em ordem de nome, isto e, se a busca binaria
+ * por nome pode ser usada.
+ */
+bool mochilaOrdenadaPorNome(const Mochila* mochila) {
+    return mochila->ordenada && mochila->criterioOrdem == NOME;
+}
+
+/*
+ * Funcao: mochilaDefinirInsercaoOrdenada
+ * Liga ou desliga o modo "sempre ordenada por nome". Ao ligar, a mochila
+ * e ordenada por nome (Radix Sort) se ainda nao estiver; a partir dai
+ * cada insercao vai direto para sua posicao e a remocao preserva a ordem,
+ * de modo que a busca binaria fica sempre disponivel.
+ *
+ * Ordenar por outro criterio suspende o modo (as insercoes voltam a ir
+ * para o final); ele volta a valer na proxima ordenacao por nome.
+ *
+ * Retorno: comparacoes gastas na ordenacao inicial (0 se nao precisou)
+ */
+long mochilaDefinirInsercaoOrdenada(Mochila* mochila, bool ativo) {
+    long comparacoes = 0;
+
+    mochila->insercaoOrdenada = ativo;
+    if (ativo && !mochilaOrdenadaPorNome(mochila)) {
+        comparacoes = mochilaOrdenarRapido(mochila, NOME, true, NULL);
+    }
+    return comparacoes;
+}
+
+// ============================================================================
+// INDICES SECUNDARIOS
+// ============================================================================
+
+/*
+ * Funcao: mochilaDefinirIndicesSecundarios
+ * Liga ou desliga os indices secundarios por NOME, TIPO e PRIORIDADE.
+ * Ligados, eles sao atualizados em cada insercao e remocao (O(log n)
+ * comparacoes + deslocamento de ints), e a mochila pode ser listada em
+ * qualquer ordem e pesquisada por busca binaria a qualquer momento, sem
+ * reordenar os itens.
+ *
+ * Retorno: 1 se sucesso, 0 se faltou memoria (os indices ficam desligados)
+ */
+int mochilaDefinirIndicesSecundarios(Mochila* mochila, bool ativo) {
+    if (!ativo) {
+        for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+            indiceOrdenadoLiberar(&mochila->indicesOrdem[c]);
+        }
+        mochila->indicesSecundarios = false;
+        return 1;
+    }
+
+    if (mochila->indicesSecundarios) {
+        return 1;
+    }
+
+    // Se faltar memoria, reconstruirIndices desliga os indices de novo
+    mochila->indicesSecundarios = true;
+    return reconstruirIndices(mochila);
+}
+
+/*
+ * Funcao: mochilaBuscaBinariaDisponivel
+ * Indica se mochilaBuscarBinaria pode ser usada agora: itens em ordem de
+ * nome ou indice secundario de nome ligado.
+ */
+bool mochilaBuscaBinariaDisponivel(const Mochila* mochila) {
+    return mochila->indicesSecundarios || mochilaOrdenadaPorNome(mochila);
+}
+
+/*
+ * Funcao: mochilaItemOrdenado
+ * Retorna o i-esimo item na ordem do criterio, pelo indice secundario.
+ *
+ * Retorno: o item, ou NULL se fora dos limites ou indices desligados
+ */
+const Item* mochilaItemOrdenado(const Mochila* mochila, CriterioOrdenacao criterio, int indice) {
+    const IndiceOrdenado* ordem = &mochila->indicesOrdem[criterio];
+
+    if (!mochila->indicesSecundarios || indice < 0 || indice >= ordem->total) {
+        return NULL;
+    }
+    return &mochila->itens[ordem->ordem[indice]];
+}
+
+/*
+ * Funcao: mochilaPercorrerOrdenado
+ * Visita os itens na ordem do criterio sem alterar a mochila. Usa o
+ * indice secundario; com os indices desligados, monta uma visao
+ * temporaria (Radix Sort das posicoes).
+ */
+void mochilaPercorrerOrdenado(const Mochila* mochila, CriterioOrdenacao criterio,
+                              void (*visitar)(const Item* item, int posicao, void* contexto),
+                              void* contexto) {
+    if (mochila->indicesSecundarios) {
+        const IndiceOrdenado* ordem = &mochila->indicesOrdem[criterio];
+        for (int i = 0; i < ordem->total; i++) {
+            visitar(&mochila->itens[ordem->ordem[i]], i, contexto);
+        }
+        return;
+    }
+
+    VisaoMochila visao;
+    if (mochilaCriarVisao(mochila, &visao, criterio, RADIX_SORT, NULL)) {
+        mochilaPercorrerVisao(mochila, &visao, visitar, contexto);
+        mochilaLiberarVisao(&visao);
+    }
+}
+
+// ============================================================================
+// AGREGADOS
+// ============================================================================
+
+/*
+ * Funcao: mochilaAgregadoTipo
+ * Itens e soma das quantidades de um tipo (ex.: total de municao).
+ *
+ * Complexidade: O(1) - os contadores sao mantidos a cada insercao/remocao
+ */
+Agregado mochilaAgregadoTipo(const Mochila* mochila, unsigned short idTipo) {
+    return agregadosConsultar(&mochila->agregadosTipo, idTipo);
+}
+
+/*
+ * Funcao: mochilaAgregadoPrioridade
+ * Itens e soma das quantidades de uma prioridade. Prioridades negativas
+ * ou a partir de LIMITE_CHAVE_AGREGADA nao sao agrupadas (retorna zero).
+ *
+ * Complexidade: O(1)
+ */
+Agregado mochilaAgregadoPrioridade(const Mochila* mochila, int prioridade) {
+    return agregadosConsultar(&mochila->agregadosPrioridade, prioridade);
+}
+
+/*
+ * Funcao: mochilaAgregadoGeral
+ * Itens e soma das quantidades da mochila inteira.
+ *
+ * Complexidade: O(1)
+ */
+Agregado mochilaAgregadoGeral(const Mochila* mochila) {
+    return mochila->agregadoGeral;
+}
+
+// ============================================================================
+// VISOES ORDENADAS
+// ============================================================================
+
+/*
+ * Funcao: mochilaCriarVisao
+ * Cria uma visao ordenada da mochila sem alterar a mochila. As lapides
+ * ficam de fora da visao.
+ *
+ * Complexidade: a do algoritmo escolhido; memoria extra de um int por item
+ *
+ * Parametros:
+ *   - visao: visao a preencher (liberar com mochilaLiberarVisao)
+ *   - estatisticas: se nao for NULL, acumula comparacoes, trocas e movimentos
+ *
+ * Retorno: 1 se criou, 0 se faltou memoria
+ */
+int mochilaCriarVisao(const Mochila* mochila, VisaoMochila* visao, CriterioOrdenacao criterio,
+                      AlgoritmoOrdenacao algoritmo, Estatisticas* estatisticas) {
+    int vivos = mochilaTotal(mochila);
+
+    visao->ordem = (int*)malloc(sizeof(int) * (size_t)(vivos > 0 ? vivos : 1));
+    visao->total = 0;
+    visao->criterio = criterio;
+    if (visao->ordem == NULL) {
+        return 0;
+    }
+
+    for (int i = 0; i < mochila->total; i++) {
+        if (!estaRemovido(mochila, i)) {
+            visao->ordem[visao->total++] = i;
+        }
+    }
+
+    ordenarIndices(mochila->itens, visao->ordem, visao->total, criterio, algoritmo, estatisticas);
+    return 1;
+}
+
+/*
+ * Funcao: mochilaLiberarVisao
+ * Libera o vetor de posicoes da visao.
+ */
+void mochilaLiberarVisao(VisaoMochila* visao) {
+    free(visao->ordem);
+    visao->ordem = NULL;
+    visao->total = 0;
+}
+
+/*
+ * Funcao: mochilaVisaoItem
+ * Retorna o i-esimo item na ordem da visao (ou NULL se fora dos limites).
+ */
+const Item* mochilaVisaoItem(const Mochila* mochila, const VisaoMochila* visao, int indice) {
+    if (indice < 0 || indice >= visao->total) {
+        return NULL;
+    }
+    return &mochila->itens[visao->ordem[indice]];
+}
+
+/*
+ * Funcao: mochilaPercorrerVisao
+ * Visita os itens na ordem da visao. A posicao passada ao visitante e a
+ * posicao na visao (0, 1, 2, ...).
+ */
+void mochilaPercorrerVisao(const Mochila* mochila, const VisaoMochila* visao,
+                           void (*visitar)(const Item* item, int posicao, void* contexto),
+                           void* contexto) {
+    for (int i = 0; i < visao->total; i++) {
+        visitar(&mochila->itens[visao->ordem[i]], i, contexto);
+    }
+}
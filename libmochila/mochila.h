@@ -0,0 +1,199 @@
+/*
+ * LIBMOCHILA - NUCLEO DO INVENTARIO FREE FIRE
+ *
+ * Descricao: Motor de inventario sem interface (headless) compartilhado
+ * pelos quatro programas (novato, aventureiro, mestre e FreeFire).
+ * Nenhuma funcao desta biblioteca le do teclado ou imprime na tela:
+ * as interfaces de menu chamam esta API e cuidam da apresentacao.
+ */
+
+#ifndef MOCHILA_H
+#define MOCHILA_H
+
+#include <stdbool.h>
+
+#include "item.h"
+#include "agregados.h"
+#include "cronometro.h"
+#include "indice_hash.h"
+#include "indice_ordenado.h"
+#include "ordenacao.h"
+
+// ============================================================================
+// ESTRUTURAS DE DADOS
+// ============================================================================
+
+#define FATOR_CRESCIMENTO_PADRAO 2.0   // Capacidade multiplicada a cada realocacao
+#define FATOR_CRESCIMENTO_MINIMO 1.1
+#define LIMITE_REMOVIDOS_PADRAO 0.25    // Fracao de lapides que dispara a compactacao
+
+/*
+ * Struct: Mochila
+ * Inventario sequencial (vetor dinamico). O vetor cresce sozinho quando
+ * fica cheio, multiplicando a capacidade pelo fator de crescimento, o que
+ * mantem a insercao no final em O(1) amortizado.
+ *
+ * Campos:
+ *   - itens: vetor alocado com os itens
+ *   - total: quantidade de posicoes ocupadas (itens vivos + lapides)
+ *   - capacidade: quantidade de itens que cabem no vetor alocado
+ *   - fatorCrescimento: multiplicador da capacidade ao crescer (> 1)
+ *   - encolherAutomatico: se true, a remocao devolve memoria quando a
+ *                         ocupacao cai abaixo de 1/4 da capacidade
+ *   - lapides: marca (1) as posicoes removidas no modo de remocao
+ *              preguicosa; NULL enquanto o modo nunca foi ligado
+ *   - removidos: quantidade de lapides no vetor
+ *   - remocaoPreguicosa: se true, remover apenas marca a posicao como
+ *                        lapide, sem mover nenhum item
+ *   - limiteRemovidos: fracao de lapides (sobre total) que dispara uma
+ *                      compactacao unica do vetor
+ *   - indiceNome: indice hash nome -> posicao, mantido em toda insercao/remocao
+ *   - ordenada: true depois de mochilaOrdenar; a remocao preserva a ordem
+ *               (deslocando) somente enquanto esta flag estiver ligada
+ *   - criterioOrdem: criterio da ultima ordenacao (vale se ordenada)
+ *   - algoritmoUsado: algoritmo executado na ultima ordenacao
+ *   - insercaoOrdenada: se true e a mochila esta ordenada por nome, a
+ *                       insercao coloca o item na posicao certa em vez
+ *                       de no final, e a mochila continua ordenada
+ *   - indicesSecundarios: se true, indicesOrdem e mantido a cada operacao
+ *   - indicesOrdem: um indice ordenado por criterio (NOME, TIPO e
+ *                   PRIORIDADE), para listar em qualquer ordem e fazer
+ *                   busca binaria por nome sem reordenar os itens
+ *   - agregadosTipo / agregadosPrioridade: itens e soma das quantidades
+ *                   por id de tipo e por prioridade, atualizados a cada
+ *                   insercao e remocao
+ *   - agregadoGeral: itens e soma das quantidades da mochila inteira
+ */
+typedef struct {
+    Item* itens;
+    int total;
+    int capacidade;
+    double fatorCrescimento;
+    bool encolherAutomatico;
+    unsigned char* lapides;
+    int removidos;
+    bool remocaoPreguicosa;
+    double limiteRemovidos;
+    IndiceHash indiceNome;
+    bool ordenada;
+    CriterioOrdenacao criterioOrdem;
+    AlgoritmoOrdenacao algoritmoUsado;
+    bool insercaoOrdenada;
+    bool indicesSecundarios;
+    IndiceOrdenado indicesOrdem[TOTAL_CRITERIOS];
+    TabelaAgregados agregadosTipo;
+    TabelaAgregados agregadosPrioridade;
+    Agregado agregadoGeral;
+} Mochila;
+
+/*
+ * Struct: VisaoMochila
+ * Uma ordenacao da mochila guardada como vetor de posicoes, sem mover os
+ * itens. Varias visoes (por nome, tipo, prioridade) podem coexistir sobre
+ * a mesma mochila. A visao vale enquanto a mochila nao for alterada:
+ * inserir, remover, compactar ou ordenar exige criar a visao de novo.
+ *
+ * Campos:
+ *   - ordem: posicoes dos itens vivos na ordem do criterio
+ *   - total: quantidade de posicoes em ordem
+ *   - criterio: criterio usado na ordenacao
+ */
+typedef struct {
+    int* ordem;
+    int total;
+    CriterioOrdenacao criterio;
+} VisaoMochila;
+
+// ============================================================================
+// CICLO DE VIDA
+// ============================================================================
+
+int mochilaIniciar(Mochila* mochila, int capacidade);
+void mochilaLiberar(Mochila* mochila);
+
+// ============================================================================
+// GERENCIAMENTO DE CAPACIDADE
+// ============================================================================
+
+int mochilaReservar(Mochila* mochila, int capacidade);
+int mochilaAjustarCapacidade(Mochila* mochila);
+void mochilaDefinirCrescimento(Mochila* mochila, double fator);
+void mochilaDefinirEncolhimento(Mochila* mochila, bool ativo);
+
+// ============================================================================
+// REMOCAO PREGUICOSA (LAPIDES)
+// ============================================================================
+
+int mochilaDefinirRemocaoPreguicosa(Mochila* mochila, bool ativo, double limite);
+int mochilaCompactar(Mochila* mochila);
+int mochilaRemovidos(const Mochila* mochila);
+
+// ============================================================================
+// OPERACOES BASICAS
+// ============================================================================
+
+int mochilaInserir(Mochila* mochila, Item item);
+int mochilaInserirLote(Mochila* mochila, const Item* itens, int total);
+int mochilaRemover(Mochila* mochila, const char* nome);
+int mochilaAlterarQuantidade(Mochila* mochila, const char* nome, int quantidade);
+int mochilaTotal(const Mochila* mochila);
+int mochilaCapacidade(const Mochila* mochila);
+const Item* mochilaItem(const Mochila* mochila, int indice);
+void mochilaPercorrer(const Mochila* mochila,
+                      void (*visitar)(const Item* item, int posicao, void* contexto),
+                      void* contexto);
+int mochilaPercorrerPorTipo(const Mochila* mochila, unsigned short idTipo,
+                            void (*visitar)(const Item* item, int posicao, void* contexto),
+                            void* contexto);
+
+// ============================================================================
+// BUSCA E ORDENACAO
+// ============================================================================
+
+int mochilaBuscar(const Mochila* mochila, const char* nome, Estatisticas* estatisticas);
+int mochilaBuscarSequencial(const Mochila* mochila, const char* nome, Estatisticas* estatisticas);
+int mochilaBuscarBinaria(const Mochila* mochila, const char* nome, Estatisticas* estatisticas);
+long mochilaOrdenar(Mochila* mochila, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                    Estatisticas* estatisticas);
+long mochilaOrdenarRapido(Mochila* mochila, CriterioOrdenacao criterio, bool estavel,
+                          Estatisticas* estatisticas);
+long mochilaOrdenarPorIndices(Mochila* mochila, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                              Estatisticas* estatisticas);
+int mochilaMedirOrdenacao(const Mochila* mochila, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                          bool porIndices, int repeticoes, Medicao* medicao);
+AlgoritmoOrdenacao mochilaUltimoAlgoritmo(const Mochila* mochila);
+bool mochilaOrdenadaPorNome(const Mochila* mochila);
+long mochilaDefinirInsercaoOrdenada(Mochila* mochila, bool ativo);
+
+// ============================================================================
+// INDICES SECUNDARIOS (NOME, TIPO E PRIORIDADE AO MESMO TEMPO)
+// ============================================================================
+
+int mochilaDefinirIndicesSecundarios(Mochila* mochila, bool ativo);
+bool mochilaBuscaBinariaDisponivel(const Mochila* mochila);
+const Item* mochilaItemOrdenado(const Mochila* mochila, CriterioOrdenacao criterio, int indice);
+void mochilaPercorrerOrdenado(const Mochila* mochila, CriterioOrdenacao criterio,
+                              void (*visitar)(const Item* item, int posicao, void* contexto),
+                              void* contexto);
+
+// ============================================================================
+// AGREGADOS (CONSULTA EM O(1), SEM PERCORRER OS ITENS)
+// ============================================================================
+
+Agregado mochilaAgregadoTipo(const Mochila* mochila, unsigned short idTipo);
+Agregado mochilaAgregadoPrioridade(const Mochila* mochila, int prioridade);
+Agregado mochilaAgregadoGeral(const Mochila* mochila);
+
+// ============================================================================
+// VISOES ORDENADAS (SEM MOVER OS ITENS)
+// ============================================================================
+
+int mochilaCriarVisao(const Mochila* mochila, VisaoMochila* visao, CriterioOrdenacao criterio,
+                      AlgoritmoOrdenacao algoritmo, Estatisticas* estatisticas);
+void mochilaLiberarVisao(VisaoMochila* visao);
+const Item* mochilaVisaoItem(const Mochila* mochila, const VisaoMochila* visao, int indice);
+void mochilaPercorrerVisao(const Mochila* mochila, const VisaoMochila* visao,
+                           void (*visitar)(const Item* item, int posicao, void* contexto),
+                           void* contexto);
+
+#endif
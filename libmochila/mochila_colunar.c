@@ -0,0 +1,693 @@
+/*
+ * LIBMOCHILA - MOCHILA EM COLUNAS
+ *
+ * Implementacao do inventario em colunas: insercao, remocao (direta ou por
+ * lapides), buscas, varreduras numericas, agregados e ordenacao por
+ * permutacao das colunas. O indice hash, os agregados e os algoritmos de
+ * ordenacao sao os mesmos da Mochila.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mochila.h"
+#include "mochila_colunar.h"
+
+#define CAPACIDADE_MINIMA 4     // Menor coluna alocada quando a mochila cresce
+
+// Bytes de uma linha somando todas as colunas (movimentos da permutacao)
+#define BYTES_LINHA (sizeof(uint64_t) + TAM_NOME + sizeof(unsigned short) + 2 * sizeof(int))
+
+// ============================================================================
+// CICLO DE VIDA E CAPACIDADE
+// ============================================================================
+
+/*
+ * Funcao: colunarIniciar
+ * Inicializa a mochila vazia com espaco para "capacidade" itens.
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int colunarIniciar(MochilaColunar* mochila, int capacidade) {
+    memset(mochila, 0, sizeof(MochilaColunar));
+    mochila->limiteRemovidos = LIMITE_REMOVIDOS_PADRAO;
+    mochila->criterioOrdem = NOME;
+    mochila->algoritmoUsado = INSERTION_SORT;
+    agregadosIniciar(&mochila->agregadosTipo);
+    agregadosIniciar(&mochila->agregadosPrioridade);
+
+    if (!indiceHashIniciar(&mochila->indiceNome, capacidade)) {
+        return 0;
+    }
+    if (capacidade > 0 && !colunarReservar(mochila, capacidade)) {
+        colunarLiberar(mochila);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Funcao: colunarLiberar
+ * Libera todas as colunas, o indice e os agregados.
+ */
+void colunarLiberar(MochilaColunar* mochila) {
+    free(mochila->prefixos);
+    free(mochila->nomes);
+    free(mochila->tipos);
+    free(mochila->quantidades);
+    free(mochila->prioridades);
+    free(mochila->lapides);
+    indiceHashLiberar(&mochila->indiceNome);
+    agregadosLiberar(&mochila->agregadosTipo);
+    agregadosLiberar(&mochila->agregadosPrioridade);
+    memset(mochila, 0, sizeof(MochilaColunar));
+}
+
+/*
+ * Funcao: realocarColuna
+ * Realoca uma coluna para "capacidade" linhas de "tamanho" bytes.
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (a coluna antiga continua valida)
+ */
+static int realocarColuna(void** coluna, size_t tamanho, int capacidade) {
+    void* nova = realloc(*coluna, tamanho * (size_t)capacidade);
+    if (nova == NULL) {
+        return 0;
+    }
+    *coluna = nova;
+    return 1;
+}
+
+/*
+ * Funcao: colunarReservar
+ * Garante espaco para pelo menos "capacidade" itens em todas as colunas
+ * (e nas marcas de lapide, quando existem).
+ * Se uma realocacao falhar no meio, as colunas ja realocadas ficam maiores,
+ * mas a capacidade registrada so muda quando todas conseguem.
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int colunarReservar(MochilaColunar* mochila, int capacidade) {
+    if (capacidade <= mochila->capacidade) {
+        return 1;
+    }
+
+    if (!realocarColuna((void**)&mochila->prefixos, sizeof(uint64_t), capacidade) ||
+        !realocarColuna((void**)&mochila->nomes, sizeof(mochila->nomes[0]), capacidade) ||
+        !realocarColuna((void**)&mochila->tipos, sizeof(unsigned short), capacidade) ||
+        !realocarColuna((void**)&mochila->quantidades, sizeof(int), capacidade) ||
+        !realocarColuna((void**)&mochila->prioridades, sizeof(int), capacidade)) {
+        return 0;
+    }
+
+    if (mochila->lapides != NULL || mochila->remocaoPreguicosa) {
+        if (!realocarColuna((void**)&mochila->lapides, 1, capacidade)) {
+            return 0;
+        }
+        memset(mochila->lapides + mochila->capacidade, 0, (size_t)(capacidade - mochila->capacidade));
+    }
+
+    mochila->capacidade = capacidade;
+    return 1;
+}
+
+// ============================================================================
+// REMOCAO PREGUICOSA (LAPIDES)
+// ============================================================================
+
+/*
+ * Funcao: estaRemovida
+ * Indica se a linha guarda uma lapide.
+ */
+static bool estaRemovida(const MochilaColunar* mochila, int linha) {
+    return mochila->removidos > 0 && mochila->lapides[linha];
+}
+
+/*
+ * Funcao: copiarLinha
+ * Copia a linha "origem" para a linha "destino" em todas as colunas.
+ */
+static void copiarLinha(MochilaColunar* mochila, int destino, int origem) {
+    mochila->prefixos[destino] = mochila->prefixos[origem];
+    memcpy(mochila->nomes[destino], mochila->nomes[origem], TAM_NOME);
+    mochila->tipos[destino] = mochila->tipos[origem];
+    mochila->quantidades[destino] = mochila->quantidades[origem];
+    mochila->prioridades[destino] = mochila->prioridades[origem];
+}
+
+/*
+ * Funcao: colunarDefinirRemocaoPreguicosa
+ * Liga ou desliga a remocao por lapides, como
+ * mochilaDefinirRemocaoPreguicosa: remover so marca a linha, e uma
+ * compactacao O(n) tira todas as lapides quando passam de "limite".
+ *
+ * Parametros:
+ *   - ativo: liga (true) ou desliga (false) o modo; desligar compacta
+ *   - limite: fracao de lapides entre 0 e 1 (<= 0 usa o padrao)
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int colunarDefinirRemocaoPreguicosa(MochilaColunar* mochila, bool ativo, double limite) {
+    if (limite <= 0.0 || limite > 1.0) {
+        limite = LIMITE_REMOVIDOS_PADRAO;
+    }
+    mochila->limiteRemovidos = limite;
+
+    if (!ativo) {
+        mochila->remocaoPreguicosa = false;
+        return colunarCompactar(mochila);
+    }
+
+    if (mochila->lapides == NULL && mochila->capacidade > 0) {
+        mochila->lapides = (unsigned char*)calloc((size_t)mochila->capacidade, 1);
+        if (mochila->lapides == NULL) {
+            return 0;
+        }
+    }
+
+    mochila->remocaoPreguicosa = true;
+    return 1;
+}
+
+/*
+ * Funcao: colunarCompactar
+ * Remove todas as lapides de uma vez, copiando cada linha viva uma unica
+ * vez para a primeira linha livre (a ordem relativa e preservada) e
+ * reconstruindo o indice hash.
+ *
+ * Complexidade: O(n)
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao no indice)
+ */
+int colunarCompactar(MochilaColunar* mochila) {
+    if (mochila->removidos == 0) {
+        return 1;
+    }
+
+    int destino = 0;
+    for (int i = 0; i < mochila->total; i++) {
+        if (mochila->lapides[i]) {
+            mochila->lapides[i] = 0;
+            continue;
+        }
+        if (destino != i) {
+            copiarLinha(mochila, destino, i);
+        }
+        destino++;
+    }
+
+    mochila->total = destino;
+    mochila->removidos = 0;
+    return indiceHashReconstruirNomes(&mochila->indiceNome, mochila->nomes, mochila->total);
+}
+
+/*
+ * Funcao: colunarRemovidos
+ * Retorna quantas lapides aguardam a proxima compactacao.
+ */
+int colunarRemovidos(const MochilaColunar* mochila) {
+    return mochila->removidos;
+}
+
+// ============================================================================
+// OPERACOES BASICAS
+// ============================================================================
+
+/*
+ * Funcao: contarLinha
+ * Soma (sinal = 1) ou desconta (sinal = -1) a linha nos agregados.
+ */
+static void contarLinha(MochilaColunar* mochila, int linha, int sinal) {
+    int quantidade = mochila->quantidades[linha];
+
+    if (sinal > 0) {
+        agregadosAdicionar(&mochila->agregadosTipo, mochila->tipos[linha], quantidade);
+        agregadosAdicionar(&mochila->agregadosPrioridade, mochila->prioridades[linha], quantidade);
+    } else {
+        agregadosRetirar(&mochila->agregadosTipo, mochila->tipos[linha], quantidade);
+        agregadosRetirar(&mochila->agregadosPrioridade, mochila->prioridades[linha], quantidade);
+    }
+    mochila->agregadoGeral.itens += sinal;
+    mochila->agregadoGeral.quantidade += (long long)sinal * quantidade;
+}
+
+/*
+ * Funcao: colunarInserir
+ * Insere o item no final, espalhando seus campos pelas colunas, e o
+ * registra no indice hash e nos agregados.
+ *
+ * Complexidade: O(1) amortizado (as colunas dobram quando enchem)
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (erro de alocacao)
+ */
+int colunarInserir(MochilaColunar* mochila, Item item) {
+    if (mochila->total == mochila->capacidade) {
+        int nova = mochila->capacidade > 0 ? mochila->capacidade * 2 : CAPACIDADE_MINIMA;
+        if (!colunarReservar(mochila, nova)) {
+            return 0;
+        }
+    }
+
+    if (!agregadosReservar(&mochila->agregadosTipo, item.idTipo) ||
+        !agregadosReservar(&mochila->agregadosPrioridade, item.prioridade)) {
+        return 0;
+    }
+
+    int i = mochila->total;
+    if (!indiceHashInserir(&mochila->indiceNome, item.nome, i)) {
+        return 0;
+    }
+
+    mochila->prefixos[i] = prefixoNome(item.nome);
+    memcpy(mochila->nomes[i], item.nome, TAM_NOME);
+    mochila->tipos[i] = item.idTipo;
+    mochila->quantidades[i] = item.quantidade;
+    mochila->prioridades[i] = item.prioridade;
+    contarLinha(mochila, i, 1);
+    mochila->total++;
+    mochila->ordenada = false;
+    return 1;
+}
+
+/*
+ * Funcao: moverLinhas
+ * Copia "quantidade" linhas a partir de origem para destino, em todas as
+ * colunas (as faixas podem se sobrepor).
+ */
+static void moverLinhas(MochilaColunar* mochila, int destino, int origem, int quantidade) {
+    size_t n = (size_t)quantidade;
+    memmove(&mochila->prefixos[destino], &mochila->prefixos[origem], sizeof(uint64_t) * n);
+    memmove(mochila->nomes[destino], mochila->nomes[origem], sizeof(mochila->nomes[0]) * n);
+    memmove(&mochila->tipos[destino], &mochila->tipos[origem], sizeof(unsigned short) * n);
+    memmove(&mochila->quantidades[destino], &mochila->quantidades[origem], sizeof(int) * n);
+    memmove(&mochila->prioridades[destino], &mochila->prioridades[origem], sizeof(int) * n);
+}
+
+/*
+ * Funcao: colunarRemover
+ * Remove um item pelo nome, localizado pelo indice hash. Como em
+ * mochilaRemover: no modo preguicoso a linha vira lapide; senao, se a
+ * mochila nao esta ordenada, a ultima linha ocupa o lugar da removida, e
+ * se esta, as linhas seguintes sao deslocadas para manter a ordem.
+ *
+ * Complexidade: O(1) sem ordenacao ou no modo preguicoso,
+ *               O(n) com a mochila ordenada
+ *
+ * Retorno: 1 se sucesso, 0 se nao encontrado
+ */
+int colunarRemover(MochilaColunar* mochila, const char* nome) {
+    int encontrado = colunarBuscar(mochila, nome, NULL);
+    if (encontrado == -1) {
+        return 0;
+    }
+
+    int ultimo = mochila->total - 1;
+    indiceHashRemover(&mochila->indiceNome, mochila->nomes[encontrado], encontrado);
+    contarLinha(mochila, encontrado, -1);
+
+    if (mochila->remocaoPreguicosa) {
+        mochila->lapides[encontrado] = 1;
+        mochila->removidos++;
+        if (mochila->removidos > mochila->limiteRemovidos * mochila->total) {
+            colunarCompactar(mochila);
+        }
+        return 1;
+    }
+
+    if (mochila->ordenada) {
+        moverLinhas(mochila, encontrado, encontrado + 1, ultimo - encontrado);
+        indiceHashDeslocar(&mochila->indiceNome, encontrado + 1, -1);
+    } else if (encontrado != ultimo) {
+        copiarLinha(mochila, encontrado, ultimo);
+        indiceHashMover(&mochila->indiceNome, mochila->nomes[encontrado], ultimo, encontrado);
+    }
+    mochila->total--;
+    return 1;
+}
+
+/*
+ * Funcao: colunarAlterarQuantidade
+ * Troca a quantidade do item, acompanhando os agregados (como
+ * mochilaAlterarQuantidade). So a coluna de quantidades e escrita.
+ *
+ * Complexidade: O(1)
+ *
+ * Retorno: 1 se sucesso, 0 se nao encontrado
+ */
+int colunarAlterarQuantidade(MochilaColunar* mochila, const char* nome, int quantidade) {
+    int encontrado = colunarBuscar(mochila, nome, NULL);
+    if (encontrado == -1) {
+        return 0;
+    }
+
+    contarLinha(mochila, encontrado, -1);
+    mochila->quantidades[encontrado] = quantidade;
+    contarLinha(mochila, encontrado, 1);
+    return 1;
+}
+
+/*
+ * Funcao: colunarTotal
+ * Retorna a quantidade de itens (sem contar lapides).
+ */
+int colunarTotal(const MochilaColunar* mochila) {
+    return mochila->total - mochila->removidos;
+}
+
+/*
+ * Funcao: colunarCapacidade
+ * Retorna quantos itens cabem nas colunas alocadas.
+ */
+int colunarCapacidade(const MochilaColunar* mochila) {
+    return mochila->capacidade;
+}
+
+/*
+ * Funcao: colunarItem
+ * Monta em *item a linha "indice" (le todas as colunas dessa linha).
+ *
+ * Retorno: 1 se sucesso, 0 se o indice e invalido ou guarda uma lapide
+ */
+int colunarItem(const MochilaColunar* mochila, int indice, Item* item) {
+    if (indice < 0 || indice >= mochila->total || estaRemovida(mochila, indice)) {
+        return 0;
+    }
+
+    item->prefixoNome = mochila->prefixos[indice];
+    memcpy(item->nome, mochila->nomes[indice], TAM_NOME);
+    item->idTipo = mochila->tipos[indice];
+    item->quantidade = mochila->quantidades[indice];
+    item->prioridade = mochila->prioridades[indice];
+    return 1;
+}
+
+/*
+ * Funcao: colunarPercorrer
+ * Visita todos os itens na ordem das linhas, pulando as lapides e
+ * montando cada Item numa variavel local (o ponteiro so vale durante a
+ * chamada de visitar).
+ */
+void colunarPercorrer(const MochilaColunar* mochila,
+                      void (*visitar)(const Item* item, int posicao, void* contexto),
+                      void* contexto) {
+    Item item;
+
+    for (int i = 0; i < mochila->total; i++) {
+        if (colunarItem(mochila, i, &item)) {
+            visitar(&item, i, contexto);
+        }
+    }
+}
+
+// ============================================================================
+// VARREDURAS NUMERICAS
+// ============================================================================
+
+/*
+ * Funcao: colunarSomarQuantidades
+ * Soma das quantidades de todos os itens.
+ *
+ * Complexidade: O(n), lendo so a coluna de quantidades (4 bytes por item,
+ * mais 1 da marca de lapide se houver lapides)
+ */
+long long colunarSomarQuantidades(const MochilaColunar* mochila) {
+    long long soma = 0;
+    for (int i = 0; i < mochila->total; i++) {
+        if (!estaRemovida(mochila, i)) {
+            soma += mochila->quantidades[i];
+        }
+    }
+    return soma;
+}
+
+/*
+ * Funcao: colunarSomarQuantidadesPorTipo
+ * Soma das quantidades dos itens de um tipo ("total de municao").
+ *
+ * Complexidade: O(n), lendo so as colunas de tipo e quantidade
+ */
+long long colunarSomarQuantidadesPorTipo(const MochilaColunar* mochila, unsigned short idTipo) {
+    long long soma = 0;
+    for (int i = 0; i < mochila->total; i++) {
+        if (mochila->tipos[i] == idTipo && !estaRemovida(mochila, i)) {
+            soma += mochila->quantidades[i];
+        }
+    }
+    return soma;
+}
+
+/*
+ * Funcao: colunarContarPrioridade
+ * Quantidade de itens com a prioridade informada.
+ *
+ * Complexidade: O(n), lendo so a coluna de prioridades
+ */
+int colunarContarPrioridade(const MochilaColunar* mochila, int prioridade) {
+    int contagem = 0;
+    for (int i = 0; i < mochila->total; i++) {
+        contagem += mochila->prioridades[i] == prioridade && !estaRemovida(mochila, i);
+    }
+    return contagem;
+}
+
+// ============================================================================
+// BUSCA
+// ============================================================================
+
+/*
+ * Funcao: colunarBuscar
+ * Localiza o item pelo nome no indice hash; o nome e confirmado nas
+ * colunas de prefixos e de nomes.
+ *
+ * Complexidade: O(1) em media
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, acumula as comparacoes feitas
+ *
+ * Retorno: indice do item se encontrado, -1 caso contrario
+ */
+int colunarBuscar(const MochilaColunar* mochila, const char* nome, Estatisticas* estatisticas) {
+    return indiceHashBuscarColunas(&mochila->indiceNome, mochila->prefixos, mochila->nomes, nome, estatisticas);
+}
+
+/*
+ * Funcao: colunarBuscarSequencial
+ * Busca sequencial pelo nome percorrendo a coluna de prefixos; o nome
+ * completo so e lido quando o prefixo bate.
+ *
+ * Complexidade: O(n)
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, acumula as comparacoes feitas
+ *
+ * Retorno: indice do item se encontrado, -1 caso contrario
+ */
+int colunarBuscarSequencial(const MochilaColunar* mochila, const char* nome, Estatisticas* estatisticas) {
+    uint64_t prefixo = prefixoNome(nome);
+    int contador = 0;
+    int encontrado = -1;
+
+    for (int i = 0; i < mochila->total; i++) {
+        contador++;
+        if (mochila->prefixos[i] == prefixo && !estaRemovida(mochila, i) &&
+            compararPrefixados(prefixo, mochila->nomes[i], prefixo, nome) == 0) {
+            encontrado = i;
+            break;
+        }
+    }
+
+    if (estatisticas != NULL) {
+        estatisticas->comparacoes += contador;
+    }
+    return encontrado;
+}
+
+/*
+ * Funcao: buscarVivaComMesmoNome
+ * Se a busca binaria parar em uma lapide (que mantem o nome removido),
+ * procura uma linha viva com o mesmo nome entre as vizinhas.
+ *
+ * Retorno: linha viva, -1 se todas com esse nome foram removidas
+ */
+static int buscarVivaComMesmoNome(const MochilaColunar* mochila, int meio) {
+    if (!estaRemovida(mochila, meio)) {
+        return meio;
+    }
+
+    for (int i = meio - 1; i >= 0 && strcmp(mochila->nomes[i], mochila->nomes[meio]) == 0; i--) {
+        if (!estaRemovida(mochila, i)) {
+            return i;
+        }
+    }
+    for (int i = meio + 1; i < mochila->total && strcmp(mochila->nomes[i], mochila->nomes[meio]) == 0; i++) {
+        if (!estaRemovida(mochila, i)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/*
+ * Funcao: colunarBuscarBinaria
+ * Busca binaria pelo nome (REQUER colunarOrdenar por NOME).
+ *
+ * Complexidade: O(log n)
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, acumula as comparacoes feitas
+ *
+ * Retorno: indice do item se encontrado, -1 caso contrario
+ */
+int colunarBuscarBinaria(const MochilaColunar* mochila, const char* nome, Estatisticas* estatisticas) {
+    uint64_t prefixo = prefixoNome(nome);
+    int esquerda = 0;
+    int direita = mochila->total - 1;
+    int contador = 0;
+    int encontrado = -1;
+
+    while (esquerda <= direita) {
+        int meio = esquerda + (direita - esquerda) / 2;
+        contador++;
+
+        int resultado = compararPrefixados(mochila->prefixos[meio], mochila->nomes[meio], prefixo, nome);
+
+        if (resultado == 0) {
+            encontrado = buscarVivaComMesmoNome(mochila, meio);
+            break;
+        } else if (resultado < 0) {
+            esquerda = meio + 1;
+        } else {
+            direita = meio - 1;
+        }
+    }
+
+    if (estatisticas != NULL) {
+        estatisticas->comparacoes += contador;
+    }
+    return encontrado;
+}
+
+// ============================================================================
+// ORDENACAO
+// ============================================================================
+
+/*
+ * Funcao: permutarColuna
+ * Reorganiza uma coluna segundo "ordem" (a nova linha i recebe a antiga
+ * linha ordem[i]), usando o buffer auxiliar.
+ */
+static void permutarColuna(void* coluna, size_t tamanho, const int* ordem, int n, unsigned char* auxiliar) {
+    const unsigned char* origem = (const unsigned char*)coluna;
+    for (int i = 0; i < n; i++) {
+        memcpy(auxiliar + (size_t)i * tamanho, origem + (size_t)ordem[i] * tamanho, tamanho);
+    }
+    memcpy(coluna, auxiliar, tamanho * (size_t)n);
+}
+
+/*
+ * Funcao: colunarOrdenar
+ * Ordena a mochila pelo criterio com o algoritmo escolhido (ver
+ * ordenacao.h): mesma ordem e mesmo algoritmo executado que
+ * mochilaOrdenar com os itens equivalentes.
+ *
+ * As lapides sao descartadas antes (compactacao). O algoritmo ordena um
+ * vetor de linhas lendo so as colunas da chave (ordenarColunas); depois
+ * cada coluna e permutada uma vez e o indice hash e reconstruido.
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, acumula comparacoes, trocas e
+ *                   movimentos (das linhas e da permutacao final)
+ *
+ * Retorno: numero de comparacoes realizadas, ou -1 se faltar memoria
+ *          (para ordenar, a mochila fica como estava; para refazer o
+ *          indice, que nao acontece ao ordenar)
+ */
+long colunarOrdenar(MochilaColunar* mochila, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                    Estatisticas* estatisticas) {
+    colunarCompactar(mochila);
+
+    int n = mochila->total;
+    int* ordem = (int*)malloc(sizeof(int) * (size_t)(n > 0 ? n : 1));
+    unsigned char* buffer = (unsigned char*)malloc(sizeof(mochila->nomes[0]) * (size_t)(n > 0 ? n : 1));
+    if (ordem == NULL || buffer == NULL) {
+        free(ordem);
+        free(buffer);
+        return -1;
+    }
+
+    ColunasOrdenacao colunas = {mochila->prefixos, mochila->nomes, mochila->tipos, mochila->prioridades};
+    preencherIndices(ordem, n);
+    mochila->algoritmoUsado = algoritmoEfetivoColunas(&colunas, ordem, n, criterio, algoritmo);
+    long comparacoes = ordenarColunas(&colunas, ordem, n, criterio, algoritmo, estatisticas);
+
+    permutarColuna(mochila->prefixos, sizeof(uint64_t), ordem, n, buffer);
+    permutarColuna(mochila->nomes, sizeof(mochila->nomes[0]), ordem, n, buffer);
+    permutarColuna(mochila->tipos, sizeof(unsigned short), ordem, n, buffer);
+    permutarColuna(mochila->quantidades, sizeof(int), ordem, n, buffer);
+    permutarColuna(mochila->prioridades, sizeof(int), ordem, n, buffer);
+    if (estatisticas != NULL) {
+        estatisticas->movimentos += n;
+        estatisticas->bytesMovidos += (long long)n * (long long)BYTES_LINHA;
+    }
+
+    free(ordem);
+    free(buffer);
+
+    mochila->ordenada = true;
+    mochila->criterioOrdem = criterio;
+    if (!indiceHashReconstruirNomes(&mochila->indiceNome, mochila->nomes, n)) {
+        return -1;
+    }
+    return comparacoes;
+}
+
+/*
+ * Funcao: colunarUltimoAlgoritmo
+ * Algoritmo executado na ultima ordenacao (ver mochilaUltimoAlgoritmo).
+ */
+AlgoritmoOrdenacao colunarUltimoAlgoritmo(const MochilaColunar* mochila) {
+    return mochila->algoritmoUsado;
+}
+
+/*
+ * Funcao: colunarOrdenadaPorNome
+ * Indica se a busca binaria pode ser usada.
+ */
+bool colunarOrdenadaPorNome(const MochilaColunar* mochila) {
+    return mochila->ordenada && mochila->criterioOrdem == NOME;
+}
+
+// ============================================================================
+// AGREGADOS
+// ============================================================================
+
+/*
+ * Funcao: colunarAgregadoTipo
+ * Itens e soma das quantidades de um tipo, sem ler as colunas.
+ *
+ * Complexidade: O(1)
+ */
+Agregado colunarAgregadoTipo(const MochilaColunar* mochila, unsigned short idTipo) {
+    return agregadosConsultar(&mochila->agregadosTipo, idTipo);
+}
+
+/*
+ * Funcao: colunarAgregadoPrioridade
+ * Itens e soma das quantidades de uma prioridade.
+ *
+ * Complexidade: O(1)
+ */
+Agregado colunarAgregadoPrioridade(const MochilaColunar* mochila, int prioridade) {
+    return agregadosConsultar(&mochila->agregadosPrioridade, prioridade);
+}
+
+/*
+ * Funcao: colunarAgregadoGeral
+ * Itens e soma das quantidades da mochila inteira.
+ *
+ * Complexidade: O(1)
+ */
+Agregado colunarAgregadoGeral(const MochilaColunar* mochila) {
+    return mochila->agregadoGeral;
+}
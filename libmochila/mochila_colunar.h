@@ -0,0 +1,130 @@
+/*
+ * LIBMOCHILA - MOCHILA EM COLUNAS
+ *
+ * Descricao: Mesmo inventario da Mochila, guardado como estrutura de
+ * vetores (uma coluna contigua por campo) em vez de vetor de Item.
+ * Uma varredura que so precisa das quantidades ou das prioridades (somas,
+ * filtros, ordenacao por prioridade ou tipo) le apenas essas colunas:
+ * 4 bytes por item em vez dos 48 do Item inteiro.
+ *
+ * As funcoes seguem a API da Mochila (colunarInserir <-> mochilaInserir,
+ * colunarBuscar <-> mochilaBuscar...) e usam os mesmos motores: o indice
+ * hash por nome (indice_hash.h), os agregados por tipo e prioridade
+ * (agregados.h), a remocao por lapides e os algoritmos de ordenacao de
+ * ordenacao.h, aplicados as linhas (ordenarColunas). O Item inteiro so e
+ * montado quando pedido (colunarItem, colunarPercorrer).
+ */
+
+#ifndef MOCHILA_COLUNAR_H
+#define MOCHILA_COLUNAR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "agregados.h"
+#include "estatisticas.h"
+#include "indice_hash.h"
+#include "item.h"
+#include "ordenacao.h"
+
+/*
+ * Struct: MochilaColunar
+ * Inventario em colunas. A linha i de todas as colunas forma um item.
+ *
+ * Campos:
+ *   - prefixos: prefixo de 8 bytes de cada nome (ver prefixoNome)
+ *   - nomes: nomes completos, consultados so nos empates de prefixo
+ *   - tipos: id do tipo de cada item (tipos.h)
+ *   - quantidades / prioridades: colunas numericas
+ *   - total: linhas ocupadas (incluindo lapides)
+ *   - capacidade: quantidade de linhas alocadas em cada coluna
+ *   - lapides / removidos / remocaoPreguicosa / limiteRemovidos: remocao
+ *     por lapides, como na Mochila (colunarDefinirRemocaoPreguicosa)
+ *   - indiceNome: indice hash nome -> linha
+ *   - ordenada: true depois de colunarOrdenar; a remocao preserva a ordem
+ *               (deslocando) somente enquanto esta flag estiver ligada
+ *   - criterioOrdem: criterio da ultima ordenacao (vale se ordenada)
+ *   - algoritmoUsado: algoritmo executado na ultima ordenacao
+ *   - agregadosTipo / agregadosPrioridade / agregadoGeral: contagens e
+ *     somas de quantidade mantidas a cada insercao e remocao
+ */
+typedef struct {
+    uint64_t* prefixos;
+    char (*nomes)[TAM_NOME];
+    unsigned short* tipos;
+    int* quantidades;
+    int* prioridades;
+    int total;
+    int capacidade;
+    unsigned char* lapides;
+    int removidos;
+    bool remocaoPreguicosa;
+    double limiteRemovidos;
+    IndiceHash indiceNome;
+    bool ordenada;
+    CriterioOrdenacao criterioOrdem;
+    AlgoritmoOrdenacao algoritmoUsado;
+    TabelaAgregados agregadosTipo;
+    TabelaAgregados agregadosPrioridade;
+    Agregado agregadoGeral;
+} MochilaColunar;
+
+// ============================================================================
+// CICLO DE VIDA E CAPACIDADE
+// ============================================================================
+
+int colunarIniciar(MochilaColunar* mochila, int capacidade);
+void colunarLiberar(MochilaColunar* mochila);
+int colunarReservar(MochilaColunar* mochila, int capacidade);
+
+// ============================================================================
+// REMOCAO PREGUICOSA (LAPIDES)
+// ============================================================================
+
+int colunarDefinirRemocaoPreguicosa(MochilaColunar* mochila, bool ativo, double limite);
+int colunarCompactar(MochilaColunar* mochila);
+int colunarRemovidos(const MochilaColunar* mochila);
+
+// ============================================================================
+// OPERACOES BASICAS
+// ============================================================================
+
+int colunarInserir(MochilaColunar* mochila, Item item);
+int colunarRemover(MochilaColunar* mochila, const char* nome);
+int colunarAlterarQuantidade(MochilaColunar* mochila, const char* nome, int quantidade);
+int colunarTotal(const MochilaColunar* mochila);
+int colunarCapacidade(const MochilaColunar* mochila);
+int colunarItem(const MochilaColunar* mochila, int indice, Item* item);
+void colunarPercorrer(const MochilaColunar* mochila,
+                      void (*visitar)(const Item* item, int posicao, void* contexto),
+                      void* contexto);
+
+// ============================================================================
+// VARREDURAS NUMERICAS (SO AS COLUNAS NECESSARIAS)
+// ============================================================================
+
+long long colunarSomarQuantidades(const MochilaColunar* mochila);
+long long colunarSomarQuantidadesPorTipo(const MochilaColunar* mochila, unsigned short idTipo);
+int colunarContarPrioridade(const MochilaColunar* mochila, int prioridade);
+
+// ============================================================================
+// BUSCA E ORDENACAO
+// ============================================================================
+
+int colunarBuscar(const MochilaColunar* mochila, const char* nome, Estatisticas* estatisticas);
+int colunarBuscarSequencial(const MochilaColunar* mochila, const char* nome, Estatisticas* estatisticas);
+int colunarBuscarBinaria(const MochilaColunar* mochila, const char* nome, Estatisticas* estatisticas);
+long colunarOrdenar(MochilaColunar* mochila, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                    Estatisticas* estatisticas);
+AlgoritmoOrdenacao colunarUltimoAlgoritmo(const MochilaColunar* mochila);
+bool colunarOrdenadaPorNome(const MochilaColunar* mochila);
+
+// ============================================================================
+// AGREGADOS (CONSULTA EM O(1), SEM PERCORRER AS COLUNAS)
+// ============================================================================
+
+Agregado colunarAgregadoTipo(const MochilaColunar* mochila, unsigned short idTipo);
+Agregado colunarAgregadoPrioridade(const MochilaColunar* mochila, int prioridade);
+Agregado colunarAgregadoGeral(const MochilaColunar* mochila);
+
+#endif
@@ -0,0 +1,1255 @@
+/*
+ * LIBMOCHILA - MOTOR DE ORDENACAO
+ *
+ * Implementacao dos algoritmos de ordenacao de itens.
+ *
+ * Os algoritmos sao escritos uma unica vez sobre um "vetor de elementos"
+ * de tamanho configuravel (como o qsort da biblioteca padrao). Um elemento
+ * pode ser:
+ *   - o proprio Item (ordenacao direta: cada troca move ~60 bytes), ou
+ *   - um int com a posicao do item (ordenacao por indices: cada troca move
+ *     4 bytes e os itens so sao lidos para comparar), ou
+ *   - um int com a linha de uma mochila em colunas (mochila_colunar.h): so
+ *     as colunas da chave sao lidas para comparar.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ordenacao.h"
+
+#define LIMITE_INSERCAO 16      // Particoes menores usam Insertion Sort
+#define LIMITE_RADIX 32         // Grupos menores do Radix Sort usam Insertion Sort
+#define TOTAL_BYTES 256         // Valores possiveis de um byte da chave
+
+/*
+ * Struct: Vetor
+ * Descreve o vetor sendo ordenado.
+ *
+ * Campos:
+ *   - base: inicio dos elementos
+ *   - tamanho: bytes por elemento (sizeof(Item) ou sizeof(int))
+ *   - itens: itens comparados; no modo por indices, base guarda posicoes
+ *            neste vetor
+ *   - indireto: true se os elementos sao indices
+ *   - colunas: se nao for NULL, os indices sao linhas destas colunas (e
+ *              itens e NULL)
+ *   - criterio: criterio de comparacao
+ *   - estatisticas: se nao for NULL, acumula trocas, movimentos e bytes
+ *                   movidos (as comparacoes sao somadas por ordenarVetor)
+ */
+typedef struct {
+    unsigned char* base;
+    size_t tamanho;
+    const Item* itens;
+    bool indireto;
+    CriterioOrdenacao criterio;
+    Estatisticas* estatisticas;
+    const ColunasOrdenacao* colunas;
+} Vetor;
+
+// Maior elemento suportado: usado para variaveis temporarias (chave, pivo)
+typedef union {
+    Item item;
+    int indice;
+} Elemento;
+
+// ============================================================================
+// ACESSO AOS ELEMENTOS
+// ============================================================================
+
+static unsigned char* elemento(const Vetor* v, int i) {
+    return v->base + (size_t)i * v->tamanho;
+}
+
+static const Item* itemDe(const Vetor* v, const void* e) {
+    return v->indireto ? &v->itens[*(const int*)e] : (const Item*)e;
+}
+
+static int linhaDe(const void* e) {
+    return *(const int*)e;
+}
+
+/*
+ * Funcao: compararLinhas
+ * compararItens para duas linhas de uma mochila em colunas.
+ */
+static int compararLinhas(const ColunasOrdenacao* colunas, int a, int b, CriterioOrdenacao criterio) {
+    switch (criterio) {
+        case NOME:
+            return compararPrefixados(colunas->prefixos[a], colunas->nomes[a], colunas->prefixos[b],
+                                      colunas->nomes[b]);
+        case TIPO:
+            return tipoPosicao(colunas->tipos[a]) - tipoPosicao(colunas->tipos[b]);
+        case PRIORIDADE:
+            return colunas->prioridades[b] - colunas->prioridades[a];
+    }
+    return 0;
+}
+
+/*
+ * Funcao: comparar
+ * Compara dois elementos (itens, indices de itens ou linhas) pelo criterio
+ * do vetor.
+ */
+static int comparar(const Vetor* v, const void* a, const void* b) {
+    if (v->colunas != NULL) {
+        return compararLinhas(v->colunas, linhaDe(a), linhaDe(b), v->criterio);
+    }
+    return compararItens(itemDe(v, a), itemDe(v, b), v->criterio);
+}
+
+static int compararPosicoes(const Vetor* v, int i, int j) {
+    return comparar(v, elemento(v, i), elemento(v, j));
+}
+
+static void contarMovimentos(const Vetor* v, int quantidade) {
+    if (v->estatisticas != NULL) {
+        v->estatisticas->movimentos += quantidade;
+        v->estatisticas->bytesMovidos += (long long)quantidade * (long long)v->tamanho;
+    }
+}
+
+static void copiar(const Vetor* v, void* destino, const void* origem) {
+    memcpy(destino, origem, v->tamanho);
+    contarMovimentos(v, 1);
+}
+
+/*
+ * Funcao: copiarBloco
+ * Copia 'quantidade' elementos consecutivos de uma vez.
+ */
+static void copiarBloco(const Vetor* v, void* destino, const void* origem, int quantidade) {
+    memcpy(destino, origem, v->tamanho * (size_t)quantidade);
+    contarMovimentos(v, quantidade);
+}
+
+/*
+ * Funcao: trocar
+ * Troca dois elementos de posicao no vetor.
+ */
+static void trocar(const Vetor* v, int i, int j) {
+    Elemento temp;
+
+    copiar(v, &temp, elemento(v, i));
+    copiar(v, elemento(v, i), elemento(v, j));
+    copiar(v, elemento(v, j), &temp);
+    if (v->estatisticas != NULL) {
+        v->estatisticas->trocas++;
+    }
+}
+
+// ============================================================================
+// ALGORITMOS QUADRATICOS
+// ============================================================================
+
+/*
+ * Funcao: selectionSort
+ * Para cada posicao i, encontra o menor elemento entre i e o final do
+ * vetor e o troca com o elemento da posicao i.
+ *
+ * Complexidade: O(n^2) - sempre, mesmo com vetor ja ordenado
+ */
+static long selectionSort(const Vetor* v, int n) {
+    long comparacoes = 0;
+
+    for (int i = 0; i < n - 1; i++) {
+        int menorIndice = i;
+
+        for (int j = i + 1; j < n; j++) {
+            comparacoes++;
+            if (compararPosicoes(v, j, menorIndice) < 0) {
+                menorIndice = j;
+            }
+        }
+
+        if (menorIndice != i) {
+            trocar(v, i, menorIndice);
+        }
+    }
+
+    return comparacoes;
+}
+
+/*
+ * Funcao: bubbleSort
+ * Percorre o vetor trocando pares adjacentes fora de ordem; a cada
+ * passada o maior elemento restante "borbulha" para o final.
+ *
+ * Complexidade: O(n^2)
+ */
+static long bubbleSort(const Vetor* v, int n) {
+    long comparacoes = 0;
+
+    for (int i = 0; i < n - 1; i++) {
+        for (int j = 0; j < n - i - 1; j++) {
+            comparacoes++;
+            if (compararPosicoes(v, j, j + 1) > 0) {
+                trocar(v, j, j + 1);
+            }
+        }
+    }
+
+    return comparacoes;
+}
+
+/*
+ * Funcao: insertionSortFaixa
+ * Insere cada elemento de [inicio, fim) na posicao correta da parte ja
+ * ordenada, movendo os maiores uma posicao a frente. Tambem termina as
+ * faixas pequenas do Merge Sort e do Introsort.
+ *
+ * Complexidade: O(n^2) no pior caso, O(n) com vetor ja ordenado
+ */
+static long insertionSortFaixa(const Vetor* v, int inicio, int fim) {
+    long comparacoes = 0;
+    Elemento chave;
+
+    for (int i = inicio + 1; i < fim; i++) {
+        copiar(v, &chave, elemento(v, i));
+        int j = i - 1;
+
+        while (j >= inicio) {
+            comparacoes++;
+            if (comparar(v, elemento(v, j), &chave) > 0) {
+                copiar(v, elemento(v, j + 1), elemento(v, j));
+                j--;
+            } else {
+                break;
+            }
+        }
+        copiar(v, elemento(v, j + 1), &chave);
+    }
+
+    return comparacoes;
+}
+
+// ============================================================================
+// MERGE SORT (ESTAVEL)
+// ============================================================================
+
+/*
+ * Funcao: intercalar
+ * Intercala as metades ordenadas [inicio, meio) e [meio, fim) usando o
+ * vetor auxiliar. Em caso de empate, o elemento da esquerda vem
+ * primeiro, o que torna a ordenacao estavel.
+ */
+static long intercalar(const Vetor* v, unsigned char* auxiliar, int inicio, int meio, int fim) {
+    long comparacoes = 0;
+    size_t tamanho = v->tamanho;
+    int i = inicio;
+    int j = meio;
+    unsigned char* destino = auxiliar;
+
+    while (i < meio && j < fim) {
+        comparacoes++;
+        if (compararPosicoes(v, j, i) < 0) {
+            copiar(v, destino, elemento(v, j++));
+        } else {
+            copiar(v, destino, elemento(v, i++));
+        }
+        destino += tamanho;
+    }
+
+    // O que sobrar da direita ja esta no lugar; basta trazer a esquerda
+    copiarBloco(v, destino, elemento(v, i), meio - i);
+    destino += tamanho * (size_t)(meio - i);
+
+    copiarBloco(v, elemento(v, inicio), auxiliar, (int)((size_t)(destino - auxiliar) / tamanho));
+    return comparacoes;
+}
+
+/*
+ * Funcao: mergeSortRecursivo
+ * Ordena [inicio, fim): divide ao meio, ordena cada metade e intercala.
+ * Se as metades ja estao em ordem (ultimo da esquerda <= primeiro da
+ * direita), a intercalacao e pulada: vetores quase ordenados saem em O(n).
+ */
+static long mergeSortRecursivo(const Vetor* v, unsigned char* auxiliar, int inicio, int fim) {
+    if (fim - inicio <= LIMITE_INSERCAO) {
+        return insertionSortFaixa(v, inicio, fim);
+    }
+
+    int meio = inicio + (fim - inicio) / 2;
+    long comparacoes = mergeSortRecursivo(v, auxiliar, inicio, meio);
+    comparacoes += mergeSortRecursivo(v, auxiliar, meio, fim);
+
+    comparacoes++;
+    if (compararPosicoes(v, meio - 1, meio) <= 0) {
+        return comparacoes;
+    }
+
+    return comparacoes + intercalar(v, auxiliar, inicio, meio, fim);
+}
+
+/*
+ * Funcao: mergeSort
+ * Merge Sort com vetor auxiliar de n elementos.
+ *
+ * Complexidade: O(n log n) sempre; memoria extra O(n)
+ *
+ * Se faltar memoria para o vetor auxiliar, usa Insertion Sort, que tambem
+ * e estavel (apenas mais lento).
+ */
+static long mergeSort(const Vetor* v, int n) {
+    if (n <= LIMITE_INSERCAO) {
+        return insertionSortFaixa(v, 0, n);
+    }
+
+    unsigned char* auxiliar = (unsigned char*)malloc(v->tamanho * (size_t)n);
+    if (auxiliar == NULL) {
+        return insertionSortFaixa(v, 0, n);
+    }
+
+    long comparacoes = mergeSortRecursivo(v, auxiliar, 0, n);
+    free(auxiliar);
+    return comparacoes;
+}
+
+// ============================================================================
+// MERGE SORT PARALELO
+// ============================================================================
+
+/*
+ * Struct: Trabalho
+ * Parte independente do Merge Sort paralelo: ordenar a faixa
+ * [inicio, fim) do vetor (quando a == NULL) ou intercalar as sequencias
+ * ordenadas a e b em destino.
+ */
+typedef struct {
+    const unsigned char* a;
+    int na;
+    const unsigned char* b;
+    int nb;
+    unsigned char* destino;
+    int inicio;
+    int fim;
+} Trabalho;
+
+/*
+ * Struct: Operario
+ * Uma thread do Merge Sort paralelo. Executa os trabalhos primeiro,
+ * primeiro + passo, ... e conta em estatisticas proprias, somadas as do
+ * vetor depois que todas terminam (nenhum contador e disputado).
+ */
+typedef struct {
+    Vetor vetor;
+    Estatisticas estatisticas;
+    unsigned char* auxiliar;
+    const Trabalho* trabalhos;
+    int total;
+    int primeiro;
+    int passo;
+    long comparacoes;
+} Operario;
+
+/*
+ * Funcao: intercalarSequencias
+ * Intercala as sequencias ordenadas a e b em destino (que nao pode se
+ * sobrepor a nenhuma das duas). Empates saem de a primeiro (estavel).
+ */
+static long intercalarSequencias(const Vetor* v, const unsigned char* a, int na, const unsigned char* b,
+                                 int nb, unsigned char* destino) {
+    long comparacoes = 0;
+    size_t tamanho = v->tamanho;
+    const unsigned char* fimA = a + tamanho * (size_t)na;
+    const unsigned char* fimB = b + tamanho * (size_t)nb;
+
+    while (a < fimA && b < fimB) {
+        comparacoes++;
+        if (comparar(v, b, a) < 0) {
+            copiar(v, destino, b);
+            b += tamanho;
+        } else {
+            copiar(v, destino, a);
+            a += tamanho;
+        }
+        destino += tamanho;
+    }
+
+    int restantesA = (int)((size_t)(fimA - a) / tamanho);
+    copiarBloco(v, destino, a, restantesA);
+    copiarBloco(v, destino + tamanho * (size_t)restantesA, b, (int)((size_t)(fimB - b) / tamanho));
+    return comparacoes;
+}
+
+/*
+ * Funcao: cortarIntercalacao
+ * Quantos elementos de a estao entre os k primeiros da intercalacao
+ * estavel de a e b. Com isso uma intercalacao e dividida em partes que
+ * podem ser feitas ao mesmo tempo.
+ *
+ * Complexidade: O(log(min(na, nb))) comparacoes
+ */
+static int cortarIntercalacao(const Vetor* v, const unsigned char* a, int na, const unsigned char* b, int nb,
+                              int k, long* comparacoes) {
+    size_t tamanho = v->tamanho;
+    int baixo = k > nb ? k - nb : 0;
+    int alto = k < na ? k : na;
+
+    while (baixo < alto) {
+        int i = baixo + (alto - baixo) / 2;
+        int j = k - i;
+
+        // Se a[i] sai antes de b[j-1], os k primeiros tem mais de i itens de a
+        (*comparacoes)++;
+        if (comparar(v, a + tamanho * (size_t)i, b + tamanho * (size_t)(j - 1)) <= 0) {
+            baixo = i + 1;
+        } else {
+            alto = i;
+        }
+    }
+    return baixo;
+}
+
+static void* executarTrabalhos(void* argumento) {
+    Operario* operario = (Operario*)argumento;
+    const Vetor* v = &operario->vetor;
+
+    for (int t = operario->primeiro; t < operario->total; t += operario->passo) {
+        const Trabalho* trabalho = &operario->trabalhos[t];
+        if (trabalho->a == NULL) {
+            // Cada faixa usa o trecho correspondente do vetor auxiliar
+            unsigned char* auxiliar = operario->auxiliar + v->tamanho * (size_t)trabalho->inicio;
+            operario->comparacoes += mergeSortRecursivo(v, auxiliar, trabalho->inicio, trabalho->fim);
+        } else {
+            operario->comparacoes += intercalarSequencias(v, trabalho->a, trabalho->na, trabalho->b,
+                                                          trabalho->nb, trabalho->destino);
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Funcao: executarEmParalelo
+ * Distribui os trabalhos entre 'threads' threads (a atual e uma delas) e
+ * espera todas terminarem. Se uma thread nao puder ser criada, os
+ * trabalhos dela rodam na thread atual.
+ *
+ * Retorno: comparacoes somadas de todos os trabalhos
+ */
+static long executarEmParalelo(const Vetor* v, unsigned char* auxiliar, const Trabalho* trabalhos, int total,
+                               int threads) {
+    Operario operarios[MAX_THREADS_ORDENACAO];
+    pthread_t ids[MAX_THREADS_ORDENACAO];
+    bool criada[MAX_THREADS_ORDENACAO];
+
+    if (threads > total) {
+        threads = total;
+    }
+
+    for (int t = 0; t < threads; t++) {
+        Operario* operario = &operarios[t];
+        operario->vetor = *v;
+        operario->vetor.estatisticas = &operario->estatisticas;
+        estatisticasZerar(&operario->estatisticas);
+        operario->auxiliar = auxiliar;
+        operario->trabalhos = trabalhos;
+        operario->total = total;
+        operario->primeiro = t;
+        operario->passo = threads;
+        operario->comparacoes = 0;
+        criada[t] = t > 0 && pthread_create(&ids[t], NULL, executarTrabalhos, operario) == 0;
+    }
+
+    executarTrabalhos(&operarios[0]);
+
+    long comparacoes = 0;
+    for (int t = 0; t < threads; t++) {
+        if (criada[t]) {
+            pthread_join(ids[t], NULL);
+        } else if (t > 0) {
+            executarTrabalhos(&operarios[t]);
+        }
+        comparacoes += operarios[t].comparacoes;
+        if (v->estatisticas != NULL) {
+            estatisticasSomar(v->estatisticas, &operarios[t].estatisticas);
+        }
+    }
+    return comparacoes;
+}
+
+/*
+ * Funcao: dividirIntercalacao
+ * Acrescenta 'partes' trabalhos que, juntos, intercalam a e b em destino.
+ *
+ * Retorno: novo total de trabalhos
+ */
+static int dividirIntercalacao(const Vetor* v, Trabalho* trabalhos, int total, const unsigned char* a, int na,
+                               const unsigned char* b, int nb, unsigned char* destino, int partes,
+                               long* comparacoes) {
+    size_t tamanho = v->tamanho;
+    int anteriorA = 0;
+    int anteriorK = 0;
+
+    for (int p = 1; p <= partes; p++) {
+        int k = (int)((long)(na + nb) * p / partes);
+        int i = p == partes ? na : cortarIntercalacao(v, a, na, b, nb, k, comparacoes);
+        int anteriorB = anteriorK - anteriorA;
+
+        Trabalho parte = {a + tamanho * (size_t)anteriorA, i - anteriorA, b + tamanho * (size_t)anteriorB,
+                          (k - i) - anteriorB, destino + tamanho * (size_t)anteriorK, 0, 0};
+        trabalhos[total++] = parte;
+        anteriorA = i;
+        anteriorK = k;
+    }
+    return total;
+}
+
+/*
+ * Funcao: mergeSortParalelo
+ * Merge Sort em varias threads:
+ *   1. o vetor e dividido em uma faixa por thread, e as faixas sao
+ *      ordenadas ao mesmo tempo (mergeSortRecursivo);
+ *   2. as faixas sao intercaladas duas a duas, alternando entre o vetor e
+ *      o auxiliar, ate sobrar uma. Cada intercalacao e cortada em partes
+ *      (cortarIntercalacao), para que todas as threads trabalhem tambem
+ *      nas ultimas rodadas, quando restam poucas faixas.
+ *
+ * Complexidade: O((n log n) / p + n log p / p) com p threads; memoria
+ * extra O(n). Estavel, como o Merge Sort.
+ *
+ * Com uma thread (ver threadsOrdenacao), ou se faltar memoria, e o Merge
+ * Sort sequencial.
+ */
+static long mergeSortParalelo(const Vetor* v, int n, int threads, int limite) {
+    threads = threadsOrdenacao(n, threads, limite);
+    if (threads <= 1) {
+        return mergeSort(v, n);
+    }
+
+    size_t tamanho = v->tamanho;
+    unsigned char* auxiliar = (unsigned char*)malloc(tamanho * (size_t)n);
+    // Por rodada: ate threads partes, mais uma por par de faixas
+    Trabalho* trabalhos = (Trabalho*)malloc(sizeof(Trabalho) * (size_t)threads * 2);
+    int* limites = (int*)malloc(sizeof(int) * (size_t)(threads + 1));
+    if (auxiliar == NULL || trabalhos == NULL || limites == NULL) {
+        free(auxiliar);
+        free(trabalhos);
+        free(limites);
+        return mergeSort(v, n);
+    }
+
+    for (int t = 0; t < threads; t++) {
+        limites[t] = (int)((long)n * t / threads);
+        Trabalho faixa = {NULL, 0, NULL, 0, NULL, limites[t], (int)((long)n * (t + 1) / threads)};
+        trabalhos[t] = faixa;
+    }
+    limites[threads] = n;
+    long comparacoes = executarEmParalelo(v, auxiliar, trabalhos, threads, threads);
+
+    unsigned char* origem = v->base;
+    unsigned char* destino = auxiliar;
+    int faixas = threads;
+
+    while (faixas > 1) {
+        int total = 0;
+        int novas = 0;
+
+        for (int f = 0; f < faixas; f += 2) {
+            // Com numero impar de faixas, a ultima e so copiada (nb = 0)
+            int inicio = limites[f];
+            int meio = limites[f + 1];
+            int fim = f + 2 <= faixas ? limites[f + 2] : meio;
+            int partes = (int)((long)threads * (fim - inicio) / n);
+
+            total = dividirIntercalacao(v, trabalhos, total, origem + tamanho * (size_t)inicio, meio - inicio,
+                                        origem + tamanho * (size_t)meio, fim - meio,
+                                        destino + tamanho * (size_t)inicio, partes > 1 ? partes : 1,
+                                        &comparacoes);
+            limites[novas++] = inicio;
+        }
+        limites[novas] = n;
+        comparacoes += executarEmParalelo(v, auxiliar, trabalhos, total, threads);
+
+        faixas = novas;
+        unsigned char* trocaPapel = origem;
+        origem = destino;
+        destino = trocaPapel;
+    }
+
+    // O resultado ficou no auxiliar: copia de volta, tambem em paralelo
+    if (origem != v->base) {
+        int total = dividirIntercalacao(v, trabalhos, 0, origem, n, origem, 0, v->base, threads, &comparacoes);
+        executarEmParalelo(v, auxiliar, trabalhos, total, threads);
+    }
+
+    free(auxiliar);
+    free(trabalhos);
+    free(limites);
+    return comparacoes;
+}
+
+// ============================================================================
+// INTROSORT (NAO ESTAVEL, SEM MEMORIA EXTRA)
+// ============================================================================
+
+/*
+ * Funcao: afundar
+ * Restaura a propriedade de heap maximo a partir da raiz informada.
+ * O heap ocupa as posicoes [inicio, inicio + n).
+ */
+static long afundar(const Vetor* v, int inicio, int raiz, int n) {
+    long comparacoes = 0;
+
+    while (2 * raiz + 1 < n) {
+        int filho = 2 * raiz + 1;
+
+        if (filho + 1 < n) {
+            comparacoes++;
+            if (compararPosicoes(v, inicio + filho, inicio + filho + 1) < 0) {
+                filho++;
+            }
+        }
+
+        comparacoes++;
+        if (compararPosicoes(v, inicio + raiz, inicio + filho) >= 0) {
+            break;
+        }
+
+        trocar(v, inicio + raiz, inicio + filho);
+        raiz = filho;
+    }
+
+    return comparacoes;
+}
+
+/*
+ * Funcao: heapSort
+ * Heapsort em [inicio, inicio + n): garante O(n log n) quando o
+ * quicksort degenera.
+ */
+static long heapSort(const Vetor* v, int inicio, int n) {
+    long comparacoes = 0;
+
+    for (int i = n / 2 - 1; i >= 0; i--) {
+        comparacoes += afundar(v, inicio, i, n);
+    }
+    for (int fim = n - 1; fim > 0; fim--) {
+        trocar(v, inicio, inicio + fim);
+        comparacoes += afundar(v, inicio, 0, fim);
+    }
+
+    return comparacoes;
+}
+
+/*
+ * Funcao: medianaDeTres
+ * Ordena os elementos em inicio, meio e fim entre si e deixa a mediana
+ * no meio, o que evita o pior caso do quicksort em vetores ja ordenados
+ * ou invertidos.
+ */
+static long medianaDeTres(const Vetor* v, int inicio, int meio, int fim) {
+    if (compararPosicoes(v, meio, inicio) < 0) {
+        trocar(v, meio, inicio);
+    }
+    if (compararPosicoes(v, fim, meio) < 0) {
+        trocar(v, fim, meio);
+        if (compararPosicoes(v, meio, inicio) < 0) {
+            trocar(v, meio, inicio);
+        }
+        return 3;
+    }
+    return 2;
+}
+
+/*
+ * Funcao: introSortRecursivo
+ * Quicksort (particao de Hoare com mediana de tres) sobre [inicio, fim].
+ * Quando a profundidade passa do limite 2*log2(n), a faixa e entregue ao
+ * Heapsort; faixas pequenas terminam no Insertion Sort.
+ */
+static long introSortRecursivo(const Vetor* v, int inicio, int fim, int profundidade) {
+    long comparacoes = 0;
+    Elemento pivo;
+
+    while (fim - inicio + 1 > LIMITE_INSERCAO) {
+        if (profundidade == 0) {
+            return comparacoes + heapSort(v, inicio, fim - inicio + 1);
+        }
+        profundidade--;
+
+        int meio = inicio + (fim - inicio) / 2;
+        comparacoes += medianaDeTres(v, inicio, meio, fim);
+        copiar(v, &pivo, elemento(v, meio));
+
+        int i = inicio - 1;
+        int j = fim + 1;
+        while (1) {
+            do {
+                i++;
+                comparacoes++;
+            } while (comparar(v, elemento(v, i), &pivo) < 0);
+            do {
+                j--;
+                comparacoes++;
+            } while (comparar(v, elemento(v, j), &pivo) > 0);
+
+            if (i >= j) {
+                break;
+            }
+            trocar(v, i, j);
+        }
+
+        // Recursao na menor particao e laco na maior: pilha O(log n)
+        if (j - inicio < fim - j) {
+            comparacoes += introSortRecursivo(v, inicio, j, profundidade);
+            inicio = j + 1;
+        } else {
+            comparacoes += introSortRecursivo(v, j + 1, fim, profundidade);
+            fim = j;
+        }
+    }
+
+    return comparacoes + insertionSortFaixa(v, inicio, fim + 1);
+}
+
+/*
+ * Funcao: introSort
+ * Introsort: quicksort com limite de profundidade.
+ *
+ * Complexidade: O(n log n) no pior caso; memoria extra O(log n) (pilha)
+ */
+static long introSort(const Vetor* v, int n) {
+    int profundidade = 0;
+
+    for (int m = n; m > 1; m /= 2) {
+        profundidade += 2;
+    }
+
+    return introSortRecursivo(v, 0, n - 1, profundidade);
+}
+
+// ============================================================================
+// COUNTING SORT (PRIORIDADE E TIPO)
+// ============================================================================
+
+/*
+ * Funcao: chaveInteira
+ * Chave inteira do criterio, crescente na ordem desejada: a prioridade
+ * negada (ordem decrescente) ou a posicao alfabetica do tipo.
+ */
+static int chaveInteira(const Vetor* v, const void* e) {
+    if (v->colunas != NULL) {
+        int linha = linhaDe(e);
+        return v->criterio == TIPO ? tipoPosicao(v->colunas->tipos[linha]) : -v->colunas->prioridades[linha];
+    }
+
+    const Item* item = itemDe(v, e);
+
+    if (v->criterio == TIPO) {
+        return tipoPosicao(item->idTipo);
+    }
+    return -item->prioridade;
+}
+
+/*
+ * Funcao: faixaChaves
+ * Menor e maior chave inteira entre os elementos do vetor.
+ */
+static void faixaChaves(const Vetor* v, int n, int* menor, int* maior) {
+    *menor = chaveInteira(v, elemento(v, 0));
+    *maior = *menor;
+
+    for (int i = 1; i < n; i++) {
+        int k = chaveInteira(v, elemento(v, i));
+        if (k < *menor) {
+            *menor = k;
+        } else if (k > *maior) {
+            *maior = k;
+        }
+    }
+}
+
+/*
+ * Funcao: countingSort
+ * Ordena pela chave inteira contando quantos elementos ha de cada valor:
+ * a soma acumulada das contagens da a posicao final de cada grupo, e os
+ * elementos sao distribuidos no vetor auxiliar na ordem original
+ * (estavel). Nenhuma comparacao entre itens e feita.
+ *
+ * Complexidade: O(n + k), k = maior - menor + 1; memoria extra O(n + k)
+ *
+ * Se faltar memoria, usa Insertion Sort (tambem estavel).
+ */
+static long countingSort(const Vetor* v, int n) {
+    int menor;
+    int maior;
+    faixaChaves(v, n, &menor, &maior);
+
+    int faixa = maior - menor + 1;
+    int* inicioGrupo = (int*)calloc((size_t)faixa + 1, sizeof(int));
+    unsigned char* auxiliar = (unsigned char*)malloc(v->tamanho * (size_t)n);
+    if (inicioGrupo == NULL || auxiliar == NULL) {
+        free(inicioGrupo);
+        free(auxiliar);
+        return insertionSortFaixa(v, 0, n);
+    }
+
+    for (int i = 0; i < n; i++) {
+        inicioGrupo[chaveInteira(v, elemento(v, i)) - menor + 1]++;
+    }
+    for (int g = 1; g <= faixa; g++) {
+        inicioGrupo[g] += inicioGrupo[g - 1];
+    }
+
+    for (int i = 0; i < n; i++) {
+        int grupo = chaveInteira(v, elemento(v, i)) - menor;
+        copiar(v, auxiliar + (size_t)inicioGrupo[grupo]++ * v->tamanho, elemento(v, i));
+    }
+
+    copiarBloco(v, v->base, auxiliar, n);
+    free(auxiliar);
+    free(inicioGrupo);
+    return 0;
+}
+
+// ============================================================================
+// RADIX SORT (MSD PARA NOME, LSD PARA PRIORIDADE E TIPO)
+// ============================================================================
+
+/*
+ * Funcao: chaveTexto
+ * Nome do item usado como chave e sua largura maxima.
+ */
+static const unsigned char* chaveTexto(const Vetor* v, const void* e, int* largura) {
+    *largura = TAM_NOME;
+    if (v->colunas != NULL) {
+        return (const unsigned char*)v->colunas->nomes[linhaDe(e)];
+    }
+    return (const unsigned char*)itemDe(v, e)->nome;
+}
+
+/*
+ * Funcao: byteNaProfundidade
+ * Byte da chave na posicao "profundidade". Chaves que ja terminaram
+ * retornam 0, que vem antes de qualquer caractere - a mesma regra do
+ * strcmp, que compara os bytes como unsigned char.
+ */
+static int byteNaProfundidade(const Vetor* v, const void* e, int profundidade) {
+    int largura;
+    const unsigned char* chave = chaveTexto(v, e, &largura);
+    return profundidade < largura ? chave[profundidade] : 0;
+}
+
+/*
+ * Funcao: radixSortRecursivo
+ * Ordena [inicio, fim), cujas chaves sao iguais ate profundidade - 1,
+ * distribuindo os elementos em 256 grupos pelo byte da posicao
+ * "profundidade" (contagem + distribuicao estavel no vetor auxiliar).
+ * O grupo 0 (chaves terminadas) ja esta pronto; os demais sao ordenados
+ * recursivamente a partir do byte seguinte.
+ *
+ * Prefixos compartilhados ("Kit Medico", "Kit Reparo", ...): quando todos
+ * os elementos caem no mesmo grupo, nada e movido e a funcao apenas
+ * avanca para o proximo byte.
+ */
+static long radixSortRecursivo(const Vetor* v, unsigned char* auxiliar, int inicio, int fim,
+                               int profundidade) {
+    long comparacoes = 0;
+    int contagem[TOTAL_BYTES + 1];
+    int largura;
+
+    chaveTexto(v, elemento(v, inicio), &largura);
+
+    while (fim - inicio > LIMITE_RADIX && profundidade < largura) {
+        memset(contagem, 0, sizeof(contagem));
+        for (int i = inicio; i < fim; i++) {
+            contagem[byteNaProfundidade(v, elemento(v, i), profundidade) + 1]++;
+        }
+
+        // Todos no mesmo grupo: prefixo comum, passa ao proximo byte
+        int unico = byteNaProfundidade(v, elemento(v, inicio), profundidade);
+        if (contagem[unico + 1] == fim - inicio) {
+            if (unico == 0) {
+                return comparacoes;  // Todas as chaves terminaram: iguais
+            }
+            profundidade++;
+            continue;
+        }
+
+        // contagem[b] passa a ser o inicio do grupo b
+        for (int b = 1; b <= TOTAL_BYTES; b++) {
+            contagem[b] += contagem[b - 1];
+        }
+
+        int proximo[TOTAL_BYTES];
+        memcpy(proximo, contagem, sizeof(proximo));
+        for (int i = inicio; i < fim; i++) {
+            int b = byteNaProfundidade(v, elemento(v, i), profundidade);
+            copiar(v, auxiliar + (size_t)proximo[b]++ * v->tamanho, elemento(v, i));
+        }
+        copiarBloco(v, elemento(v, inicio), auxiliar, fim - inicio);
+
+        // Grupo 0: chaves terminadas, iguais entre si. Demais: recursao.
+        for (int b = 1; b < TOTAL_BYTES; b++) {
+            int tamanhoGrupo = contagem[b + 1] - contagem[b];
+            if (tamanhoGrupo > 1) {
+                comparacoes += radixSortRecursivo(v, auxiliar, inicio + contagem[b],
+                                                  inicio + contagem[b + 1], profundidade + 1);
+            }
+        }
+        return comparacoes;
+    }
+
+    if (profundidade >= largura) {
+        return comparacoes;
+    }
+    return comparacoes + insertionSortFaixa(v, inicio, fim);
+}
+
+/*
+ * Funcao: radixSortInteiro
+ * Radix Sort LSD pela chave inteira (PRIORIDADE ou TIPO): uma passada de
+ * contagem + distribuicao estavel por byte de (chave - menor), do byte
+ * menos significativo ao mais significativo. Com faixa de ate 256
+ * valores e uma unica passada, como o Counting Sort.
+ */
+static long radixSortInteiro(const Vetor* v, unsigned char* auxiliar, int n) {
+    int menor;
+    int maior;
+    faixaChaves(v, n, &menor, &maior);
+
+    unsigned int amplitude = (unsigned int)((long)maior - menor);
+    int contagem[TOTAL_BYTES + 1];
+
+    // Sempre ao menos uma passada; depois, enquanto a amplitude tiver bytes
+    for (int deslocamento = 0; deslocamento < 32; deslocamento += 8) {
+        if (deslocamento > 0 && (amplitude >> deslocamento) == 0) {
+            break;
+        }
+        memset(contagem, 0, sizeof(contagem));
+        for (int i = 0; i < n; i++) {
+            unsigned int chave = (unsigned int)((long)chaveInteira(v, elemento(v, i)) - menor);
+            contagem[((chave >> deslocamento) & 0xFF) + 1]++;
+        }
+        for (int b = 1; b <= TOTAL_BYTES; b++) {
+            contagem[b] += contagem[b - 1];
+        }
+        for (int i = 0; i < n; i++) {
+            unsigned int chave = (unsigned int)((long)chaveInteira(v, elemento(v, i)) - menor);
+            int b = (int)((chave >> deslocamento) & 0xFF);
+            copiar(v, auxiliar + (size_t)contagem[b]++ * v->tamanho, elemento(v, i));
+        }
+        copiarBloco(v, v->base, auxiliar, n);
+    }
+    return 0;
+}
+
+/*
+ * Funcao: radixSort
+ * Radix Sort pelo criterio: MSD pelos bytes do nome, ou LSD pela chave
+ * inteira de prioridade e tipo.
+ *
+ * Complexidade: O(n * L) passos de distribuicao, L = tamanho medio do
+ * prefixo que distingue os nomes, ou bytes da faixa de chaves inteiras;
+ * memoria extra O(n)
+ *
+ * Se faltar memoria, usa Insertion Sort (tambem estavel).
+ */
+static long radixSort(const Vetor* v, int n) {
+    unsigned char* auxiliar = (unsigned char*)malloc(v->tamanho * (size_t)n);
+    if (auxiliar == NULL) {
+        return insertionSortFaixa(v, 0, n);
+    }
+
+    long comparacoes = v->criterio == NOME ? radixSortRecursivo(v, auxiliar, 0, n, 0)
+                                           : radixSortInteiro(v, auxiliar, n);
+    free(auxiliar);
+    return comparacoes;
+}
+
+/*
+ * Funcao: escolherAlgoritmo
+ * O algoritmo pedido e sempre respeitado. A excecao e COUNTING_SORT, o
+ * pedido "automatico": vira Counting Sort se a chave e inteira
+ * (PRIORIDADE ou TIPO) e a faixa de valores e pequena, e Merge Sort (o
+ * equivalente estavel) caso contrario.
+ */
+static AlgoritmoOrdenacao escolherAlgoritmo(const Vetor* v, int n, AlgoritmoOrdenacao pedido) {
+    if (pedido == COUNTING_SORT) {
+        bool contagemPossivel = false;
+
+        if (v->criterio != NOME && n > 1) {
+            int menor;
+            int maior;
+            faixaChaves(v, n, &menor, &maior);
+            contagemPossivel = (long)maior - menor < LIMITE_FAIXA_CONTAGEM;
+        }
+        return contagemPossivel ? COUNTING_SORT : MERGE_SORT;
+    }
+    return pedido;
+}
+
+/*
+ * Funcao: executarAlgoritmo
+ * Despacha para o algoritmo escolhido.
+ */
+static long executarAlgoritmo(const Vetor* v, int n, AlgoritmoOrdenacao algoritmo) {
+    switch (escolherAlgoritmo(v, n, algoritmo)) {
+        case SELECTION_SORT:
+            return selectionSort(v, n);
+        case BUBBLE_SORT:
+            return bubbleSort(v, n);
+        case INSERTION_SORT:
+            return insertionSortFaixa(v, 0, n);
+        case MERGE_SORT:
+            return mergeSort(v, n);
+        case INTRO_SORT:
+            return introSort(v, n);
+        case COUNTING_SORT:
+            return countingSort(v, n);
+        case RADIX_SORT:
+            return radixSort(v, n);
+        case MERGE_SORT_PARALELO:
+            return mergeSortParalelo(v, n, 0, 0);
+    }
+    return 0;
+}
+
+/*
+ * Funcao: ordenarVetor
+ * Ordena e soma as comparacoes nas estatisticas do vetor.
+ */
+static long ordenarVetor(const Vetor* v, int n, AlgoritmoOrdenacao algoritmo) {
+    if (n <= 1) {
+        return 0;
+    }
+
+    long comparacoes = executarAlgoritmo(v, n, algoritmo);
+    if (v->estatisticas != NULL) {
+        v->estatisticas->comparacoes += comparacoes;
+    }
+    return comparacoes;
+}
+
+// ============================================================================
+// INTERFACE PUBLICA
+// ============================================================================
+
+/*
+ * Funcao: ordenarItens
+ * Ordena o vetor de itens pelo criterio informado usando o algoritmo
+ * escolhido, movendo os proprios itens.
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, soma comparacoes, trocas e movimentos
+ *
+ * Retorno: numero de comparacoes realizadas (analise de desempenho)
+ */
+long ordenarItens(Item* itens, int n, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                  Estatisticas* estatisticas) {
+    Vetor v = { (unsigned char*)itens, sizeof(Item), NULL, false, criterio, estatisticas, NULL };
+    return ordenarVetor(&v, n, algoritmo);
+}
+
+/*
+ * Funcao: ordenarIndices
+ * Ordena o vetor de indices "ordem" de forma que itens[ordem[0]],
+ * itens[ordem[1]], ... fiquem em ordem pelo criterio. Os itens nao sao
+ * movidos: cada troca move apenas um int. "ordem" deve chegar preenchido
+ * com posicoes validas de itens (ver preencherIndices).
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, soma comparacoes, trocas e movimentos
+ *                   (os movimentos sao de indices: 4 bytes cada)
+ *
+ * Retorno: numero de comparacoes realizadas
+ */
+long ordenarIndices(const Item* itens, int* ordem, int n, CriterioOrdenacao criterio,
+                    AlgoritmoOrdenacao algoritmo, Estatisticas* estatisticas) {
+    Vetor v = { (unsigned char*)ordem, sizeof(int), itens, true, criterio, estatisticas, NULL };
+    return ordenarVetor(&v, n, algoritmo);
+}
+
+/*
+ * Funcao: ordenarColunas
+ * Como ordenarIndices, para uma mochila em colunas: "ordem" recebe as
+ * linhas na ordem do criterio, lendo so as colunas da chave. Mesmos
+ * algoritmos e mesma ordem final de ordenarIndices sobre os itens
+ * equivalentes.
+ *
+ * Retorno: numero de comparacoes realizadas
+ */
+long ordenarColunas(const ColunasOrdenacao* colunas, int* ordem, int n, CriterioOrdenacao criterio,
+                    AlgoritmoOrdenacao algoritmo, Estatisticas* estatisticas) {
+    Vetor v = { (unsigned char*)ordem, sizeof(int), NULL, true, criterio, estatisticas, colunas };
+    return ordenarVetor(&v, n, algoritmo);
+}
+
+/*
+ * Funcao: ordenarItensParalelo
+ * Ordena os itens com o Merge Sort paralelo para qualquer criterio,
+ * escolhendo threads e limite (ordenarItens com MERGE_SORT_PARALELO usa
+ * os padroes).
+ *
+ * Complexidade: O((n log n) / p) com p threads; memoria extra O(n)
+ *
+ * Parametros:
+ *   - threads: threads a usar; 0 para uma por processador
+ *   - limite: abaixo de quantos itens ordenar em uma thread so; 0 para
+ *             LIMITE_PARALELO
+ *   - estatisticas: se nao for NULL, soma o trabalho de todas as threads
+ *
+ * Retorno: numero de comparacoes realizadas (somadas entre as threads)
+ */
+long ordenarItensParalelo(Item* itens, int n, CriterioOrdenacao criterio, int threads, int limite,
+                          Estatisticas* estatisticas) {
+    Vetor v = { (unsigned char*)itens, sizeof(Item), NULL, false, criterio, estatisticas, NULL };
+    long comparacoes = n > 1 ? mergeSortParalelo(&v, n, threads, limite) : 0;
+
+    if (estatisticas != NULL) {
+        estatisticas->comparacoes += comparacoes;
+    }
+    return comparacoes;
+}
+
+/*
+ * Funcao: threadsOrdenacao
+ * Quantas threads o Merge Sort paralelo usa para n elementos.
+ *
+ * Parametros:
+ *   - threads: threads pedidas; 0 para uma por processador disponivel
+ *   - limite: abaixo de quantos elementos usar uma thread so; 0 para
+ *             LIMITE_PARALELO
+ *
+ * Retorno: entre 1 e MAX_THREADS_ORDENACAO
+ */
+int threadsOrdenacao(int n, int threads, int limite) {
+    if (limite <= 0) {
+        limite = LIMITE_PARALELO;
+    }
+    if (n < limite) {
+        return 1;
+    }
+
+    if (threads <= 0) {
+        long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = processadores > 0 ? (int)(processadores < MAX_THREADS_ORDENACAO ? processadores
+                                                                                : MAX_THREADS_ORDENACAO)
+                                    : 1;
+    }
+    if (threads > MAX_THREADS_ORDENACAO) {
+        threads = MAX_THREADS_ORDENACAO;
+    }
+    // Cada faixa precisa de alguns elementos para valer uma thread
+    if (threads > n / LIMITE_INSERCAO) {
+        threads = n / LIMITE_INSERCAO;
+    }
+    return threads > 1 ? threads : 1;
+}
+
+/*
+ * Funcao: preencherIndices
+ * Preenche ordem com a permutacao identidade 0, 1, ..., n-1.
+ */
+void preencherIndices(int* ordem, int n) {
+    for (int i = 0; i < n; i++) {
+        ordem[i] = i;
+    }
+}
+
+/*
+ * Funcao: aplicarPermutacao
+ * Reorganiza os itens de acordo com a ordem calculada por ordenarIndices:
+ * ao final, a posicao i contem o item que estava em ordem[i].
+ *
+ * Complexidade: O(n) - percorre cada ciclo da permutacao uma vez, com um
+ * unico item temporario por ciclo; cada item e movido no maximo uma vez
+ * (mais uma copia por ciclo)
+ *
+ * O vetor ordem e consumido (termina como a identidade).
+ *
+ * Parametros:
+ *   - estatisticas: se nao for NULL, soma os itens movidos
+ */
+void aplicarPermutacao(Item* itens, int* ordem, int n, Estatisticas* estatisticas) {
+    long movimentos = 0;
+
+    for (int i = 0; i < n; i++) {
+        if (ordem[i] == i) {
+            continue;
+        }
+
+        Item temp = itens[i];
+        int j = i;
+        movimentos += 2;  // Entrada e saida do temporario
+
+        while (ordem[j] != i) {
+            int proximo = ordem[j];
+            itens[j] = itens[proximo];
+            ordem[j] = j;
+            j = proximo;
+            movimentos++;
+        }
+
+        itens[j] = temp;
+        ordem[j] = j;
+    }
+
+    if (estatisticas != NULL) {
+        estatisticas->movimentos += movimentos;
+        estatisticas->bytesMovidos += movimentos * (long long)sizeof(Item);
+    }
+}
+
+/*
+ * Funcao: algoritmoEfetivo
+ * Informa qual algoritmo ordenarItens/ordenarIndices realmente usara para
+ * este vetor e criterio (o pedido COUNTING_SORT vira Counting Sort ou
+ * Merge Sort conforme a faixa de chaves). Usado pelos menus para exibir o
+ * algoritmo executado.
+ */
+AlgoritmoOrdenacao algoritmoEfetivo(const Item* itens, int n, CriterioOrdenacao criterio,
+                                    AlgoritmoOrdenacao pedido) {
+    Vetor v = { (unsigned char*)itens, sizeof(Item), NULL, false, criterio, NULL, NULL };
+    return escolherAlgoritmo(&v, n, pedido);
+}
+
+/*
+ * Funcao: algoritmoEfetivoColunas
+ * algoritmoEfetivo para ordenarColunas; "ordem" sao as linhas a ordenar.
+ */
+AlgoritmoOrdenacao algoritmoEfetivoColunas(const ColunasOrdenacao* colunas, const int* ordem, int n,
+                                           CriterioOrdenacao criterio, AlgoritmoOrdenacao pedido) {
+    Vetor v = { (unsigned char*)ordem, sizeof(int), NULL, true, criterio, NULL, colunas };
+    return escolherAlgoritmo(&v, n, pedido);
+}
+
+/*
+ * Funcao: algoritmoEstavel
+ * Indica se o algoritmo preserva a ordem relativa de itens empatados.
+ */
+bool algoritmoEstavel(AlgoritmoOrdenacao algoritmo) {
+    return algoritmo != SELECTION_SORT && algoritmo != INTRO_SORT;
+}
+
+/*
+ * Funcao: nomeAlgoritmo
+ * Nome do algoritmo para exibicao nos menus.
+ */
+const char* nomeAlgoritmo(AlgoritmoOrdenacao algoritmo) {
+    switch (algoritmo) {
+        case SELECTION_SORT:
+            return "Selection Sort";
+        case BUBBLE_SORT:
+            return "Bubble Sort";
+        case INSERTION_SORT:
+            return "Insertion Sort";
+        case MERGE_SORT:
+            return "Merge Sort";
+        case INTRO_SORT:
+            return "Introsort";
+        case COUNTING_SORT:
+            return "Counting Sort";
+        case RADIX_SORT:
+            return "Radix Sort";
+        case MERGE_SORT_PARALELO:
+            return "Merge Sort paralelo";
+    }
+    return "?";
+}
@@ -0,0 +1,101 @@
+/*
+ * LIBMOCHILA - MOTOR DE ORDENACAO
+ *
+ * Descricao: Algoritmos de ordenacao sobre vetores de Item, para qualquer
+ * CriterioOrdenacao. Os algoritmos quadraticos (Selection, Bubble e
+ * Insertion Sort) continuam disponiveis para comparacao; Merge Sort
+ * (estavel) e Introsort (nao estavel) resolvem em O(n log n).
+ * Todos contam as comparacoes realizadas, exibidas pelos menus, e
+ * registram trocas e movimentos em um contexto Estatisticas opcional.
+ *
+ * Cada algoritmo pode mover os proprios itens (ordenarItens) ou apenas
+ * um vetor de indices (ordenarIndices), que custa 4 bytes por movimento
+ * em vez de sizeof(Item). A ordem por indices pode ser aplicada aos itens
+ * de uma vez (aplicarPermutacao) ou mantida como uma visao. As linhas de
+ * uma mochila em colunas sao ordenadas pelos mesmos algoritmos
+ * (ordenarColunas).
+ */
+
+#ifndef ORDENACAO_H
+#define ORDENACAO_H
+
+#include <stdbool.h>
+
+#include "estatisticas.h"
+#include "item.h"
+
+/*
+ * Enum: AlgoritmoOrdenacao
+ * Algoritmos de ordenacao disponiveis na biblioteca.
+ *
+ *   - SELECTION_SORT: O(n^2) sempre, poucas trocas, nao estavel
+ *   - BUBBLE_SORT:    O(n^2), estavel
+ *   - INSERTION_SORT: O(n^2) no pior caso, O(n) se quase ordenado, estavel
+ *   - MERGE_SORT:     O(n log n) sempre, estavel, usa vetor auxiliar de n itens
+ *   - INTRO_SORT:     O(n log n) no pior caso (quicksort que recorre ao
+ *                     heapsort se a recursao ficar profunda), nao estavel
+ *   - COUNTING_SORT:  O(n + k) por contagem, sem comparacoes, estavel;
+ *                     so para PRIORIDADE e TIPO com faixa de valores k
+ *                     pequena, senao vira Merge Sort (pedido "automatico")
+ *   - RADIX_SORT:     radix MSD sobre os bytes do nome, O(n * L)
+ *                     (L = tamanho do prefixo que distingue as chaves),
+ *                     estavel, mesma ordem do strcmp; para PRIORIDADE e
+ *                     TIPO, radix LSD por byte da chave inteira (uma
+ *                     passada por byte da faixa de valores)
+ *   - MERGE_SORT_PARALELO: Merge Sort em uma thread por processador
+ *                     (pthreads), estavel; abaixo de LIMITE_PARALELO
+ *                     elementos e o Merge Sort comum
+ *
+ * Um algoritmo pedido explicitamente e sempre o executado (exceto o
+ * Counting Sort com faixa grande), para que os algoritmos possam ser
+ * comparados; o Counting Sort so entra quando pedido, ou pelo
+ * caminho rapido (mochilaOrdenarRapido). Para TIPO a chave e a posicao
+ * alfabetica do tipo no dicionario (tipos.h), entao a ordem e a mesma do
+ * strcmp nos nomes.
+ */
+typedef enum {
+    SELECTION_SORT,
+    BUBBLE_SORT,
+    INSERTION_SORT,
+    MERGE_SORT,
+    INTRO_SORT,
+    COUNTING_SORT,
+    RADIX_SORT,
+    MERGE_SORT_PARALELO
+} AlgoritmoOrdenacao;
+
+/*
+ * Struct: ColunasOrdenacao
+ * Colunas de uma mochila em colunas (mochila_colunar.h) lidas pelo motor
+ * de ordenacao: a linha i de cada coluna e um item.
+ */
+typedef struct {
+    const uint64_t* prefixos;
+    const char (*nomes)[TAM_NOME];
+    const unsigned short* tipos;
+    const int* prioridades;
+} ColunasOrdenacao;
+
+#define LIMITE_FAIXA_CONTAGEM 1024  // Maior faixa de chaves para o Counting Sort
+#define LIMITE_PARALELO 32768       // Menos elementos que isso: Merge Sort em uma thread
+#define MAX_THREADS_ORDENACAO 64
+
+long ordenarItens(Item* itens, int n, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                  Estatisticas* estatisticas);
+long ordenarIndices(const Item* itens, int* ordem, int n, CriterioOrdenacao criterio,
+                    AlgoritmoOrdenacao algoritmo, Estatisticas* estatisticas);
+long ordenarColunas(const ColunasOrdenacao* colunas, int* ordem, int n, CriterioOrdenacao criterio,
+                    AlgoritmoOrdenacao algoritmo, Estatisticas* estatisticas);
+long ordenarItensParalelo(Item* itens, int n, CriterioOrdenacao criterio, int threads, int limite,
+                          Estatisticas* estatisticas);
+int threadsOrdenacao(int n, int threads, int limite);
+void preencherIndices(int* ordem, int n);
+void aplicarPermutacao(Item* itens, int* ordem, int n, Estatisticas* estatisticas);
+AlgoritmoOrdenacao algoritmoEfetivo(const Item* itens, int n, CriterioOrdenacao criterio,
+                                    AlgoritmoOrdenacao pedido);
+AlgoritmoOrdenacao algoritmoEfetivoColunas(const ColunasOrdenacao* colunas, const int* ordem, int n,
+                                           CriterioOrdenacao criterio, AlgoritmoOrdenacao pedido);
+bool algoritmoEstavel(AlgoritmoOrdenacao algoritmo);
+const char* nomeAlgoritmo(AlgoritmoOrdenacao algoritmo);
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * LIBMOCHILA - POOL DE BLOCOS DE TAMANHO FIXO
+ *
+ * Implementacao do alocador em slabs com lista de livres.
+ */
+
+#include <stdlib.h>
+
+#include "pool.h"
+
+#define ALINHAMENTO 16              // Alinhamento de cada no entregue
+#define BLOCOS_POR_SLAB_MAXIMO 65536 // Limite do crescimento dos slabs
+
+/*
+ * Funcao: alinhar
+ * Arredonda o tamanho para o proximo multiplo de ALINHAMENTO.
+ */
+static size_t alinhar(size_t tamanho) {
+    return (tamanho + ALINHAMENTO - 1) / ALINHAMENTO * ALINHAMENTO;
+}
+
+/*
+ * Funcao: poolIniciar
+ * Prepara um pool vazio; nenhuma memoria e alocada ate o primeiro no.
+ *
+ * Parametros:
+ *   - tamanhoBloco: tamanho de cada no (ex: sizeof(No))
+ *   - blocosIniciais: quantidade de nos do primeiro slab
+ */
+void poolIniciar(Pool* pool, size_t tamanhoBloco, int blocosIniciais) {
+    if (tamanhoBloco < sizeof(void*)) {
+        tamanhoBloco = sizeof(void*);   // O no livre guarda o ponteiro da lista
+    }
+    if (blocosIniciais < 1) {
+        blocosIniciais = 1;
+    }
+
+    pool->tamanhoBloco = alinhar(tamanhoBloco);
+    pool->blocosPorSlab = blocosIniciais;
+    pool->slabs = NULL;
+    pool->cursor = NULL;
+    pool->restantes = 0;
+    pool->livres = NULL;
+}
+
+/*
+ * Funcao: novoSlab
+ * Aloca um novo slab e o torna o slab atual. Cada slab tem o dobro de
+ * nos do anterior, ate BLOCOS_POR_SLAB_MAXIMO.
+ */
+static int novoSlab(Pool* pool) {
+    size_t cabecalho = alinhar(sizeof(Slab));
+    Slab* slab = (Slab*)malloc(cabecalho + pool->tamanhoBloco * (size_t)pool->blocosPorSlab);
+    if (slab == NULL) {
+        return 0;
+    }
+
+    slab->proximo = pool->slabs;
+    pool->slabs = slab;
+    pool->cursor = (char*)slab + cabecalho;
+    pool->restantes = pool->blocosPorSlab;
+
+    if (pool->blocosPorSlab < BLOCOS_POR_SLAB_MAXIMO) {
+        pool->blocosPorSlab *= 2;
+    }
+    return 1;
+}
+
+/*
+ * Funcao: poolAlocar
+ * Entrega um no: primeiro reaproveita a lista de livres, depois corta o
+ * proximo no do slab atual.
+ *
+ * Complexidade: O(1)
+ *
+ * Retorno: ponteiro para o no, ou NULL se faltou memoria
+ */
+void* poolAlocar(Pool* pool) {
+    if (pool->livres != NULL) {
+        void* bloco = pool->livres;
+        pool->livres = *(void**)bloco;
+        return bloco;
+    }
+
+    if (pool->restantes == 0 && !novoSlab(pool)) {
+        return NULL;
+    }
+
+    void* bloco = pool->cursor;
+    pool->cursor += pool->tamanhoBloco;
+    pool->restantes--;
+    return bloco;
+}
+
+/*
+ * Funcao: poolDevolver
+ * Devolve um no ao pool (vai para a lista de livres).
+ *
+ * Complexidade: O(1)
+ */
+void poolDevolver(Pool* pool, void* bloco) {
+    *(void**)bloco = pool->livres;
+    pool->livres = bloco;
+}
+
+/*
+ * Funcao: poolLiberar
+ * Libera todos os slabs de uma vez, sem percorrer os nos.
+ */
+void poolLiberar(Pool* pool) {
+    Slab* atual = pool->slabs;
+
+    while (atual != NULL) {
+        Slab* proximo = atual->proximo;
+        free(atual);
+        atual = proximo;
+    }
+
+    pool->slabs = NULL;
+    pool->cursor = NULL;
+    pool->restantes = 0;
+    pool->livres = NULL;
+}
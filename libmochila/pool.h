@@ -0,0 +1,49 @@
+/*
+ * LIBMOCHILA - POOL DE BLOCOS DE TAMANHO FIXO
+ *
+ * Descricao: Alocador em "slabs" para estruturas encadeadas. Em vez de um
+ * malloc por no, os nos sao cortados de blocos grandes e contiguos (o que
+ * melhora o uso de cache ao percorrer a lista) e os nos devolvidos vao
+ * para uma lista de livres, reaproveitada na proxima alocacao.
+ * Liberar a estrutura inteira custa uma unica chamada a poolLiberar.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+/*
+ * Struct: Slab
+ * Cabecalho de cada bloco grande alocado; os nos vem logo em seguida.
+ */
+typedef struct Slab {
+    struct Slab* proximo;
+} Slab;
+
+/*
+ * Struct: Pool
+ *
+ * Campos:
+ *   - tamanhoBloco: tamanho de cada no entregue (ja alinhado)
+ *   - blocosPorSlab: quantidade de nos do proximo slab (dobra a cada slab)
+ *   - slabs: lista de todos os slabs alocados
+ *   - cursor: proximo no ainda nao usado do slab atual
+ *   - restantes: nos ainda nao usados no slab atual
+ *   - livres: lista de nos devolvidos (encadeada pelos proprios nos)
+ */
+typedef struct {
+    size_t tamanhoBloco;
+    int blocosPorSlab;
+    Slab* slabs;
+    char* cursor;
+    int restantes;
+    void* livres;
+} Pool;
+
+void poolIniciar(Pool* pool, size_t tamanhoBloco, int blocosIniciais);
+void* poolAlocar(Pool* pool);
+void poolDevolver(Pool* pool, void* bloco);
+void poolLiberar(Pool* pool);
+
+#endif
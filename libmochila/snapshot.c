@@ -0,0 +1,362 @@
+/*
+ * LIBMOCHILA - SNAPSHOT BINARIO DA MOCHILA
+ *
+ * Implementacao da gravacao atomica e da carga por mmap.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "snapshot.h"
+
+#define SUFIXO_TEMPORARIO ".tmp"
+
+/*
+ * Funcao: alinhar
+ * Tamanho arredondado para o proximo multiplo de 8 (inicio das secoes).
+ */
+static uint64_t alinhar(uint64_t tamanho) {
+    return (tamanho + 7) & ~(uint64_t)7;
+}
+
+// ============================================================================
+// GRAVACAO
+// ============================================================================
+
+/*
+ * Funcao: gravarSecao
+ * Grava os bytes e os zeros que completam a secao ate o multiplo de 8.
+ */
+static int gravarSecao(FILE* arquivo, const void* dados, size_t tamanho) {
+    static const char zeros[8] = {0};
+    size_t folga = (size_t)(alinhar(tamanho) - tamanho);
+
+    if (tamanho > 0 && fwrite(dados, 1, tamanho, arquivo) != tamanho) {
+        return 0;
+    }
+    return folga == 0 || fwrite(zeros, 1, folga, arquivo) == folga;
+}
+
+/*
+ * Funcao: gravarTipos
+ * Grava o dicionario de tipos: um nome de TAM_TIPO bytes por id.
+ */
+static int gravarTipos(FILE* arquivo, int totalTipos) {
+    char* nomes = (char*)calloc((size_t)(totalTipos > 0 ? totalTipos : 1), TAM_TIPO);
+    if (nomes == NULL) {
+        return 0;
+    }
+
+    for (int id = 0; id < totalTipos; id++) {
+        strncpy(&nomes[(size_t)id * TAM_TIPO], tipoNome((unsigned short)id), TAM_TIPO - 1);
+    }
+    int resultado = gravarSecao(arquivo, nomes, (size_t)totalTipos * TAM_TIPO);
+    free(nomes);
+    return resultado;
+}
+
+/*
+ * Funcao: gravarArquivo
+ * Grava o cabecalho e todas as secoes e forca os dados para o disco.
+ */
+static int gravarArquivo(const Mochila* mochila, FILE* arquivo, uint32_t geracao) {
+    CabecalhoSnapshot cabecalho;
+    memset(&cabecalho, 0, sizeof(CabecalhoSnapshot));
+    memcpy(cabecalho.magica, MAGICA_SNAPSHOT, sizeof(MAGICA_SNAPSHOT));
+    cabecalho.versao = VERSAO_SNAPSHOT;
+    cabecalho.tamanhoItem = sizeof(Item);
+    cabecalho.tamanhoTipo = TAM_TIPO;
+    cabecalho.totalTipos = (uint32_t)tipoTotal();
+    cabecalho.totalItens = mochila->total;
+    cabecalho.capacidadeHash = mochila->indiceNome.capacidade;
+    cabecalho.opcoes = (mochila->ordenada ? SNAPSHOT_ORDENADA : 0) |
+                       (mochila->insercaoOrdenada ? SNAPSHOT_INSERCAO_ORDENADA : 0) |
+                       (mochila->indicesSecundarios ? SNAPSHOT_INDICES_SECUNDARIOS : 0);
+    cabecalho.criterioOrdem = mochila->criterioOrdem;
+    cabecalho.algoritmoUsado = mochila->algoritmoUsado;
+    cabecalho.geracao = geracao;
+
+    if (!gravarSecao(arquivo, &cabecalho, sizeof(CabecalhoSnapshot)) ||
+        !gravarTipos(arquivo, (int)cabecalho.totalTipos) ||
+        !gravarSecao(arquivo, mochila->itens, sizeof(Item) * (size_t)mochila->total) ||
+        !gravarSecao(arquivo, mochila->indiceNome.entradas,
+                     sizeof(EntradaHash) * (size_t)mochila->indiceNome.capacidade)) {
+        return 0;
+    }
+    if (mochila->indicesSecundarios) {
+        for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+            if (!gravarSecao(arquivo, mochila->indicesOrdem[c].ordem, sizeof(int) * (size_t)mochila->total)) {
+                return 0;
+            }
+        }
+    }
+
+    return fflush(arquivo) == 0 && fsync(fileno(arquivo)) == 0;
+}
+
+/*
+ * Funcao: sincronizarDiretorio
+ * fsync do diretorio do arquivo, para que o rename tambem sobreviva a
+ * uma queda de energia.
+ */
+static void sincronizarDiretorio(const char* caminho) {
+    const char* barra = strrchr(caminho, '/');
+    size_t tamanho = barra != NULL ? (size_t)(barra - caminho) + 1 : 1;
+    char* diretorio = (char*)malloc(tamanho + 1);
+    if (diretorio == NULL) {
+        return;
+    }
+
+    if (barra != NULL) {
+        memcpy(diretorio, caminho, tamanho);
+    } else {
+        diretorio[0] = '.';
+    }
+    diretorio[tamanho] = '\0';
+
+    int descritor = open(diretorio, O_RDONLY);
+    if (descritor >= 0) {
+        fsync(descritor);
+        close(descritor);
+    }
+    free(diretorio);
+}
+
+/*
+ * Funcao: snapshotSalvar
+ * Grava a mochila em 'caminho', substituindo o snapshot anterior de
+ * forma atomica (arquivo temporario + fsync + rename). As lapides sao
+ * compactadas antes, entao o arquivo so tem itens vivos.
+ *
+ * Complexidade: O(n), gravacao sequencial das secoes
+ *
+ * Parametros:
+ *   - geracao: geracao do diario que continua este snapshot (0 sem diario)
+ *
+ * Retorno: 1 se sucesso, 0 se falhou (o snapshot anterior nao e alterado)
+ */
+int snapshotSalvar(Mochila* mochila, const char* caminho, uint32_t geracao) {
+    if (!mochilaCompactar(mochila)) {
+        return 0;
+    }
+
+    char* temporario = (char*)malloc(strlen(caminho) + sizeof(SUFIXO_TEMPORARIO));
+    if (temporario == NULL) {
+        return 0;
+    }
+    strcpy(temporario, caminho);
+    strcat(temporario, SUFIXO_TEMPORARIO);
+
+    FILE* arquivo = fopen(temporario, "wb");
+    if (arquivo == NULL) {
+        free(temporario);
+        return 0;
+    }
+
+    int gravado = gravarArquivo(mochila, arquivo, geracao);
+    gravado = fclose(arquivo) == 0 && gravado;
+    if (gravado && rename(temporario, caminho) == 0) {
+        sincronizarDiretorio(caminho);
+    } else {
+        remove(temporario);
+        gravado = 0;
+    }
+
+    free(temporario);
+    return gravado;
+}
+
+// ============================================================================
+// CARGA
+// ============================================================================
+
+/*
+ * Funcao: tamanhoEsperado
+ * Tamanho do arquivo descrito pelo cabecalho, ou 0 se o cabecalho e de
+ * outro formato, outra versao ou outra ABI.
+ */
+static uint64_t tamanhoEsperado(const CabecalhoSnapshot* cabecalho) {
+    if (memcmp(cabecalho->magica, MAGICA_SNAPSHOT, sizeof(MAGICA_SNAPSHOT)) != 0 ||
+        cabecalho->versao != VERSAO_SNAPSHOT || cabecalho->tamanhoItem != sizeof(Item) ||
+        cabecalho->tamanhoTipo != TAM_TIPO || cabecalho->totalTipos > TIPOS_MAXIMO ||
+        cabecalho->totalItens < 0 || cabecalho->capacidadeHash <= 0 ||
+        (cabecalho->opcoes & ~(uint32_t)(SNAPSHOT_ORDENADA | SNAPSHOT_INSERCAO_ORDENADA |
+                                         SNAPSHOT_INDICES_SECUNDARIOS)) != 0 ||
+        cabecalho->criterioOrdem < 0 || cabecalho->criterioOrdem >= TOTAL_CRITERIOS ||
+        cabecalho->algoritmoUsado < 0 || cabecalho->algoritmoUsado > MERGE_SORT_PARALELO) {
+        return 0;
+    }
+
+    uint64_t tamanho = alinhar(sizeof(CabecalhoSnapshot));
+    tamanho += alinhar((uint64_t)cabecalho->totalTipos * TAM_TIPO);
+    tamanho += alinhar((uint64_t)cabecalho->totalItens * sizeof(Item));
+    tamanho += alinhar((uint64_t)cabecalho->capacidadeHash * sizeof(EntradaHash));
+    if (cabecalho->opcoes & SNAPSHOT_INDICES_SECUNDARIOS) {
+        tamanho += TOTAL_CRITERIOS * alinhar((uint64_t)cabecalho->totalItens * sizeof(int));
+    }
+    return tamanho;
+}
+
+/*
+ * Funcao: carregarTipos
+ * Registra os tipos gravados e monta a traducao id gravado -> id atual.
+ * Num processo que ainda nao registrou tipos, os ids coincidem.
+ *
+ * Retorno: 1 se sucesso, 0 se o dicionario nao comporta os tipos
+ */
+static int carregarTipos(const char* nomes, int totalTipos, unsigned short* ids, bool* traduzir) {
+    *traduzir = false;
+    for (int id = 0; id < totalTipos; id++) {
+        char nome[TAM_TIPO];
+        memcpy(nome, &nomes[(size_t)id * TAM_TIPO], TAM_TIPO);
+        nome[TAM_TIPO - 1] = '\0';
+
+        ids[id] = tipoRegistrar(nome);
+        if (ids[id] == TIPO_INVALIDO) {
+            return 0;
+        }
+        *traduzir = *traduzir || ids[id] != id;
+    }
+    return 1;
+}
+
+/*
+ * Funcao: carregarItens
+ * Copia os itens para a mochila (ja reservada), traduz os ids de tipo
+ * se preciso e refaz os agregados.
+ *
+ * Retorno: 1 se sucesso, 0 se um item e invalido ou faltou memoria
+ */
+static int carregarItens(Mochila* mochila, const Item* itens, int total, const unsigned short* ids,
+                         int totalTipos, bool traduzir) {
+    if (total > 0) {
+        memcpy(mochila->itens, itens, sizeof(Item) * (size_t)total);
+    }
+
+    for (int i = 0; i < total; i++) {
+        Item* item = &mochila->itens[i];
+        if (item->nome[TAM_NOME - 1] != '\0' || item->idTipo >= totalTipos) {
+            return 0;
+        }
+        if (traduzir) {
+            item->idTipo = ids[item->idTipo];
+        }
+        if (!agregadosReservar(&mochila->agregadosTipo, item->idTipo) ||
+            !agregadosReservar(&mochila->agregadosPrioridade, item->prioridade)) {
+            return 0;
+        }
+        agregadosAdicionar(&mochila->agregadosTipo, item->idTipo, item->quantidade);
+        agregadosAdicionar(&mochila->agregadosPrioridade, item->prioridade, item->quantidade);
+        mochila->agregadoGeral.quantidade += item->quantidade;
+    }
+    mochila->agregadoGeral.itens = total;
+    mochila->total = total;
+    return 1;
+}
+
+/*
+ * Funcao: carregarMapa
+ * Monta a mochila a partir do arquivo mapeado, secao por secao.
+ */
+static int carregarMapa(Mochila* mochila, const unsigned char* dados, uint64_t tamanho, uint32_t* geracao) {
+    CabecalhoSnapshot cabecalho;
+    memcpy(&cabecalho, dados, sizeof(CabecalhoSnapshot));
+    if (tamanhoEsperado(&cabecalho) != tamanho) {
+        return 0;
+    }
+
+    int totalTipos = (int)cabecalho.totalTipos;
+    int total = cabecalho.totalItens;
+    const unsigned char* secao = dados + alinhar(sizeof(CabecalhoSnapshot));
+    const char* nomesTipos = (const char*)secao;
+    secao += alinhar((uint64_t)totalTipos * TAM_TIPO);
+    const Item* itens = (const Item*)secao;
+    secao += alinhar((uint64_t)total * sizeof(Item));
+    const EntradaHash* entradas = (const EntradaHash*)secao;
+    secao += alinhar((uint64_t)cabecalho.capacidadeHash * sizeof(EntradaHash));
+
+    unsigned short* ids = (unsigned short*)malloc(sizeof(unsigned short) * (size_t)(totalTipos > 0 ? totalTipos : 1));
+    if (ids == NULL) {
+        return 0;
+    }
+    if (!mochilaIniciar(mochila, 0)) {
+        free(ids);
+        return 0;
+    }
+
+    bool traduzir;
+    int ok = carregarTipos(nomesTipos, totalTipos, ids, &traduzir) && mochilaReservar(mochila, total) &&
+             carregarItens(mochila, itens, total, ids, totalTipos, traduzir) &&
+             indiceHashCarregar(&mochila->indiceNome, entradas, cabecalho.capacidadeHash, total);
+    free(ids);
+
+    if (ok && (cabecalho.opcoes & SNAPSHOT_INDICES_SECUNDARIOS)) {
+        for (int c = 0; ok && c < TOTAL_CRITERIOS; c++) {
+            const int* ordem = (const int*)(secao + (size_t)c * alinhar((uint64_t)total * sizeof(int)));
+            ok = indiceOrdenadoCarregar(&mochila->indicesOrdem[c], ordem, total);
+        }
+        mochila->indicesSecundarios = true;
+    }
+    if (!ok) {
+        mochilaLiberar(mochila);
+        return 0;
+    }
+
+    mochila->ordenada = (cabecalho.opcoes & SNAPSHOT_ORDENADA) != 0;
+    mochila->insercaoOrdenada = (cabecalho.opcoes & SNAPSHOT_INSERCAO_ORDENADA) != 0;
+    mochila->criterioOrdem = (CriterioOrdenacao)cabecalho.criterioOrdem;
+    mochila->algoritmoUsado = (AlgoritmoOrdenacao)cabecalho.algoritmoUsado;
+    if (geracao != NULL) {
+        *geracao = cabecalho.geracao;
+    }
+    return 1;
+}
+
+/*
+ * Funcao: snapshotCarregar
+ * Inicializa a mochila com o conteudo de um snapshot (snapshotSalvar).
+ * O arquivo e mapeado na memoria e cada secao e copiada em bloco para
+ * a estrutura correspondente: nenhum item e reinserido e nenhum indice
+ * e reconstruido. Os tipos do arquivo entram no dicionario global.
+ *
+ * Complexidade: O(n) copias de memoria, sem comparacoes
+ *
+ * Parametros:
+ *   - mochila: mochila nao inicializada (como em mochilaIniciar)
+ *   - geracao: se nao for NULL, recebe a geracao do diario (snapshotSalvar)
+ *
+ * Retorno: 1 se sucesso, 0 se o arquivo nao existe, e de outro formato ou
+ *          faltou memoria (a mochila nao fica inicializada)
+ */
+int snapshotCarregar(Mochila* mochila, const char* caminho, uint32_t* geracao) {
+    int descritor = open(caminho, O_RDONLY);
+    if (descritor < 0) {
+        return 0;
+    }
+
+    struct stat info;
+    if (fstat(descritor, &info) != 0 || info.st_size < (off_t)sizeof(CabecalhoSnapshot)) {
+        close(descritor);
+        return 0;
+    }
+
+    size_t tamanho = (size_t)info.st_size;
+    void* mapa = mmap(NULL, tamanho, PROT_READ, MAP_PRIVATE, descritor, 0);
+    close(descritor);
+    if (mapa == MAP_FAILED) {
+        return 0;
+    }
+
+    // As secoes sao lidas uma vez, do inicio ao fim
+    posix_madvise(mapa, tamanho, POSIX_MADV_SEQUENTIAL);
+    int resultado = carregarMapa(mochila, (const unsigned char*)mapa, tamanho, geracao);
+    munmap(mapa, tamanho);
+    return resultado;
+}
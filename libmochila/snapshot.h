@@ -0,0 +1,76 @@
+/*
+ * LIBMOCHILA - SNAPSHOT BINARIO DA MOCHILA
+ *
+ * Descricao: Grava a mochila inteira num arquivo binario versionado e a
+ * recupera na proxima execucao, sem redigitar os itens. O arquivo guarda
+ * os itens, o dicionario de tipos, a ordem (flag de ordenada por nome,
+ * criterio e algoritmo), o indice hash e os indices secundarios.
+ *
+ * Cada secao e a imagem em memoria da estrutura correspondente, entao
+ * carregar nao interpreta texto nem recalcula hash ou ordem: o arquivo e
+ * mapeado com mmap e cada secao e copiada em bloco. Por isso o formato e
+ * o da maquina que gravou (ordem de bytes e sizeof(Item)); um arquivo de
+ * outra versao ou outra ABI e recusado.
+ *
+ * A gravacao e atomica: o snapshot vai para "<caminho>.tmp", e so depois
+ * de fsync substitui o anterior com rename. Uma queda no meio deixa o
+ * snapshot antigo intacto.
+ *
+ * Configuracoes de execucao (fator de crescimento, encolhimento, remocao
+ * preguicosa) nao sao gravadas.
+ *
+ * O snapshot guarda tambem a geracao do diario (diario.h) que o continua:
+ * um diario de outra geracao ja esta contido no snapshot e nao e reaplicado.
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+
+#include "mochila.h"
+
+#define MAGICA_SNAPSHOT "MOCHILA"   // 8 bytes com o '\0'
+#define VERSAO_SNAPSHOT 1
+
+// Bits de CabecalhoSnapshot.opcoes
+#define SNAPSHOT_ORDENADA            0x1
+#define SNAPSHOT_INSERCAO_ORDENADA   0x2
+#define SNAPSHOT_INDICES_SECUNDARIOS 0x4
+
+/*
+ * Struct: CabecalhoSnapshot
+ * Inicio do arquivo. As secoes vem em seguida, nesta ordem, cada uma
+ * comecando num multiplo de 8 bytes:
+ *
+ *   tipos    totalTipos nomes de TAM_TIPO bytes, na ordem dos ids
+ *   itens    totalItens Item
+ *   hash     capacidadeHash EntradaHash
+ *   indices  TOTAL_CRITERIOS vetores de totalItens int (so com
+ *            SNAPSHOT_INDICES_SECUNDARIOS)
+ *
+ * Campos:
+ *   - magica / versao: identificam o formato
+ *   - tamanhoItem / tamanhoTipo: sizeof(Item) e TAM_TIPO de quem gravou
+ *   - opcoes: bits SNAPSHOT_*
+ *   - criterioOrdem / algoritmoUsado: os campos da Mochila
+ *   - geracao: geracao do diario gravado depois deste snapshot
+ */
+typedef struct {
+    char magica[8];
+    uint32_t versao;
+    uint32_t tamanhoItem;
+    uint32_t tamanhoTipo;
+    uint32_t totalTipos;
+    int32_t totalItens;
+    int32_t capacidadeHash;
+    uint32_t opcoes;
+    int32_t criterioOrdem;
+    int32_t algoritmoUsado;
+    uint32_t geracao;
+} CabecalhoSnapshot;
+
+int snapshotSalvar(Mochila* mochila, const char* caminho, uint32_t geracao);
+int snapshotCarregar(Mochila* mochila, const char* caminho, uint32_t* geracao);
+
+#endif
@@ -0,0 +1,180 @@
+/*
+ * LIBMOCHILA - DICIONARIO DE TIPOS
+ *
+ * Implementacao do dicionario global de tipos.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "tipos.h"
+
+#define CAPACIDADE_INICIAL 16
+
+/*
+ * Dicionario:
+ *   - nomes: nome de cada tipo, indexado pelo id (ordem de registro)
+ *   - alfabetica: ids em ordem alfabetica (busca binaria por nome)
+ *   - posicao: posicao alfabetica de cada id (usada nas comparacoes)
+ */
+static char (*nomes)[TAM_TIPO] = NULL;
+static unsigned short* alfabetica = NULL;
+static unsigned short* posicao = NULL;
+static int total = 0;
+static int capacidade = 0;
+
+/*
+ * Funcao: localizar
+ * Busca binaria do nome na ordem alfabetica.
+ *
+ * Retorno: lugar do nome em "alfabetica" (ou onde deveria entrar);
+ *          *achou indica se ele ja existe
+ */
+static int localizar(const char* nome, int* achou) {
+    int esquerda = 0;
+    int direita = total;
+
+    *achou = 0;
+    while (esquerda < direita) {
+        int meio = esquerda + (direita - esquerda) / 2;
+        int resultado = strcmp(nomes[alfabetica[meio]], nome);
+
+        if (resultado == 0) {
+            *achou = 1;
+            return meio;
+        } else if (resultado < 0) {
+            esquerda = meio + 1;
+        } else {
+            direita = meio;
+        }
+    }
+
+    return esquerda;
+}
+
+/*
+ * Funcao: crescer
+ * Dobra a capacidade dos vetores do dicionario.
+ */
+static int crescer(void) {
+    int nova = capacidade > 0 ? capacidade * 2 : CAPACIDADE_INICIAL;
+    if (nova > TIPOS_MAXIMO) {
+        nova = TIPOS_MAXIMO;
+    }
+
+    char (*novosNomes)[TAM_TIPO] = (char (*)[TAM_TIPO])realloc(nomes, sizeof(*nomes) * (size_t)nova);
+    if (novosNomes == NULL) {
+        return 0;
+    }
+    nomes = novosNomes;
+
+    unsigned short* novaAlfabetica = (unsigned short*)realloc(alfabetica, sizeof(unsigned short) * (size_t)nova);
+    if (novaAlfabetica == NULL) {
+        return 0;
+    }
+    alfabetica = novaAlfabetica;
+
+    unsigned short* novaPosicao = (unsigned short*)realloc(posicao, sizeof(unsigned short) * (size_t)nova);
+    if (novaPosicao == NULL) {
+        return 0;
+    }
+    posicao = novaPosicao;
+
+    capacidade = nova;
+    return 1;
+}
+
+/*
+ * Funcao: tipoRegistrar
+ * Retorna o id do tipo, registrando-o se ainda nao existe. Nomes maiores
+ * que TAM_TIPO - 1 sao truncados.
+ *
+ * Complexidade: O(log k) para tipos ja registrados (k = tipos distintos);
+ *               O(k) ao registrar um tipo novo (raro)
+ *
+ * Retorno: id do tipo, ou TIPO_INVALIDO se faltar memoria ou o limite de
+ *          tipos distintos for atingido
+ */
+unsigned short tipoRegistrar(const char* nome) {
+    char chave[TAM_TIPO];
+    int achou;
+
+    strncpy(chave, nome, TAM_TIPO - 1);
+    chave[TAM_TIPO - 1] = '\0';
+
+    int lugar = localizar(chave, &achou);
+    if (achou) {
+        return alfabetica[lugar];
+    }
+
+    if (total >= TIPOS_MAXIMO || (total == capacidade && !crescer())) {
+        return TIPO_INVALIDO;
+    }
+
+    unsigned short id = (unsigned short)total;
+    memcpy(nomes[id], chave, TAM_TIPO);
+
+    // O novo tipo entra na ordem alfabetica; os que vem depois dele avancam
+    memmove(&alfabetica[lugar + 1], &alfabetica[lugar], sizeof(unsigned short) * (size_t)(total - lugar));
+    alfabetica[lugar] = id;
+    total++;
+
+    for (int i = lugar; i < total; i++) {
+        posicao[alfabetica[i]] = (unsigned short)i;
+    }
+
+    return id;
+}
+
+/*
+ * Funcao: tipoBuscar
+ * Procura um tipo sem registra-lo.
+ *
+ * Retorno: id do tipo, ou -1 se nao registrado
+ */
+int tipoBuscar(const char* nome) {
+    int achou;
+    int lugar = localizar(nome, &achou);
+    return achou ? alfabetica[lugar] : -1;
+}
+
+/*
+ * Funcao: tipoNome
+ * Nome do tipo (texto vazio para ids desconhecidos).
+ */
+const char* tipoNome(unsigned short id) {
+    return id < total ? nomes[id] : "";
+}
+
+/*
+ * Funcao: tipoPosicao
+ * Posicao do tipo na ordem alfabetica. Comparar posicoes equivale a
+ * comparar os nomes com strcmp. Registrar um tipo novo pode mudar as
+ * posicoes, mas nunca a ordem relativa dos tipos existentes.
+ */
+int tipoPosicao(unsigned short id) {
+    return id < total ? posicao[id] : total;
+}
+
+/*
+ * Funcao: tipoTotal
+ * Quantidade de tipos registrados (os ids vao de 0 a tipoTotal() - 1).
+ */
+int tipoTotal(void) {
+    return total;
+}
+
+/*
+ * Funcao: tiposLiberar
+ * Libera o dicionario. Ids obtidos antes deixam de ser validos.
+ */
+void tiposLiberar(void) {
+    free(nomes);
+    free(alfabetica);
+    free(posicao);
+    nomes = NULL;
+    alfabetica = NULL;
+    posicao = NULL;
+    total = 0;
+    capacidade = 0;
+}
@@ -0,0 +1,26 @@
+/*
+ * LIBMOCHILA - DICIONARIO DE TIPOS
+ *
+ * Descricao: Cada categoria de item (arma, municao, cura, ferramenta,
+ * controle, suporte, propulsao...) e guardada uma unica vez neste
+ * dicionario, e o Item carrega apenas o id numerico da categoria.
+ * O dicionario e global (compartilhado por todas as mochilas e listas)
+ * e mantem a posicao alfabetica de cada tipo, de modo que ordenar por
+ * TIPO compara inteiros e continua em ordem alfabetica.
+ */
+
+#ifndef TIPOS_H
+#define TIPOS_H
+
+#define TAM_TIPO 20             // Tamanho maximo do nome de um tipo
+#define TIPO_INVALIDO 0xFFFF    // Id devolvido quando o registro falha
+#define TIPOS_MAXIMO 0xFFFE     // Quantidade maxima de tipos distintos
+
+unsigned short tipoRegistrar(const char* nome);
+int tipoBuscar(const char* nome);
+const char* tipoNome(unsigned short id);
+int tipoPosicao(unsigned short id);
+int tipoTotal(void);
+void tiposLiberar(void);
+
+#endif
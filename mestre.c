@@ -1,32 +1,38 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
+
+#include "mochila.h"
+#include "latencia.h"
+#include "entrada.h"
 
 // Código da Ilha – Edição Free Fire
 // Nível: Mestre - Desafio Final
 // Sistema de priorização e montagem de componentes da torre de fuga
 // Implementa diferentes algoritmos de ordenação, busca binária e análise de desempenho
 
-// Struct Componente: representa um item necessário para a montagem da torre
-typedef struct {
-    char nome[30];
-    char tipo[20];
-    int prioridade;  // de 1 a 10
-} Componente;
-
-// Variáveis globais para medição de desempenho
-int comparacoes = 0;
-
-// Função para limpar buffer de entrada
-void limparBuffer() {
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF);
+#define CAPACIDADE_INICIAL 20   // Espaço reservado de início; a lista cresce sozinha
+#define REPETICOES_ORDENACAO 100 // Execuções medidas de cada ordenação (sobre cópias)
+#define REPETICOES_BUSCA 1000    // Execuções medidas da busca binária
+#define ARQUIVO_LATENCIAS "latencias.csv"  // Se MOCHILA_LATENCIAS não estiver definida
+
+// Componente: representa um item necessário para a montagem da torre.
+// Usa o Item da libmochila (nome, tipo e prioridade de 1 a 10; a quantidade não é usada)
+typedef Item Componente;
+
+// Imprime uma linha da tabela de componentes (chamada por mochilaPercorrer)
+void imprimirComponente(const Componente* componente, int posicao, void* contexto) {
+    (void)posicao;
+    (void)contexto;
+    printf("║ %-28s ║ %-18s ║ %-10d ║\n",
+           componente->nome,
+           tipoNome(componente->idTipo),
+           componente->prioridade);
 }
 
 // Função para exibir todos os componentes formatados
-void mostrarComponentes(Componente componentes[], int n) {
-    if (n == 0) {
+void mostrarComponentes(const Mochila* componentes) {
+    if (mochilaTotal(componentes) == 0) {
         printf("\nNenhum componente cadastrado ainda.\n");
         return;
     }
@@ -37,153 +43,148 @@ void mostrarComponentes(Componente componentes[], int n) {
     printf("║ %-28s ║ %-18s ║ %-10s ║\n", "NOME", "TIPO", "PRIORIDADE");
     printf("╠════════════════════════════════════════════════════════════════════════╣\n");
 
-    for (int i = 0; i < n; i++) {
-        printf("║ %-28s ║ %-18s ║ %-10d ║\n",
-               componentes[i].nome,
-               componentes[i].tipo,
-               componentes[i].prioridade);
-    }
+    mochilaPercorrer(componentes, imprimirComponente, NULL);
 
     printf("╚════════════════════════════════════════════════════════════════════════╝\n");
 }
 
+// Os algoritmos quadráticos ordenam um vetor de índices (4 bytes por troca)
+// e reposicionam os componentes uma única vez no final. Cada ordenação
+// soma seu trabalho (comparações, trocas, movimentos) em 'estatisticas'.
+
 // Bubble Sort - Ordenação por nome (string)
-void bubbleSortNome(Componente componentes[], int n) {
-    comparacoes = 0;
-
-    for (int i = 0; i < n - 1; i++) {
-        for (int j = 0; j < n - i - 1; j++) {
-            comparacoes++;
-            if (strcmp(componentes[j].nome, componentes[j + 1].nome) > 0) {
-                // Troca os componentes
-                Componente temp = componentes[j];
-                componentes[j] = componentes[j + 1];
-                componentes[j + 1] = temp;
-            }
-        }
-    }
+void bubbleSortNome(Mochila* componentes, Estatisticas* estatisticas) {
+    mochilaOrdenarPorIndices(componentes, NOME, BUBBLE_SORT, estatisticas);
 }
 
-// Insertion Sort - Ordenação por tipo (string)
-void insertionSortTipo(Componente componentes[], int n) {
-    comparacoes = 0;
-
-    for (int i = 1; i < n; i++) {
-        Componente chave = componentes[i];
-        int j = i - 1;
-
-        while (j >= 0) {
-            comparacoes++;
-            if (strcmp(componentes[j].tipo, chave.tipo) > 0) {
-                componentes[j + 1] = componentes[j];
-                j--;
-            } else {
-                break;
-            }
-        }
-        componentes[j + 1] = chave;
-    }
+// Insertion Sort - Ordenação por tipo (ordem alfabética do tipo)
+void insertionSortTipo(Mochila* componentes, Estatisticas* estatisticas) {
+    mochilaOrdenarPorIndices(componentes, TIPO, INSERTION_SORT, estatisticas);
 }
 
 // Selection Sort - Ordenação por prioridade (int, ordem decrescente)
-void selectionSortPrioridade(Componente componentes[], int n) {
-    comparacoes = 0;
+void selectionSortPrioridade(Mochila* componentes, Estatisticas* estatisticas) {
+    mochilaOrdenarPorIndices(componentes, PRIORIDADE, SELECTION_SORT, estatisticas);
+}
 
-    for (int i = 0; i < n - 1; i++) {
-        int maxIdx = i;
+// Merge Sort / Introsort / Radix Sort - Ordenação rápida por qualquer critério
+void ordenacaoRapida(Mochila* componentes, CriterioOrdenacao criterio, AlgoritmoOrdenacao algoritmo,
+                     Estatisticas* estatisticas) {
+    mochilaOrdenar(componentes, criterio, algoritmo, estatisticas);
+}
 
-        for (int j = i + 1; j < n; j++) {
-            comparacoes++;
-            // Ordem decrescente (maior prioridade primeiro)
-            if (componentes[j].prioridade > componentes[maxIdx].prioridade) {
-                maxIdx = j;
-            }
-        }
+// Exibe o trabalho da última ordenação: comparações (no Counting Sort,
+// que não compara itens, quantos componentes foram distribuídos), trocas
+// e elementos movidos
+void mostrarTrabalho(const Mochila* componentes, const Estatisticas* estatisticas) {
+    if (mochilaUltimoAlgoritmo(componentes) == COUNTING_SORT) {
+        printf("  Comparações: 0 (%d componentes distribuídos por contagem)\n",
+               mochilaTotal(componentes));
+    } else {
+        printf("  Comparações: %ld\n", estatisticas->comparacoes);
+    }
+    printf("  Trocas: %ld | Movimentos: %ld (%lld bytes)\n",
+           estatisticas->trocas, estatisticas->movimentos, estatisticas->bytesMovidos);
+}
 
-        if (maxIdx != i) {
-            // Troca os componentes
-            Componente temp = componentes[i];
-            componentes[i] = componentes[maxIdx];
-            componentes[maxIdx] = temp;
-        }
+// Exibe o tempo medido: mínimo, mediana e p99 das execuções repetidas
+// (uma execução isolada fica abaixo da resolução de clock())
+void mostrarTempo(const Medicao* medicao) {
+    if (medicao->repeticoes == 0) {
+        printf("  Tempo: não medido (sem memória)\n");
+        return;
+    }
+    printf("  Tempo: mín %llu ns | mediana %llu ns | p99 %llu ns (%d execuções",
+           (unsigned long long)medicao->minimoNs,
+           (unsigned long long)medicao->medianaNs,
+           (unsigned long long)medicao->p99Ns,
+           medicao->repeticoes);
+    if (medicao->medianaCiclos > 0) {
+        printf(", mediana %llu ciclos", (unsigned long long)medicao->medianaCiclos);
     }
+    printf(")\n");
 }
 
-// Busca Binária - Localiza componente por nome (requer ordenação prévia por nome)
-int buscaBinariaPorNome(Componente componentes[], int n, char nomeBuscado[]) {
-    int esquerda = 0;
-    int direita = n - 1;
-    int numComparacoes = 0;
-
-    while (esquerda <= direita) {
-        int meio = esquerda + (direita - esquerda) / 2;
-        numComparacoes++;
-
-        int resultado = strcmp(componentes[meio].nome, nomeBuscado);
-
-        if (resultado == 0) {
-            printf("\n✓ Componente-chave encontrado em %d comparações!\n", numComparacoes);
-            printf("\nDetalhes:\n");
-            printf("  Nome: %s\n", componentes[meio].nome);
-            printf("  Tipo: %s\n", componentes[meio].tipo);
-            printf("  Prioridade: %d\n", componentes[meio].prioridade);
-            return meio;
-        }
+// Exibe as threads do Merge Sort paralelo e o ganho sobre o Merge Sort
+// sequencial, medido da mesma forma (mediana das execuções sobre cópias)
+void mostrarParalelo(const Mochila* componentes, const Medicao* paralelo, const Medicao* sequencial) {
+    printf("  Threads: %d", threadsOrdenacao(mochilaTotal(componentes), 0, 0));
+    if (paralelo->medianaNs > 0 && sequencial->medianaNs > 0) {
+        printf(" | Speedup: %.2fx sobre o Merge Sort sequencial",
+               (double)sequencial->medianaNs / (double)paralelo->medianaNs);
+    }
+    printf("\n");
+}
 
-        if (resultado < 0) {
-            esquerda = meio + 1;
-        } else {
-            direita = meio - 1;
-        }
+// Busca Binária - Localiza componente por nome (requer ordenação prévia por nome)
+int buscaBinariaPorNome(const Mochila* componentes, char nomeBuscado[]) {
+    Estatisticas estatisticas;
+    estatisticasZerar(&estatisticas);
+    int indice = mochilaBuscarBinaria(componentes, nomeBuscado, &estatisticas);
+
+    if (indice == -1) {
+        printf("\n✗ Componente não encontrado após %ld comparações.\n", estatisticas.comparacoes);
+        return -1;
     }
 
-    printf("\n✗ Componente não encontrado após %d comparações.\n", numComparacoes);
-    return -1;
+    const Componente* componente = mochilaItem(componentes, indice);
+    printf("\n✓ Componente-chave encontrado em %ld comparações!\n", estatisticas.comparacoes);
+    printf("\nDetalhes:\n");
+    printf("  Nome: %s\n", componente->nome);
+    printf("  Tipo: %s\n", tipoNome(componente->idTipo));
+    printf("  Prioridade: %d\n", componente->prioridade);
+    return indice;
 }
 
 // Função para cadastrar componentes
-void cadastrarComponentes(Componente componentes[], int *n) {
-    if (*n >= 20) {
-        printf("\n✗ Limite de componentes atingido (20)!\n");
-        return;
-    }
+void cadastrarComponentes(Mochila* componentes) {
+    Componente novo;
+    char tipo[TAM_TIPO];
+    novo.quantidade = 1;
 
     printf("\n═══════════════════════════════════════\n");
     printf("    CADASTRO DE COMPONENTE\n");
     printf("═══════════════════════════════════════\n");
 
     printf("\nNome do componente: ");
-    fgets(componentes[*n].nome, 30, stdin);
-    componentes[*n].nome[strcspn(componentes[*n].nome, "\n")] = 0;  // Remove \n
+    lerTexto(novo.nome, TAM_NOME);  // Remove \n
 
     printf("Tipo (ex: controle, suporte, propulsão): ");
-    fgets(componentes[*n].tipo, 20, stdin);
-    componentes[*n].tipo[strcspn(componentes[*n].tipo, "\n")] = 0;
+    lerTexto(tipo, TAM_TIPO);
+    novo.idTipo = tipoRegistrar(tipo);  // Componente guarda so o id do tipo
 
     printf("Prioridade (1-10): ");
-    scanf("%d", &componentes[*n].prioridade);
+    scanf("%d", &novo.prioridade);
     limparBuffer();
 
     // Validação de prioridade
-    if (componentes[*n].prioridade < 1 || componentes[*n].prioridade > 10) {
+    if (novo.prioridade < 1 || novo.prioridade > 10) {
         printf("✗ Prioridade inválida. Usando 5 como padrão.\n");
-        componentes[*n].prioridade = 5;
+        novo.prioridade = 5;
     }
 
-    (*n)++;
+    if (novo.idTipo == TIPO_INVALIDO) {
+        printf("\n✗ Não foi possível registrar o tipo '%s'!\n", tipo);
+        return;
+    }
+
+    if (!mochilaInserir(componentes, novo)) {
+        printf("\n✗ Erro ao alocar memória para o componente!\n");
+        return;
+    }
     printf("\n✓ Componente cadastrado com sucesso!\n");
 }
 
 // Menu de ordenação
-void menuOrdenacao(Componente componentes[], int n, int *ordenadoPorNome) {
-    if (n == 0) {
+void menuOrdenacao(Mochila* componentes, int *ordenadoPorNome) {
+    if (mochilaTotal(componentes) == 0) {
         printf("\n✗ Nenhum componente cadastrado para ordenar.\n");
         return;
     }
 
     int opcao;
-    clock_t inicio, fim;
-    double tempoExecucao;
+    Medicao medicao;
+    Estatisticas estatisticas;
 
     printf("\n═══════════════════════════════════════\n");
     printf("    ESTRATÉGIAS DE ORDENAÇÃO\n");
@@ -191,64 +192,125 @@ void menuOrdenacao(Componente componentes[], int n, int *ordenadoPorNome) {
     printf("1. Bubble Sort (por nome)\n");
     printf("2. Insertion Sort (por tipo)\n");
     printf("3. Selection Sort (por prioridade)\n");
+    printf("4. Merge Sort (estável, critério à escolha)\n");
+    printf("5. Introsort (critério à escolha)\n");
+    printf("6. Radix Sort (estável; nome pelos bytes, sem strcmp)\n");
+    printf("7. Merge Sort paralelo (uma thread por processador)\n");
+    printf("8. Counting Sort (tipo ou prioridade; Merge Sort se a faixa for grande)\n");
     printf("0. Voltar\n");
     printf("═══════════════════════════════════════\n");
     printf("Escolha: ");
     scanf("%d", &opcao);
     limparBuffer();
+    estatisticasZerar(&estatisticas);
 
     switch (opcao) {
         case 1:
             printf("\nExecutando Bubble Sort...\n");
-            inicio = clock();
-            bubbleSortNome(componentes, n);
-            fim = clock();
-            tempoExecucao = ((double)(fim - inicio)) / CLOCKS_PER_SEC * 1000;
+            mochilaMedirOrdenacao(componentes, NOME, BUBBLE_SORT, true, REPETICOES_ORDENACAO, &medicao);
+            bubbleSortNome(componentes, &estatisticas);
 
             printf("✓ Ordenação concluída!\n");
             printf("  Algoritmo: Bubble Sort\n");
             printf("  Critério: Nome (ordem alfabética)\n");
-            printf("  Comparações: %d\n", comparacoes);
-            printf("  Tempo: %.4f ms\n", tempoExecucao);
+            mostrarTrabalho(componentes, &estatisticas);
+            mostrarTempo(&medicao);
 
             *ordenadoPorNome = 1;
-            mostrarComponentes(componentes, n);
+            mostrarComponentes(componentes);
             break;
 
         case 2:
-            printf("\nExecutando Insertion Sort...\n");
-            inicio = clock();
-            insertionSortTipo(componentes, n);
-            fim = clock();
-            tempoExecucao = ((double)(fim - inicio)) / CLOCKS_PER_SEC * 1000;
+            printf("\nOrdenando por tipo...\n");
+            mochilaMedirOrdenacao(componentes, TIPO, INSERTION_SORT, true, REPETICOES_ORDENACAO, &medicao);
+            insertionSortTipo(componentes, &estatisticas);
 
             printf("✓ Ordenação concluída!\n");
-            printf("  Algoritmo: Insertion Sort\n");
+            printf("  Algoritmo: %s\n", nomeAlgoritmo(mochilaUltimoAlgoritmo(componentes)));
             printf("  Critério: Tipo (ordem alfabética)\n");
-            printf("  Comparações: %d\n", comparacoes);
-            printf("  Tempo: %.4f ms\n", tempoExecucao);
+            mostrarTrabalho(componentes, &estatisticas);
+            mostrarTempo(&medicao);
 
             *ordenadoPorNome = 0;
-            mostrarComponentes(componentes, n);
+            mostrarComponentes(componentes);
             break;
 
         case 3:
-            printf("\nExecutando Selection Sort...\n");
-            inicio = clock();
-            selectionSortPrioridade(componentes, n);
-            fim = clock();
-            tempoExecucao = ((double)(fim - inicio)) / CLOCKS_PER_SEC * 1000;
+            printf("\nOrdenando por prioridade...\n");
+            mochilaMedirOrdenacao(componentes, PRIORIDADE, SELECTION_SORT, true, REPETICOES_ORDENACAO, &medicao);
+            selectionSortPrioridade(componentes, &estatisticas);
 
             printf("✓ Ordenação concluída!\n");
-            printf("  Algoritmo: Selection Sort\n");
+            printf("  Algoritmo: %s\n", nomeAlgoritmo(mochilaUltimoAlgoritmo(componentes)));
             printf("  Critério: Prioridade (maior para menor)\n");
-            printf("  Comparações: %d\n", comparacoes);
-            printf("  Tempo: %.4f ms\n", tempoExecucao);
+            mostrarTrabalho(componentes, &estatisticas);
+            mostrarTempo(&medicao);
 
             *ordenadoPorNome = 0;
-            mostrarComponentes(componentes, n);
+            mostrarComponentes(componentes);
             break;
 
+        case 4:
+        case 5:
+        case 6:
+        case 7:
+        case 8: {
+            AlgoritmoOrdenacao algoritmo = (opcao == 4) ? MERGE_SORT
+                                         : (opcao == 5) ? INTRO_SORT
+                                         : (opcao == 6) ? RADIX_SORT
+                                         : (opcao == 7) ? MERGE_SORT_PARALELO : COUNTING_SORT;
+            CriterioOrdenacao criterio;
+            const char* nomeCriterio;
+            int opcaoCriterio;
+
+            printf("\nCritério: 1. Nome  2. Tipo  3. Prioridade\n");
+            printf("Escolha: ");
+            scanf("%d", &opcaoCriterio);
+            limparBuffer();
+
+            switch (opcaoCriterio) {
+                case 1:
+                    criterio = NOME;
+                    nomeCriterio = "Nome (ordem alfabética)";
+                    break;
+                case 2:
+                    criterio = TIPO;
+                    nomeCriterio = "Tipo (ordem alfabética)";
+                    break;
+                case 3:
+                    criterio = PRIORIDADE;
+                    nomeCriterio = "Prioridade (maior para menor)";
+                    break;
+                default:
+                    printf("\n✗ Critério inválido!\n");
+                    return;
+            }
+
+            // O paralelo e comparado ao sequencial sobre a mesma entrada
+            Medicao sequencial = {0, 0, 0, 0, 0};
+            printf("\nExecutando %s...\n", nomeAlgoritmo(algoritmo));
+            mochilaMedirOrdenacao(componentes, criterio, algoritmo, false, REPETICOES_ORDENACAO, &medicao);
+            if (algoritmo == MERGE_SORT_PARALELO) {
+                mochilaMedirOrdenacao(componentes, criterio, MERGE_SORT, false, REPETICOES_ORDENACAO, &sequencial);
+            }
+            ordenacaoRapida(componentes, criterio, algoritmo, &estatisticas);
+
+            algoritmo = mochilaUltimoAlgoritmo(componentes);
+            printf("✓ Ordenação concluída!\n");
+            printf("  Algoritmo: %s%s\n", nomeAlgoritmo(algoritmo),
+                   algoritmoEstavel(algoritmo) ? " (estável)" : "");
+            printf("  Critério: %s\n", nomeCriterio);
+            mostrarTrabalho(componentes, &estatisticas);
+            mostrarTempo(&medicao);
+            if (algoritmo == MERGE_SORT_PARALELO) {
+                mostrarParalelo(componentes, &medicao, &sequencial);
+            }
+
+            *ordenadoPorNome = (criterio == NOME);
+            mostrarComponentes(componentes);
+            break;
+        }
+
         case 0:
             return;
 
@@ -257,9 +319,20 @@ void menuOrdenacao(Componente componentes[], int n, int *ordenadoPorNome) {
     }
 }
 
+// Busca medida pelo cronômetro (repetida REPETICOES_BUSCA vezes)
+typedef struct {
+    const Mochila* componentes;
+    const char* nome;
+} BuscaComponente;
+
+void ensaioBuscaBinaria(void* contexto) {
+    BuscaComponente* busca = (BuscaComponente*)contexto;
+    mochilaBuscarBinaria(busca->componentes, busca->nome, NULL);
+}
+
 // Função de busca com menu
-void realizarBusca(Componente componentes[], int n, int ordenadoPorNome) {
-    if (n == 0) {
+void realizarBusca(const Mochila* componentes, int ordenadoPorNome) {
+    if (mochilaTotal(componentes) == 0) {
         printf("\n✗ Nenhum componente cadastrado para buscar.\n");
         return;
     }
@@ -270,21 +343,74 @@ void realizarBusca(Componente componentes[], int n, int ordenadoPorNome) {
         return;
     }
 
-    char nomeBuscado[30];
+    char nomeBuscado[TAM_NOME];
     printf("\n═══════════════════════════════════════\n");
     printf("    BUSCA DO COMPONENTE-CHAVE\n");
     printf("═══════════════════════════════════════\n");
     printf("\nNome do componente a buscar: ");
-    fgets(nomeBuscado, 30, stdin);
-    nomeBuscado[strcspn(nomeBuscado, "\n")] = 0;
+    lerTexto(nomeBuscado, TAM_NOME);
+
+    buscaBinariaPorNome(componentes, nomeBuscado);
 
-    buscaBinariaPorNome(componentes, n, nomeBuscado);
+    BuscaComponente busca = {componentes, nomeBuscado};
+    Medicao medicao;
+    cronometroMedir(NULL, ensaioBuscaBinaria, &busca, REPETICOES_BUSCA, &medicao);
+    mostrarTempo(&medicao);
+}
+
+// Resumo por tipo e por prioridade. Os totais vêm dos agregados que a
+// libmochila atualiza a cada cadastro: nenhum componente é percorrido.
+void mostrarResumo(const Mochila* componentes) {
+    printf("\n═══════════════════════════════════════\n");
+    printf("    RESUMO DOS COMPONENTES\n");
+    printf("═══════════════════════════════════════\n");
+    printf("Total de componentes: %d\n", mochilaAgregadoGeral(componentes).itens);
+
+    printf("\nPor tipo:\n");
+    for (int id = 0; id < tipoTotal(); id++) {
+        Agregado agregado = mochilaAgregadoTipo(componentes, (unsigned short)id);
+        if (agregado.itens > 0) {
+            printf("  %-20s %d\n", tipoNome((unsigned short)id), agregado.itens);
+        }
+    }
+
+    printf("\nPor prioridade:\n");
+    for (int prioridade = 10; prioridade >= 1; prioridade--) {
+        Agregado agregado = mochilaAgregadoPrioridade(componentes, prioridade);
+        if (agregado.itens > 0) {
+            printf("  Prioridade %-2d       %d\n", prioridade, agregado.itens);
+        }
+    }
+}
+
+// Latência de cada operação acumulada na sessão (histogramas da
+// libmochila), com os histogramas completos gravados em CSV
+void mostrarLatencias(void) {
+    printf("\n═══════════════════════════════════════\n");
+    printf("    LATÊNCIA DAS OPERAÇÕES\n");
+    printf("═══════════════════════════════════════\n");
+    // Larguras em bytes: os acentos ocupam 2 bytes em UTF-8
+    printf("%-22s %12s %13s %12s %12s\n", "Operação", "Execuções", "Média (ns)", "p50 (ns)", "p99 (ns)");
+    for (int op = 0; op < TOTAL_LATENCIAS; op++) {
+        ResumoLatencia resumo = latenciaResumo((OperacaoLatencia)op);
+        printf("%-20s %10llu %12.0f %12.0f %12.0f\n", nomeLatencia((OperacaoLatencia)op),
+               (unsigned long long)resumo.contagem, resumo.mediaNs, resumo.p50Ns, resumo.p99Ns);
+    }
+
+    const char* caminho = getenv(VARIAVEL_LATENCIAS);
+    if (caminho == NULL || caminho[0] == '\0') {
+        caminho = ARQUIVO_LATENCIAS;
+    }
+    if (latenciaSalvar(caminho)) {
+        printf("\n✓ Histogramas gravados em %s\n", caminho);
+    } else {
+        printf("\n✗ Não foi possível gravar %s\n", caminho);
+    }
 }
 
 // Função principal
 int main() {
-    Componente componentes[20];
-    int numComponentes = 0;
+    Mochila componentes;
     int ordenadoPorNome = 0;  // Flag para controlar se está ordenado por nome
     int opcao;
 
@@ -296,6 +422,15 @@ int main() {
     printf("\nPrepare-se para o desafio final! A última safe zone está se fechando.\n");
     printf("Monte a torre de resgate com os componentes certos, na ordem exata!\n");
 
+    if (!mochilaIniciar(&componentes, CAPACIDADE_INICIAL)) {
+        printf("\n✗ Erro ao alocar a lista de componentes!\n");
+        return 1;
+    }
+
+    // Componentes entram já na posição do nome (inserção ordenada)
+    mochilaDefinirInsercaoOrdenada(&componentes, true);
+    ordenadoPorNome = mochilaOrdenadaPorNome(&componentes);
+
     do {
         printf("\n\n");
         printf("═══════════════════════════════════════\n");
@@ -306,9 +441,11 @@ int main() {
         printf("3. Ordenar componentes\n");
         printf("4. Buscar componente-chave (busca binária)\n");
         printf("5. Status da montagem\n");
+        printf("6. Resumo por tipo e prioridade\n");
+        printf("7. Latência das operações\n");
         printf("0. Sair\n");
         printf("═══════════════════════════════════════\n");
-        printf("Componentes cadastrados: %d/20\n", numComponentes);
+        printf("Componentes cadastrados: %d\n", mochilaTotal(&componentes));
         printf("Ordenado por nome: %s\n", ordenadoPorNome ? "Sim" : "Não");
         printf("═══════════════════════════════════════\n");
         printf("Escolha: ");
@@ -318,39 +455,47 @@ int main() {
 
         switch (opcao) {
             case 1:
-                cadastrarComponentes(componentes, &numComponentes);
-                ordenadoPorNome = 0;  // Ao adicionar, perde ordenação
+                cadastrarComponentes(&componentes);
+                ordenadoPorNome = mochilaOrdenadaPorNome(&componentes);
                 break;
 
             case 2:
-                mostrarComponentes(componentes, numComponentes);
+                mostrarComponentes(&componentes);
                 break;
 
             case 3:
-                menuOrdenacao(componentes, numComponentes, &ordenadoPorNome);
+                menuOrdenacao(&componentes, &ordenadoPorNome);
                 break;
 
             case 4:
-                realizarBusca(componentes, numComponentes, ordenadoPorNome);
+                realizarBusca(&componentes, ordenadoPorNome);
                 break;
 
             case 5:
                 printf("\n═══════════════════════════════════════\n");
                 printf("    STATUS DA MONTAGEM DA TORRE\n");
                 printf("═══════════════════════════════════════\n");
-                printf("Total de componentes: %d/20\n", numComponentes);
+                printf("Total de componentes: %d\n", mochilaTotal(&componentes));
                 printf("Sistema ordenado: %s\n", ordenadoPorNome ? "Sim (pronto para busca)" : "Não");
 
-                if (numComponentes >= 10 && ordenadoPorNome) {
+                if (mochilaTotal(&componentes) >= 10 && ordenadoPorNome) {
                     printf("\n✓ SISTEMA PRONTO PARA ATIVAÇÃO!\n");
                     printf("Você pode buscar o componente-chave para iniciar a fuga.\n");
-                } else if (numComponentes < 10) {
+                } else if (mochilaTotal(&componentes) < 10) {
                     printf("\n⚠ Componentes insuficientes. Mínimo recomendado: 10\n");
                 } else {
                     printf("\n⚠ Ordene os componentes antes de ativar a torre.\n");
                 }
                 break;
 
+            case 6:
+                mostrarResumo(&componentes);
+                break;
+
+            case 7:
+                mostrarLatencias();
+                break;
+
             case 0:
                 printf("\n╔════════════════════════════════════════════════════════════════════════╗\n");
                 printf("║  Missão encerrada. Boa sorte na fuga da ilha!                         ║\n");
@@ -368,5 +513,8 @@ int main() {
 
     } while (opcao != 0);
 
+    latenciaSalvarSeConfigurado();  // MOCHILA_LATENCIAS=arquivo.csv
+    mochilaLiberar(&componentes);
+    tiposLiberar();
     return 0;
 }